@@ -8,6 +8,7 @@
  */
 
 #include "EasingBase.h"
+#include "EasingLookupTable.h"
 
 /*
  * Default constructor
@@ -16,13 +17,17 @@
 EasingBase::EasingBase()
 {
 	_change = 0;
+	_duration = 0;
 	_type = EASE_IN;
+	_table = nullptr;
 }
 
 EasingBase::EasingBase(easingType_t type_)
 {
 	_change = 0;
+	_duration = 0;
 	_type = type_;
+	_table = nullptr;
 }
 
 EasingBase::~EasingBase()
@@ -35,23 +40,50 @@ void EasingBase::setType(easingType_t type_)
 	_type = type_;
 }
 
+easingType_t EasingBase::getType() const
+{
+	return _type;
+}
+
 NUMBER EasingBase::ease(NUMBER time_) const
 {
-	switch (_type)
-	{
-	case EASE_IN:
-		return easeIn(time_);
-		break;
-	case EASE_OUT:
-		return easeOut(time_);
-		break;
-	case EASE_IN_OUT:
-		return easeInOut(time_);
-		break;
-	default:
-		return 0;
-		break;
-	}
+	if(_table != nullptr && _duration > 0)
+		return _change * _table->interpolate(time_ / _duration * EASING_FIXED_ONE) / EASING_FIXED_ONE;
+
+	return _change * curve(_type, time_ / _duration);
+}
+
+
+/*
+ * Fixed point easing, progress_ and the result are Q16.16 fractions
+ */
+
+int32_t EasingBase::easeFixed(int32_t progress_) const
+{
+	if(_table != nullptr)
+		return _table->interpolate(progress_);
+
+	return curve(_type, (NUMBER)progress_ / EASING_FIXED_ONE) * EASING_FIXED_ONE;
+}
+
+
+/*
+ * Easing API methods, independent of the type that is set
+ */
+
+NUMBER EasingBase::easeIn(NUMBER time_) const
+{
+	return _change * curve(EASE_IN, time_ / _duration);
+}
+
+NUMBER EasingBase::easeOut(NUMBER time_) const
+{
+	return _change * curve(EASE_OUT, time_ / _duration);
+}
+
+NUMBER EasingBase::easeInOut(NUMBER time_) const
+{
+	return _change * curve(EASE_IN_OUT, time_ / _duration);
 }
 
 
@@ -73,3 +105,13 @@ void EasingBase::setTotalChangeInPosition(NUMBER totalChangeInPosition_)
 {
 	_change=totalChangeInPosition_;
 }
+
+
+/*
+ * Set the lookup table
+ */
+
+void EasingBase::setLookupTable(const EasingLookupTable* table_)
+{
+	_table=table_;
+}
@@ -13,6 +13,8 @@
 #include "EasingConstants.h"
 
 
+class EasingLookupTable;
+
 // base class for easing functions
 
 class EasingBase
@@ -21,6 +23,7 @@ protected:
 	NUMBER _change;
 	NUMBER _duration;
 	easingType_t _type;
+	const EasingLookupTable* _table;
 
 public:
 
@@ -35,13 +38,31 @@ public:
 	// single method to set the type for all easings
 	void setType(easingType_t type_);
 
-	// single method for all easings to execute
+	easingType_t getType() const;
+
+	// single method for all easings to execute. Uses the lookup table
+	// instead of the easing equations if one is set
 	NUMBER ease(NUMBER time_) const;
 
+	// fixed point version of ease(). progress_ is the Q16.16 fraction of the
+	// duration that has passed, the result is the Q16.16 fraction of the total
+	// change in position. Only depends on the type of the easing and not on
+	// duration or change, so one easing can be shared by any number of animations.
+	// Doesn't use any floating point math if a lookup table is set
+	int32_t easeFixed(int32_t progress_) const;
+
+	// use a precomputed table instead of the easing equations, nullptr to
+	// go back to the equations. See EasingLookupTable
+	void setLookupTable(const EasingLookupTable* table_);
+
+	// the easing curve normalized to a duration and change of 1, implemented
+	// by every easing type with its EasingCurve
+	virtual NUMBER curve(easingType_t type_, NUMBER time_) const=0;
+
 	// easing API methods
-	virtual NUMBER easeIn(NUMBER time_) const=0;
-	virtual NUMBER easeOut(NUMBER time_) const=0;
-	virtual NUMBER easeInOut(NUMBER time_) const=0;
+	NUMBER easeIn(NUMBER time_) const;
+	NUMBER easeOut(NUMBER time_) const;
+	NUMBER easeInOut(NUMBER time_) const;
 
 	// common properties
 	void setDuration(NUMBER duration_);
@@ -49,4 +70,40 @@ public:
 };
 
 
+/*
+ * Stateless easing equations, specialized next to every easing type. in, out
+ * and inOut take the fraction of the duration that has passed and return the
+ * fraction of the total change in position
+ */
+
+template<class EASE>
+struct EasingCurve;
+
+
+/*
+ * Pure easing function without any shared state. The easing type is a template
+ * parameter, so the equation is inlined instead of going through a virtual call:
+ *
+ *   ease<CubicEase>(EASE_IN_OUT, time, duration, change);
+ */
+
+template<class EASE>
+inline NUMBER ease(easingType_t type_, NUMBER time_, NUMBER duration_, NUMBER change_)
+{
+	time_/=duration_;
+
+	switch (type_)
+	{
+	case EASE_IN:
+		return change_*EasingCurve<EASE>::in(time_);
+	case EASE_OUT:
+		return change_*EasingCurve<EASE>::out(time_);
+	case EASE_IN_OUT:
+		return change_*EasingCurve<EASE>::inOut(time_);
+	default:
+		return 0;
+	}
+}
+
+
 #endif
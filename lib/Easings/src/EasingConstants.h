@@ -11,10 +11,26 @@
 #ifndef __206D47C8_01CD_46c6_AF3F_A26DD28C189A
 #define __206D47C8_01CD_46c6_AF3F_A26DD28C189A
 
+#include <stdint.h>
+
 // the number type used in this library
 
 typedef double NUMBER;
 enum easingType_t {EASE_IN, EASE_OUT, EASE_IN_OUT};
 
+// fixed point easing: progress and result are signed Q16.16 numbers,
+// EASING_FIXED_ONE is the start and end of the easing in time and in position
+
+#define EASING_FIXED_SHIFT	16
+#define EASING_FIXED_ONE	((int32_t)1 << EASING_FIXED_SHIFT)
+
+// number of linear segments of an EasingLookupTable, has to be a power of two.
+// with 64 segments the smooth easings stay below 1% of the full change, Bounce (kinks)
+// and Circular (vertical tangent at the ends) reach 3-5% and need more segments if that matters
+
+#ifndef EASING_LOOKUP_SEGMENTS
+#define EASING_LOOKUP_SEGMENTS	64
+#endif
+
 
 #endif
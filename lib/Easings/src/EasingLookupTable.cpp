@@ -0,0 +1,70 @@
+/*
+ * Easing Functions: Copyright (c) 2010 Andy Brown
+ * http://www.andybrown.me.uk
+ *
+ * This work is licensed under a Creative Commons
+ * Attribution_ShareAlike 3.0 Unported License.
+ * http://creativecommons.org/licenses/by_sa/3.0/
+ */
+
+#include <math.h>
+#include "EasingLookupTable.h"
+
+#if (EASING_LOOKUP_SEGMENTS & (EASING_LOOKUP_SEGMENTS - 1)) != 0
+	#error "EASING_LOOKUP_SEGMENTS has to be a power of two"
+#endif
+
+
+/*
+ * Linear table
+ */
+
+EasingLookupTable::EasingLookupTable()
+{
+	for(uint16_t i=0;i<=EASING_LOOKUP_SEGMENTS;i++)
+		_samples[i]=(int32_t)i*(EASING_FIXED_ONE/EASING_LOOKUP_SEGMENTS);
+}
+
+
+/*
+ * Sample an easing and use the table for it
+ */
+
+EasingLookupTable::EasingLookupTable(EasingBase& easing_)
+{
+	build(easing_);
+	easing_.setLookupTable(this);
+}
+
+
+/*
+ * Sample the normalized curve
+ */
+
+void EasingLookupTable::build(const EasingBase& easing_)
+{
+	for(uint16_t i=0;i<=EASING_LOOKUP_SEGMENTS;i++)
+		_samples[i]=lround(easing_.curve(easing_.getType(),(NUMBER)i/EASING_LOOKUP_SEGMENTS)*EASING_FIXED_ONE);
+}
+
+
+/*
+ * Table lookup with linear interpolation between the two neighbouring samples
+ */
+
+int32_t EasingLookupTable::interpolate(int32_t progress_) const
+{
+	if(progress_<=0)
+		return _samples[0];
+
+	if(progress_>=EASING_FIXED_ONE)
+		return _samples[EASING_LOOKUP_SEGMENTS];
+
+	// upper bits select the segment, lower bits are the position within it
+	uint32_t position=(uint32_t)progress_*EASING_LOOKUP_SEGMENTS;
+	uint16_t index=position>>EASING_FIXED_SHIFT;
+	int32_t fraction=position&(EASING_FIXED_ONE-1);
+
+	int32_t start=_samples[index];
+	return start+(int32_t)(((int64_t)(_samples[index+1]-start)*fraction)>>EASING_FIXED_SHIFT);
+}
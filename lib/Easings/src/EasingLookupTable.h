@@ -0,0 +1,51 @@
+/*
+ * Easing Functions: Copyright (c) 2010 Andy Brown
+ * http://www.andybrown.me.uk
+ *
+ * This work is licensed under a Creative Commons
+ * Attribution_ShareAlike 3.0 Unported License.
+ * http://creativecommons.org/licenses/by_sa/3.0/
+ */
+
+#ifndef __EASING_LOOKUP_TABLE_H_
+#define __EASING_LOOKUP_TABLE_H_
+
+#include "EasingBase.h"
+
+
+/*
+ * Fixed point backend for the easings. The easing curve is sampled once at
+ * EASING_LOOKUP_SEGMENTS + 1 points and afterwards evaluated with a table
+ * lookup and a linear interpolation in Q16.16, which avoids the double math
+ * (and pow/sin of some easings) on targets without a double precision FPU.
+ *
+ * One table can be shared by all easings of the same type and settings:
+ *
+ *   CubicEase cubicEaseIn(EASE_IN);
+ *   EasingLookupTable cubicEaseInTable(cubicEaseIn);
+ */
+
+class EasingLookupTable
+{
+private:
+	int32_t _samples[EASING_LOOKUP_SEGMENTS + 1];
+
+public:
+	// linear table, maps every progress to itself
+	EasingLookupTable();
+
+	// sample the given easing and set the table as its lookup table
+	EasingLookupTable(EasingBase& easing_);
+
+	// sample the normalized curve of an easing with its current type. Easings
+	// with settings that depend on the duration (period of ElasticEase) have to
+	// be sampled again if the duration changes
+	void build(const EasingBase& easing_);
+
+	// eased position for a Q16.16 progress, both as fraction of EASING_FIXED_ONE.
+	// progress outside of 0 and EASING_FIXED_ONE is clamped to the end points
+	int32_t interpolate(int32_t progress_) const;
+};
+
+
+#endif
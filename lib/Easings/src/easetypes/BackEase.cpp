@@ -11,13 +11,13 @@
 
 
 /*
- * Constructor
+ * Constructors
  */
 
 BackEase::BackEase()
 {
 	// set a sensible default value for the overshoot
-	_overshoot=1.70158;
+	_overshoot=EASING_BACK_OVERSHOOT;
 }
 
 BackEase::BackEase(easingType_t type_, NUMBER overshoot_) : EasingBase(type_)
@@ -27,51 +27,30 @@ BackEase::BackEase(easingType_t type_, NUMBER overshoot_) : EasingBase(type_)
 
 
 /*
- * Set the overshoot value
+ * Evaluate the normalized curve with the overshoot of this easing
  */
 
-void BackEase::setOvershoot(NUMBER overshoot_)
+NUMBER BackEase::curve(easingType_t type_, NUMBER time_) const
 {
-	_overshoot=overshoot_;
+	switch (type_)
+	{
+	case EASE_IN:
+		return EasingCurve<BackEase>::in(time_,_overshoot);
+	case EASE_OUT:
+		return EasingCurve<BackEase>::out(time_,_overshoot);
+	case EASE_IN_OUT:
+		return EasingCurve<BackEase>::inOut(time_,_overshoot);
+	default:
+		return 0;
+	}
 }
 
 
 /*
- * Ease in
+ * Set the overshoot
  */
 
-NUMBER BackEase::easeIn(NUMBER time_) const
-{
-	time_/=_duration;
-	return _change*time_*time_*((_overshoot+1)*time_-_overshoot);
-}
-
-
-/*
- * Ease out
- */
-
-NUMBER BackEase::easeOut(NUMBER time_) const
-{
-	time_=time_/_duration-1;
-	return _change*(time_*time_*((_overshoot+1)*time_+_overshoot)+1);
-}
-
-
-/*
- * Ease in and out
- */
-
-NUMBER BackEase::easeInOut(NUMBER time_) const
+void BackEase::setOvershoot(NUMBER overshoot_)
 {
-	NUMBER overshoot;
-
-	overshoot=_overshoot*1.525;
-	time_/=_duration/2;
-
-	if(time_<1)
-		return _change/2*(time_*time_*((overshoot+1)*time_-overshoot));
-
-	time_-=2;
-	return _change/2*(time_*time_*((overshoot+1)*time_+overshoot)+2);
+	_overshoot=overshoot_;
 }
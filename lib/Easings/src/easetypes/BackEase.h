@@ -13,6 +13,11 @@
 #include "EasingBase.h"
 
 
+// default overshoot of the back easing
+
+#define EASING_BACK_OVERSHOOT	1.70158
+
+
 /*
  * Back easing function
  */
@@ -28,19 +33,8 @@ public:
 
 	BackEase(easingType_t type_, NUMBER overshoot_);
 
-	// Starts the motion by backtracking, then reversing
-	// direction and moving toward the target
-	virtual NUMBER easeIn(NUMBER time_) const;
-
-	// Starts the motion by moving towards the target, overshooting
-	// it slightly, and then reversing direction back toward the target
-	virtual NUMBER easeOut(NUMBER time_) const;
-
-	// Combines the motion of the easeIn and easeOut methods to
-	// start the motion by backtracking, then reversing direction
-	// and moving toward target, overshooting target slightly,
-	// reversing direction again, and then moving back toward the target
-	virtual NUMBER easeInOut(NUMBER time_) const;
+	// normalized easing curve with the overshoot of this easing, see EasingCurve<BackEase>
+	virtual NUMBER curve(easingType_t type_, NUMBER time_) const;
 
 	// set the overshoot value. The higher the value the
 	// greater the overshoot.
@@ -48,4 +42,38 @@ public:
 };
 
 
+/*
+ * Stateless back easing equations, time_ and the result are fractions of the duration and the change
+ */
+
+template<>
+struct EasingCurve<BackEase>
+{
+	// backtracks first, then moves towards the end
+	static inline NUMBER in(NUMBER time_, NUMBER overshoot_=EASING_BACK_OVERSHOOT)
+	{
+		return time_*time_*((overshoot_+1)*time_-overshoot_);
+	}
+
+	// overshoots the end and comes back
+	static inline NUMBER out(NUMBER time_, NUMBER overshoot_=EASING_BACK_OVERSHOOT)
+	{
+		time_-=1;
+		return time_*time_*((overshoot_+1)*time_+overshoot_)+1;
+	}
+
+	// backtracks, moves towards the end, overshoots it and comes back
+	static inline NUMBER inOut(NUMBER time_, NUMBER overshoot_=EASING_BACK_OVERSHOOT)
+	{
+		overshoot_*=1.525;
+		time_*=2;
+		if(time_<1)
+			return time_*time_*((overshoot_+1)*time_-overshoot_)/2;
+
+		time_-=2;
+		return (time_*time_*((overshoot_+1)*time_+overshoot_)+2)/2;
+	}
+};
+
+
 #endif
@@ -21,18 +21,55 @@ class BounceEase : public EasingBase
 {
 public:
 	using EasingBase::EasingBase; // inherit base class constructors
-	// starts the bounce motion slowly,
-  // then accelerates motion as it executes
-	virtual NUMBER easeIn(NUMBER time_) const;
-
-	// starts the bounce motion fast,
-  // and then decelerates motion as it executes.
-	virtual NUMBER easeOut(NUMBER time_) const;
-
-	// combines the motion of the easeIn and easeOut
-	// methods to start the bounce motion slowly,
-	// accelerate motion, then decelerate.
-	virtual NUMBER easeInOut(NUMBER time_) const;
+
+	// normalized easing curve, see EasingCurve<BounceEase>
+	virtual NUMBER curve(easingType_t type_, NUMBER time_) const;
+};
+
+
+/*
+ * Stateless bounce easing equations, time_ and the result are fractions of the duration and the change
+ */
+
+template<>
+struct EasingCurve<BounceEase>
+{
+	// bounces with increasing height towards the end
+	static inline NUMBER in(NUMBER time_)
+	{
+		return 1-out(1-time_);
+	}
+
+	// hits the end and bounces back with decreasing height
+	static inline NUMBER out(NUMBER time_)
+	{
+		if(time_<(1/2.75))
+			return 7.5625*time_*time_;
+
+		if(time_<(2/2.75))
+		{
+			time_-=1.5/2.75;
+			return 7.5625*time_*time_+0.75;
+		}
+
+		if(time_<(2.5/2.75))
+		{
+			time_-=2.25/2.75;
+			return 7.5625*time_*time_+0.9375;
+		}
+
+		time_-=2.625/2.75;
+		return 7.5625*time_*time_+0.984375;
+	}
+
+	// bounces in during the first half and out during the second
+	static inline NUMBER inOut(NUMBER time_)
+	{
+		if(time_<0.5)
+			return in(time_*2)*0.5;
+
+		return out(time_*2-1)*0.5+0.5;
+	}
 };
 
 
@@ -7,46 +7,14 @@
  * http://creativecommons.org/licenses/by_sa/3.0/
  */
 
-#include <math.h>
 #include "CircularEase.h"
 
 
 /*
- * Ease in
+ * Evaluate the normalized curve, see EasingCurve<CircularEase>
  */
 
-NUMBER CircularEase::easeIn(NUMBER time_) const
+NUMBER CircularEase::curve(easingType_t type_, NUMBER time_) const
 {
-	time_/= _duration;
-
-	return -_change*(sqrt(1-time_*time_)-1);
-}
-
-
-/*
- * Ease out
- */
-
-NUMBER CircularEase::easeOut(NUMBER time_) const
-{
-	time_= time_/_duration-1;
-	return _change*sqrt(1-time_*time_);
+	return ::ease<CircularEase>(type_, time_, 1, 1);
 }
-
-
-/*
- * Ease in and out
- */
-
-NUMBER CircularEase::easeInOut(NUMBER time_) const
-{
-	time_/=_duration/2;
-
-	if(time_<1)
-		return -_change/2*(sqrt(1-time_*time_)-1);
-
-	time_-=2;
-	return _change/2*(sqrt(1-time_*time_)+1);
-}
-
-
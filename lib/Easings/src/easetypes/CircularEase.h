@@ -10,6 +10,7 @@
 #ifndef __E3C2602E_AF87_4ca3_9E5B_2F822F390F32
 #define __E3C2602E_AF87_4ca3_9E5B_2F822F390F32
 
+#include <math.h>
 #include "EasingBase.h"
 
 
@@ -21,18 +22,42 @@ class CircularEase : public EasingBase
 {
 public:
 	using EasingBase::EasingBase; // inherit base class constructors
-	// starts motion slowly, and then accelerates
-	// motion as it executes
-	virtual NUMBER easeIn(NUMBER time_) const;
-
-	// starts motion fast, and then decelerates
-	// motion as it executes.
-	virtual NUMBER easeOut(NUMBER time_) const;
-
-	// combines the motion of the easeIn and easeOut
-	// methods to start the motion slowly, accelerate
-	// motion, then decelerate.
-	virtual NUMBER easeInOut(NUMBER time_) const;
+
+	// normalized easing curve, see EasingCurve<CircularEase>
+	virtual NUMBER curve(easingType_t type_, NUMBER time_) const;
+};
+
+
+/*
+ * Stateless circular easing equations, time_ and the result are fractions of the duration and the change
+ */
+
+template<>
+struct EasingCurve<CircularEase>
+{
+	// accelerates from zero velocity
+	static inline NUMBER in(NUMBER time_)
+	{
+		return -(sqrt(1-time_*time_)-1);
+	}
+
+	// decelerates to zero velocity
+	static inline NUMBER out(NUMBER time_)
+	{
+		time_-=1;
+		return sqrt(1-time_*time_);
+	}
+
+	// accelerates until halfway, then decelerates
+	static inline NUMBER inOut(NUMBER time_)
+	{
+		time_*=2;
+		if(time_<1)
+			return -(sqrt(1-time_*time_)-1)/2;
+
+		time_-=2;
+		return (sqrt(1-time_*time_)+1)/2;
+	}
 };
 
 
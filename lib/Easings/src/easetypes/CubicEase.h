@@ -22,19 +22,42 @@ class CubicEase : public EasingBase
 {
 public:
 	using EasingBase::EasingBase; // inherit base class constructors
-	// Starts the motion by backtracking, then reversing
-	// direction and moving toward the target
-	virtual NUMBER easeIn(NUMBER time_) const;
-
-	// Starts the motion by moving towards the target, overshooting
-	// it slightly, and then reversing direction back toward the target
-	virtual NUMBER easeOut(NUMBER time_) const;
-
-	// Combines the motion of the easeIn and easeOut methods to
-	// start the motion by backtracking, then reversing direction
-	// and moving toward target, overshooting target slightly,
-	// reversing direction again, and then moving back toward the target
-	virtual NUMBER easeInOut(NUMBER time_) const;
+
+	// normalized easing curve, see EasingCurve<CubicEase>
+	virtual NUMBER curve(easingType_t type_, NUMBER time_) const;
+};
+
+
+/*
+ * Stateless cubic easing equations, time_ and the result are fractions of the duration and the change
+ */
+
+template<>
+struct EasingCurve<CubicEase>
+{
+	// accelerates from zero velocity
+	static inline NUMBER in(NUMBER time_)
+	{
+		return time_*time_*time_;
+	}
+
+	// decelerates to zero velocity
+	static inline NUMBER out(NUMBER time_)
+	{
+		time_-=1;
+		return time_*time_*time_+1;
+	}
+
+	// accelerates until halfway, then decelerates
+	static inline NUMBER inOut(NUMBER time_)
+	{
+		time_*=2;
+		if(time_<1)
+			return time_*time_*time_/2;
+
+		time_-=2;
+		return (time_*time_*time_+2)/2;
+	}
 };
 
 
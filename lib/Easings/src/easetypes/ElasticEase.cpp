@@ -7,7 +7,6 @@
  * http://creativecommons.org/licenses/by-sa/3.0/
  */
 
-#include <math.h>
 #include "ElasticEase.h"
 
 
@@ -32,110 +31,26 @@ ElasticEase::ElasticEase(easingType_t type_, NUMBER period_, NUMBER amplitude_)
 
 
 /*
- * Ease in
+ * Evaluate the normalized curve, period and amplitude are converted to
+ * fractions of the duration and the change
  */
 
-NUMBER ElasticEase::easeIn(NUMBER time_) const
+NUMBER ElasticEase::curve(easingType_t type_, NUMBER time_) const
 {
-	NUMBER p,a,s;
+	NUMBER period=_period!=0 && _duration>0 ? _period/_duration : 0;
+	NUMBER amplitude=_change!=0 ? _amplitude/fabs(_change) : 0;
 
-	if(time_==0)
-		return 0;
-
-	time_/=_duration;
-
-	if(time_==1)
-		return _change;
-
-	if(_period==0)
-		p=_duration*0.3;
-	else
-		p=_period;
-
-	a=_amplitude;
-	if(a==0 || a<fabs(_change))
+	switch (type_)
 	{
-		a=_change;
-	  s=p/4;
-	}
-	else
-		s=p/(2*M_PI)*asin(_change/a);
-
-	time_-=1;
-	return -(a*pow(2,10*time_)*sin((time_*_duration-s)*(2*M_PI)/p));
-}
-
-
-/*
- * Ease out
- */
-
-NUMBER ElasticEase::easeOut(NUMBER time_) const
-{
-	NUMBER p,a,s;
-
-	if(time_==0)
+	case EASE_IN:
+		return EasingCurve<ElasticEase>::in(time_,period,amplitude);
+	case EASE_OUT:
+		return EasingCurve<ElasticEase>::out(time_,period,amplitude);
+	case EASE_IN_OUT:
+		return EasingCurve<ElasticEase>::inOut(time_,period,amplitude);
+	default:
 		return 0;
-
-	time_/=_duration;
-	if(time_==1)
-		return _change;
-
-	if(_period==0)
-		p=_duration*0.3;
-	else
-		p=_period;
-
-	a=_amplitude;
-	if(a==0 || a<fabs(_change))
-	{
-		a=_change;
-		s=p/4;
 	}
-	else
-		s=p/(2*M_PI)*asin(_change/a);
-
-  return a*pow(2,-10*time_)*sin((time_*_duration-s)*(2*M_PI)/p)+_change;
-}
-
-
-/*
- * Ease in/out
- */
-
-NUMBER ElasticEase::easeInOut(NUMBER time_) const
-{
-	NUMBER p,a,s;
-
-	if(time_==0)
-		return 0;
-
-	time_/=_duration/2;
-	if (time_==2)
-		return _change;
-
-	if(_period==0)
-		p=_duration*(0.3*1.5);
-	else
-		p=_period;
-
-	a=_amplitude;
-	if(a==0 || a<fabs(_change))
-	{
-		a=_change;
-	  s=p/4;
-	}
-	else
-		s=p/(2*M_PI)*asin(_change/a);
-
-  if(time_<1)
-  {
-  	time_-=1;
-	  return -0.5*(a*pow(2,10*time_)*sin((time_*_duration-s)*(2*M_PI)/p));
-	}
-
-  time_-=1;
-	return a*pow(2,-10*time_)*sin((time_*_duration-s)*(2*M_PI)/p)*0.5+_change;
 }
 
 
@@ -10,6 +10,7 @@
 #ifndef __98FC70EC_04B4_4cfd_A4C8_FEEE67F265CB
 #define __98FC70EC_04B4_4cfd_A4C8_FEEE67F265CB
 
+#include <math.h>
 #include "EasingBase.h"
 
 
@@ -29,15 +30,9 @@ public:
 	ElasticEase();
 	ElasticEase(easingType_t type_, NUMBER period_, NUMBER amplitude_);
 
-	// Starts motion slowly, and then accelerates motion as it executes.
-	virtual NUMBER easeIn(NUMBER time_) const;
-
-	// Starts motion fast, and then decelerates motion as it executes
-	virtual NUMBER easeOut(NUMBER time_) const;
-
-	// combines the motion of the easeIn and easeOut methods
-	// to start the motion slowly, accelerate motion, then decelerate
-	virtual NUMBER easeInOut(NUMBER time_) const;
+	// normalized easing curve with the period and amplitude of this easing, see EasingCurve<ElasticEase>.
+	// The period is set in units of the duration, so the curve changes with the duration if it is set
+	virtual NUMBER curve(easingType_t type_, NUMBER time_) const;
 
 	// set the period
 	void setPeriod(NUMBER period_);
@@ -47,4 +42,68 @@ public:
 };
 
 
+/*
+ * Stateless elastic easing equations, time_ and the result are fractions of the duration and the change
+ */
+
+template<>
+struct EasingCurve<ElasticEase>
+{
+	// oscillates with increasing amplitude, then snaps to the end.
+	// period_ is a fraction of the duration and amplitude_ of the change, 0 selects the defaults
+	static inline NUMBER in(NUMBER time_, NUMBER period_=0, NUMBER amplitude_=0)
+	{
+		if(time_==0)
+			return 0;
+
+		if(time_==1)
+			return 1;
+
+		NUMBER p=period_==0 ? 0.3 : period_;
+		NUMBER a=amplitude_<1 ? 1 : amplitude_;
+		NUMBER s=amplitude_<1 ? p/4 : p/(2*M_PI)*asin(1/a);
+
+		time_-=1;
+		return -(a*pow(2,10*time_)*sin((time_-s)*(2*M_PI)/p));
+	}
+
+	// snaps to the end, then oscillates around it with decreasing amplitude
+	static inline NUMBER out(NUMBER time_, NUMBER period_=0, NUMBER amplitude_=0)
+	{
+		if(time_==0)
+			return 0;
+
+		if(time_==1)
+			return 1;
+
+		NUMBER p=period_==0 ? 0.3 : period_;
+		NUMBER a=amplitude_<1 ? 1 : amplitude_;
+		NUMBER s=amplitude_<1 ? p/4 : p/(2*M_PI)*asin(1/a);
+
+		return a*pow(2,-10*time_)*sin((time_-s)*(2*M_PI)/p)+1;
+	}
+
+	// combines both, the snap happens halfway
+	static inline NUMBER inOut(NUMBER time_, NUMBER period_=0, NUMBER amplitude_=0)
+	{
+		if(time_==0)
+			return 0;
+
+		if(time_==1)
+			return 1;
+
+		NUMBER p=period_==0 ? 0.3*1.5 : period_;
+		NUMBER a=amplitude_<1 ? 1 : amplitude_;
+		NUMBER s=amplitude_<1 ? p/4 : p/(2*M_PI)*asin(1/a);
+
+		time_*=2;
+		time_-=1;
+		if(time_<0)
+			return -0.5*(a*pow(2,10*time_)*sin((time_-s)*(2*M_PI)/p));
+
+		return a*pow(2,-10*time_)*sin((time_-s)*(2*M_PI)/p)*0.5+1;
+	}
+};
+
+
 #endif
@@ -10,6 +10,7 @@
 #ifndef __EB8DFB1F_5506_4a49_BD8E_B0A1E0C82891
 #define __EB8DFB1F_5506_4a49_BD8E_B0A1E0C82891
 
+#include <math.h>
 #include "EasingBase.h"
 
 
@@ -21,15 +22,47 @@ class ExponentialEase : public EasingBase
 {
 public:
 	using EasingBase::EasingBase; // inherit base class constructors
-	//starts motion slowly, and then accelerates motion as it executes
-	virtual NUMBER easeIn(NUMBER time_) const;
 
-	// starts motion fast, and then decelerates motion as it executes
-	virtual NUMBER easeOut(NUMBER time_) const;
+	// normalized easing curve, see EasingCurve<ExponentialEase>
+	virtual NUMBER curve(easingType_t type_, NUMBER time_) const;
+};
+
+
+/*
+ * Stateless exponential easing equations, time_ and the result are fractions of the duration and the change
+ */
+
+template<>
+struct EasingCurve<ExponentialEase>
+{
+	// accelerates from zero velocity
+	static inline NUMBER in(NUMBER time_)
+	{
+		return time_==0 ? 0 : pow(2,10*(time_-1));
+	}
+
+	// decelerates to zero velocity
+	static inline NUMBER out(NUMBER time_)
+	{
+		return time_==1 ? 1 : -pow(2,-10*time_)+1;
+	}
+
+	// accelerates until halfway, then decelerates
+	static inline NUMBER inOut(NUMBER time_)
+	{
+		if(time_==0)
+			return 0;
+
+		if(time_==1)
+			return 1;
+
+		time_*=2;
+		if(time_<1)
+			return pow(2,10*(time_-1))/2;
 
-	//combines the motion of the easeIn and easeOut methods to start the
-	// motion slowly, accelerate motion, then decelerate
-	virtual NUMBER easeInOut(NUMBER time_) const;
+		time_--;
+		return (-pow(2,-10*time_)+2)/2;
+	}
 };
 
 
@@ -11,30 +11,10 @@
 
 
 /*
- * Ease in
+ * Evaluate the normalized curve, see EasingCurve<LinearEase>
  */
 
-NUMBER LinearEase::easeIn(NUMBER time_) const
+NUMBER LinearEase::curve(easingType_t type_, NUMBER time_) const
 {
-	return _change*time_/_duration;
-}
-
-
-/*
- * Ease out
- */
-
-NUMBER LinearEase::easeOut(NUMBER time_) const
-{
-	return easeIn(time_);
-}
-
-
-/*
- * Ease in and out
- */
-
-NUMBER LinearEase::easeInOut(NUMBER time_) const
-{
-	return easeIn(time_);
+	return ::ease<LinearEase>(type_, time_, 1, 1);
 }
@@ -21,14 +21,36 @@ class LinearEase : public EasingBase
 {
 public:
 	using EasingBase::EasingBase; // inherit base class constructors
+
+	// normalized easing curve, see EasingCurve<LinearEase>
+	virtual NUMBER curve(easingType_t type_, NUMBER time_) const;
+};
+
+
+/*
+ * Stateless linear easing equations, time_ and the result are fractions of the duration and the change
+ */
+
+template<>
+struct EasingCurve<LinearEase>
+{
 	// no acceleration
-	virtual NUMBER easeIn(NUMBER time_) const;
+	static inline NUMBER in(NUMBER time_)
+	{
+		return time_;
+	}
 
 	// no acceleration
-	virtual NUMBER easeOut(NUMBER time_) const;
+	static inline NUMBER out(NUMBER time_)
+	{
+		return time_;
+	}
 
 	// no acceleration
-	virtual NUMBER easeInOut(NUMBER time_) const;
+	static inline NUMBER inOut(NUMBER time_)
+	{
+		return time_;
+	}
 };
 
 
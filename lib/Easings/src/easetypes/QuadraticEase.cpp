@@ -11,38 +11,10 @@
 
 
 /*
- * Ease in
+ * Evaluate the normalized curve, see EasingCurve<QuadraticEase>
  */
 
-NUMBER QuadraticEase::easeIn(NUMBER time_) const
+NUMBER QuadraticEase::curve(easingType_t type_, NUMBER time_) const
 {
-	time_/=_duration;
-	return _change*time_*time_;
-}
-
-
-/*
- * Ease out
- */
-
-NUMBER QuadraticEase::easeOut(NUMBER time_) const
-{
-	time_/=_duration;
-	return -_change*time_*(time_-2);
-}
-
-
-/*
- * Ease in and out
- */
-
-NUMBER QuadraticEase::easeInOut(NUMBER time_) const
-{
-	time_/=_duration/2;
-
-	if (time_<1)
-		return _change/2*time_*time_;
-
-	time_--;
-	return -_change/2*(time_*(time_-2)-1);
+	return ::ease<QuadraticEase>(type_, time_, 1, 1);
 }
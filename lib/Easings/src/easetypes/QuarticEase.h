@@ -8,7 +8,7 @@
  */
 
 #ifndef __744A96B2_C5D5_4905_9EB9_7E92543C1B1B
-#define __C7168DD6_B2B7_4753_833B_914C84EF332E
+#define __744A96B2_C5D5_4905_9EB9_7E92543C1B1B
 
 #include "EasingBase.h"
 
@@ -22,18 +22,42 @@ class QuarticEase : public EasingBase
 {
 public:
 	using EasingBase::EasingBase; // inherit base class constructors
-	// starts motion from a zero velocity, and then accelerates
-	// motion as it executes.
-	virtual NUMBER easeIn(NUMBER time_) const;
-
-	// starts motion fast, and then decelerates motion to
-	// a zero velocity as it executes
-	virtual NUMBER easeOut(NUMBER time_) const;
-
-	// Combines the motion of the easeIn and easeOut methods to
-	// to start the motion from a zero velocity, accelerate motion,
-	// then decelerate to a zero velocity
-	virtual NUMBER easeInOut(NUMBER time_) const;
+
+	// normalized easing curve, see EasingCurve<QuarticEase>
+	virtual NUMBER curve(easingType_t type_, NUMBER time_) const;
+};
+
+
+/*
+ * Stateless quartic easing equations, time_ and the result are fractions of the duration and the change
+ */
+
+template<>
+struct EasingCurve<QuarticEase>
+{
+	// accelerates from zero velocity
+	static inline NUMBER in(NUMBER time_)
+	{
+		return time_*time_*time_*time_;
+	}
+
+	// decelerates to zero velocity
+	static inline NUMBER out(NUMBER time_)
+	{
+		time_-=1;
+		return -(time_*time_*time_*time_-1);
+	}
+
+	// accelerates until halfway, then decelerates
+	static inline NUMBER inOut(NUMBER time_)
+	{
+		time_*=2;
+		if(time_<1)
+			return time_*time_*time_*time_/2;
+
+		time_-=2;
+		return -(time_*time_*time_*time_-2)/2;
+	}
 };
 
 
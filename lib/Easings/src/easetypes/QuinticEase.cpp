@@ -11,39 +11,10 @@
 
 
 /*
- * Ease in
+ * Evaluate the normalized curve, see EasingCurve<QuinticEase>
  */
 
-NUMBER QuinticEase::easeIn(NUMBER time_) const
+NUMBER QuinticEase::curve(easingType_t type_, NUMBER time_) const
 {
-	time_/=_duration;
-	return _change*time_*time_*time_*time_*time_;
-}
-
-
-/*
- * Ease out
- */
-
-NUMBER QuinticEase::easeOut(NUMBER time_) const
-{
-	time_=time_/_duration-1;
-	return _change*(time_*time_*time_*time_*time_+1);
-
-}
-
-
-/*
- * Ease in and out
- */
-
-NUMBER QuinticEase::easeInOut(NUMBER time_) const
-{
-	time_/=_duration/2;
-
-	if(time_<1)
-		return _change/2*time_*time_*time_*time_*time_;
-
-	time_-=2;
-	return _change/2*(time_*time_*time_*time_*time_+2);
+	return ::ease<QuinticEase>(type_, time_, 1, 1);
 }
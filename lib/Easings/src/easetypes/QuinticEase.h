@@ -22,18 +22,42 @@ class QuinticEase : public EasingBase
 {
 public:
 	using EasingBase::EasingBase; // inherit base class constructors
-	// starts motion from a zero velocity, and then accelerates
-	// motion as it executes.
-	virtual NUMBER easeIn(NUMBER time_) const;
-
-	// starts motion fast, and then decelerates motion to
-	// a zero velocity as it executes
-	virtual NUMBER easeOut(NUMBER time_) const;
-
-	// Combines the motion of the easeIn and easeOut methods to
-	// to start the motion from a zero velocity, accelerate motion,
-	// then decelerate to a zero velocity
-	virtual NUMBER easeInOut(NUMBER time_) const;
+
+	// normalized easing curve, see EasingCurve<QuinticEase>
+	virtual NUMBER curve(easingType_t type_, NUMBER time_) const;
+};
+
+
+/*
+ * Stateless quintic easing equations, time_ and the result are fractions of the duration and the change
+ */
+
+template<>
+struct EasingCurve<QuinticEase>
+{
+	// accelerates from zero velocity
+	static inline NUMBER in(NUMBER time_)
+	{
+		return time_*time_*time_*time_*time_;
+	}
+
+	// decelerates to zero velocity
+	static inline NUMBER out(NUMBER time_)
+	{
+		time_-=1;
+		return time_*time_*time_*time_*time_+1;
+	}
+
+	// accelerates until halfway, then decelerates
+	static inline NUMBER inOut(NUMBER time_)
+	{
+		time_*=2;
+		if(time_<1)
+			return time_*time_*time_*time_*time_/2;
+
+		time_-=2;
+		return (time_*time_*time_*time_*time_+2)/2;
+	}
 };
 
 
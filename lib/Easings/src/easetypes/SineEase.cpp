@@ -7,35 +7,14 @@
  * http://creativecommons.org/licenses/by-sa/3.0/
  */
 
-#include <math.h>
 #include "SineEase.h"
 
 
 /*
- * Ease in
+ * Evaluate the normalized curve, see EasingCurve<SineEase>
  */
 
-NUMBER SineEase::easeIn(NUMBER time_) const
+NUMBER SineEase::curve(easingType_t type_, NUMBER time_) const
 {
-	return -_change*cos(time_/_duration*M_PI_2)+_change;
-}
-
-
-/*
- * Ease out
- */
-
-NUMBER SineEase::easeOut(NUMBER time_) const
-{
-	return _change*sin(time_/_duration*M_PI_2);
-}
-
-
-/*
- * Ease in and out
- */
-
-NUMBER SineEase::easeInOut(NUMBER time_) const
-{
-	return -_change/2*(cos(M_PI*time_/_duration)-1);
+	return ::ease<SineEase>(type_, time_, 1, 1);
 }
@@ -10,6 +10,7 @@
 #ifndef __710BAE70_D63D_48ab_98F4_8421836D9DE5
 #define __710BAE70_D63D_48ab_98F4_8421836D9DE5
 
+#include <math.h>
 #include "EasingBase.h"
 
 
@@ -21,18 +22,36 @@ class SineEase : public EasingBase
 {
 public:
 	using EasingBase::EasingBase; // inherit base class constructors
-	// starts motion from a zero velocity, and then accelerates
-	// motion as it executes.
-	virtual NUMBER easeIn(NUMBER time_) const;
-
-	// starts motion fast, and then decelerates motion to
-	// a zero velocity as it executes
-	virtual NUMBER easeOut(NUMBER time_) const;
-
-	// Combines the motion of the easeIn and easeOut methods to
-	// to start the motion from a zero velocity, accelerate motion,
-	// then decelerate to a zero velocity
-	virtual NUMBER easeInOut(NUMBER time_) const;
+
+	// normalized easing curve, see EasingCurve<SineEase>
+	virtual NUMBER curve(easingType_t type_, NUMBER time_) const;
+};
+
+
+/*
+ * Stateless sine easing equations, time_ and the result are fractions of the duration and the change
+ */
+
+template<>
+struct EasingCurve<SineEase>
+{
+	// accelerates from zero velocity
+	static inline NUMBER in(NUMBER time_)
+	{
+		return 1-cos(time_*M_PI_2);
+	}
+
+	// decelerates to zero velocity
+	static inline NUMBER out(NUMBER time_)
+	{
+		return sin(time_*M_PI_2);
+	}
+
+	// accelerates until halfway, then decelerates
+	static inline NUMBER inOut(NUMBER time_)
+	{
+		return -(cos(M_PI*time_)-1)/2;
+	}
 };
 
 
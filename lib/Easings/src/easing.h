@@ -22,4 +22,7 @@
 #include "easetypes/QuinticEase.h"
 #include "easetypes/SineEase.h"
 
+// fixed point backend
+#include "EasingLookupTable.h"
+
 #endif
@@ -13,6 +13,12 @@
 
 #define MAX_MILLIAMPS 4000 // 4 amps at 5v
 
+// Current one LED draws at full brightness per color channel, and while it is off. Used to estimate the load against MAX_MILLIAMPS
+#define LED_MILLIAMPS_RED		16
+#define LED_MILLIAMPS_GREEN		11
+#define LED_MILLIAMPS_BLUE		15
+#define LED_MILLIAMPS_IDLE		1
+
 #define ENABLE_ALEXA true
 #define ALEXA_LAMP_1 "Shelf Down Lights"
 #define ALEXA_LAMP_2 "Shelf Clock Lights"
@@ -66,7 +72,9 @@
 #define TIMER_FLASH_COUNT 10
 
 #define ALARM_NOTIFICATION_PERIOD 600
-#define NOTIFICATION_BRIGHTNESS 125
+// Timer and alarm notifications flash this overlay on top of the digits and the downlights, black at full opacity blanks them
+#define NOTIFICATION_OVERLAY_COLOR CRGB::Black
+#define NOTIFICATION_OVERLAY_OPACITY 255
 
 // How often the time is checked and the displays are updated
 #define TIME_UPDATE_INTERVAL	500
@@ -119,18 +127,47 @@ enum DisplayIDs {
 // How fast the brightness interpolation shall react to brightness changes
 #define BRIGHTNESS_INTERPOLATION	3000
 
+// Time in ms it takes to crossfade the segments or the downlights to a new color, 0 changes colors instantly
+#define COLOR_FADE_DURATION		500
+
+// Time in ms it takes a brightness channel (hours, minutes, downlights) to reach a new level
+#define CHANNEL_BRIGHTNESS_INTERPOLATION	1000
+
+// Gamma of the lookup table that maps the level of a brightness channel to the LED scale, 1.0 is linear
+#define BRIGHTNESS_GAMMA		2.2
+
+// Horizontal gap between two displays in LEDs, only used to place the LEDs for the effects across the whole shelf (SpatialEffects.h)
+#define SPATIAL_DISPLAY_GAP		3
+
 // If set to -1 the flashing middle dot is disabled, otherwise this is the index of the Display segment that should display the dot.
 #define DISPLAY_FOR_SEPARATION_DOT -1
 #define DOT_FLASH_SPEED 2000
 #define DOT_FLASH_INTERVAL	4000
 #define NUM_SEPARATION_DOTS	2
 
-#define ANIMATION_TARGET_FPS		60 // was 60
+// Upper limit of the frame rate of the Animator. The actual rate is derived at runtime from the length of the LED strips
+// and the measured duration of a show, it only reaches this limit if the strips can be updated that fast
+#define ANIMATION_MAX_FPS			100
+
+// Maximum number of objects (segments) one Animator can manage. Has to be at least NUM_SEGMENTS
+#define ANIMATOR_MAX_OBJECTS		32
+// Maximum number of complex animations (digit transitions, loading animations, ...) that can exist at the same time
+#define ANIMATOR_MAX_COMPLEX_ANIMATIONS	16
 
 // Length of sooth animation transition from fully on to black and vice versa in percent
 // NOTE: The higher this number the less obvious easing effects like bounce or elastic will be
 #define ANIMATION_AFTERGLOW			0.2
 
+// Evaluate the easings of the transitions with precomputed fixed point tables instead of double math
+#define USE_EASING_LOOKUP_TABLES	true
+
+// Render the segment wipes from precomputed 8 bit intensity tables instead of calculating the afterglow of every LED in every frame
+#define USE_INTENSITY_CACHE			true
+// Rows of the intensity table per unit of animation progress, frames in between are interpolated
+#define ANIMATION_INTENSITY_STEPS	64
+// Number of different segment lengths the intensity cache can hold, longer segments than NUM_LEDS_PER_SEGMENT are never cached
+#define ANIMATION_INTENSITY_CACHE_SLOTS	2
+
 /***************************
 *
 * Light sensor settings
@@ -147,6 +184,10 @@ enum DisplayIDs {
 	#define LIGHT_SENSOR_MIN			5
 	#define LIGHT_SENSOR_MAX			4095
 	#define LIGHT_SENSOR_SENSITIVITY	100
+	// The sensor is read by a background task, so the ADC never delays a frame. Runs next to WiFi on core 0
+	#define LIGHT_SENSOR_TASK_CORE			0
+	#define LIGHT_SENSOR_TASK_PRIORITY		1
+	#define LIGHT_SENSOR_TASK_STACK_SIZE	2048
 #endif
 
 
@@ -162,7 +203,28 @@ enum DisplayIDs {
 // The time it takes for one digit to morph into another
 #define DIGIT_ANIMATION_SPEED 900
 
-// The minimum delay between calls of FastLED.show()
-#define FASTLED_SAFE_DELAY_MS 20 // was 20
+// If a digit changes again while its transition is still running it blends from what is shown right now to the new digit
+// over the rest of the transition, but never faster than this (in ms)
+#define DIGIT_RETARGET_MIN_DURATION	(DIGIT_ANIMATION_SPEED / 3)
+
+// Speed of the digit transitions and the loading animation in percent. All durations above are the ones at 100%,
+// it can be changed at runtime from the web interface without touching the animation definitions
+#define DEFAULT_ANIMATION_SPEED		100
+
+// Time it takes to send the data of one LED to the strip (24 bit at 800 kHz for WS2812B) and the pause that latches a frame.
+// Used to model how long showing a strip takes, see LEDOutput::getWireTime
+#define LED_WIRE_TIME_PER_LED_US	30
+#define LED_LATCH_TIME_US			50
+
+// Render the animations and push the LEDs from a dedicated task at the frame rate of the Animator
+// instead of from loop(). The LED buffers are double buffered so the LEDs never show a half written frame
+#define USE_RENDER_TASK			true
+// Core the render task is pinned to. WiFi and the network stack run on core 0
+#define RENDER_TASK_CORE		1
+// Has to be higher than the priority of the Arduino loop task (1) to keep the frame rate stable
+#define RENDER_TASK_PRIORITY	2
+#define RENDER_TASK_STACK_SIZE	4096
+// Longest time DisplayManager::waitForAnimations and waitForLoadingAnimationFinish block the caller
+#define ANIMATION_WAIT_TIMEOUT_MS	10000
 
 #endif
@@ -1,24 +1,32 @@
 /**
- * \file DisplayConfiguration.cpp
+ * \file DisplayConfiguration.h
  * \author Florian laschober
  * \brief Configuration for the whole LED setup.
+ * 		  The tables are constexpr so that segment lookups in the animation configs can be resolved at compile time.
  */
 
 //This configuration is for a 12h display without intermediate segments
 
-#include "DisplayManager.h"
+#ifndef __DISPLAY_CONFIGURATION_H_
+#define __DISPLAY_CONFIGURATION_H_
+
+#include "Segment.h"
+#include "SevenSegment.h"
+#include "Configuration.h"
 
 /**
  * \addtogroup DisplayConfiguration
  * \brief Configuration to tell the system how the LEDs are wired together and arranged.
  *  \{
  */
+namespace DisplayConfiguration
+{
 
 /**
  * \brief Each segment belongs to some display. This array defines the segment position within this one display.
  * 		  The order of these has to mach the order in which the LEDs are wired.
  */
-SevenSegment::SegmentPosition DisplayManager::SegmentPositions[NUM_SEGMENTS] = {
+constexpr SevenSegment::SegmentPosition SegmentPositions[NUM_SEGMENTS] = {
 	SevenSegment::RightTopSegment,
 	SevenSegment::MiddleTopSegment,
 	SevenSegment::LeftTopSegment,
@@ -49,10 +57,10 @@ SevenSegment::SegmentPosition DisplayManager::SegmentPositions[NUM_SEGMENTS] = {
 
 /**
  * \brief Each segment has a direction, this is important for animation.
- * 		  The order of them is the same as #DisplayManager::SegmentPositions and the direction has to match the
+ * 		  The order of them is the same as #DisplayConfiguration::SegmentPositions and the direction has to match the
  *        sequence in which the LEDs are wired.
  */
-Segment::direction DisplayManager::SegmentDirections[NUM_SEGMENTS] = {
+constexpr Segment::direction SegmentDirections[NUM_SEGMENTS] = {
 	Segment::BOTTOM_TO_TOP,
 	Segment::RIGHT_TO_LEFT,
 	Segment::TOP_TO_BOTTOM,
@@ -82,9 +90,9 @@ Segment::direction DisplayManager::SegmentDirections[NUM_SEGMENTS] = {
 };
 
 /**
- * \brief Displays that are present. These define the displays in the order that is set in the #DisplayManager::displayIndex array.
+ * \brief Displays that are present. These define the displays in the order that is set in the #DisplayConfiguration::displayIndex array.
  */
-SevenSegment::SevenSegmentMode DisplayManager::SegmentDisplayModes[NUM_DISPLAYS] = {
+constexpr SevenSegment::SevenSegmentMode SegmentDisplayModes[NUM_DISPLAYS] = {
 	SevenSegment::FULL_SEGMENT,
 	SevenSegment::FULL_SEGMENT,
 	SevenSegment::FULL_SEGMENT,
@@ -92,11 +100,22 @@ SevenSegment::SevenSegmentMode DisplayManager::SegmentDisplayModes[NUM_DISPLAYS]
 };
 
 /**
- * \brief These indicies correspond to the index of a Diplay in the array above (#DisplayManager::SegmentDisplayModes).
+ * \brief Horizontal position of each display counted from the left, in the same order as #DisplayConfiguration::SegmentDisplayModes.
+ * 		  Together with the positions and directions of the segments this defines where every LED is on the shelf, see #SpatialEffects
+ */
+constexpr uint8_t DisplayColumns[NUM_DISPLAYS] = {
+	3,	// LOWER_DIGIT_MINUTE_DISPLAY
+	2,	// HIGHER_DIGIT_MINUTE_DISPLAY
+	1,	// LOWER_DIGIT_HOUR_DISPLAY
+	0	// HIGHER_DIGIT_HOUR_DISPLAY
+};
+
+/**
+ * \brief These indicies correspond to the index of a Diplay in the array above (#DisplayConfiguration::SegmentDisplayModes).
  * 		  They define which segment belongs to which Display in the order that they are wired in.
  *        The enum #DisplayIDs from \ref Configuration.h can also be used to create a more readable config.
  */
-uint8_t DisplayManager::displayIndex[NUM_SEGMENTS] = {
+constexpr uint8_t displayIndex[NUM_SEGMENTS] = {
 	LOWER_DIGIT_MINUTE_DISPLAY,
 	LOWER_DIGIT_MINUTE_DISPLAY,
 	LOWER_DIGIT_MINUTE_DISPLAY,
@@ -125,4 +144,7 @@ uint8_t DisplayManager::displayIndex[NUM_SEGMENTS] = {
 	HIGHER_DIGIT_HOUR_DISPLAY
 };
 
+}
 /** \}*/
+
+#endif
@@ -1,630 +1,415 @@
 #include "SegmentTransitions.h"
+#include "TransitionSynthesizer.h"
 
 /**
- * \brief Easings have to be setup before any of the initAnimate functions are called
- * 		  it's only possible to reuse an easing if the multiple anstances of
- * 		  it running at the same time have the exact same settings. This includes duration too.
+ * \brief Easings used by the transitions below. They are shared between all transitions and segments,
+ * 		  this is safe because an #AnimatableObject only evaluates the normalized curve of an easing
+ * 		  and keeps duration and progress itself.
  * \addtogroup AnimationEasings
  * \{
  */
-BounceEase* bounceEaseOut 	= new BounceEase(EASE_OUT);
-CubicEase* cubicEaseInOut 	= new CubicEase(EASE_IN_OUT);
-CubicEase* cubicEaseIn 		= new CubicEase(EASE_IN);
-CubicEase* cubicEaseOut 	= new CubicEase(EASE_OUT);
+BounceEase bounceEaseOut(EASE_OUT);
+CubicEase cubicEaseInOut(EASE_IN_OUT);
+CubicEase cubicEaseIn(EASE_IN);
+CubicEase cubicEaseOut(EASE_OUT);
 /** \} */
 
+#if USE_EASING_LOOKUP_TABLES == true
 /**
- * \brief Function prototypes for all segment transition animation init functions
- * \addtogroup TransitionAnimationInitFunctions
- * \{
+ * \brief Fixed point tables of the easings above, sampled once during boot and bound to their easing
  */
-Animator::ComplexAmination* InitAnimate0to1(uint16_t totalAnimationLength);
-Animator::ComplexAmination* InitAnimate1to2(uint16_t totalAnimationLength);
-Animator::ComplexAmination* InitAnimate2to3(uint16_t totalAnimationLength);
-Animator::ComplexAmination* InitAnimate2to0(uint16_t totalAnimationLength);
-Animator::ComplexAmination* InitAnimate3to4(uint16_t totalAnimationLength);
-Animator::ComplexAmination* InitAnimate4to5(uint16_t totalAnimationLength);
-Animator::ComplexAmination* InitAnimate5to6(uint16_t totalAnimationLength);
-Animator::ComplexAmination* InitAnimate5to0(uint16_t totalAnimationLength);
-Animator::ComplexAmination* InitAnimate6to7(uint16_t totalAnimationLength);
-Animator::ComplexAmination* InitAnimate7to8(uint16_t totalAnimationLength);
-Animator::ComplexAmination* InitAnimate8to9(uint16_t totalAnimationLength);
-Animator::ComplexAmination* InitAnimate9to0(uint16_t totalAnimationLength);
-Animator::ComplexAmination* InitAnimateOFFto1(uint16_t totalAnimationLength);
-Animator::ComplexAmination* InitAnimate1toOFF(uint16_t totalAnimationLength);
-Animator::ComplexAmination* InitAnimate9to8(uint16_t totalAnimationLength);
-Animator::ComplexAmination* InitAnimate8to7(uint16_t totalAnimationLength);
-Animator::ComplexAmination* InitAnimate7to6(uint16_t totalAnimationLength);
-Animator::ComplexAmination* InitAnimate6to5(uint16_t totalAnimationLength);
-Animator::ComplexAmination* InitAnimate5to4(uint16_t totalAnimationLength);
-Animator::ComplexAmination* InitAnimate4to3(uint16_t totalAnimationLength);
-Animator::ComplexAmination* InitAnimate3to2(uint16_t totalAnimationLength);
-Animator::ComplexAmination* InitAnimate2to1(uint16_t totalAnimationLength);
-Animator::ComplexAmination* InitAnimate1to0(uint16_t totalAnimationLength);
-Animator::ComplexAmination* InitAnimate0to9(uint16_t totalAnimationLength);
-Animator::ComplexAmination* InitAnimate0to5(uint16_t totalAnimationLength);
-/** \} */
+static EasingLookupTable bounceEaseOutTable(bounceEaseOut);
+static EasingLookupTable cubicEaseInOutTable(cubicEaseInOut);
+static EasingLookupTable cubicEaseInTable(cubicEaseIn);
+static EasingLookupTable cubicEaseOutTable(cubicEaseOut);
+#endif
+
+const EasingBase* const RetargetEasing = &cubicEaseOut;
+const EasingBase* const ColorFadeEasing = &cubicEaseOut;
+const EasingBase* const BrightnessEasing = &cubicEaseOut;
+
+/**
+ * \brief Create a transition from its tables. The length is divided by the number of steps + 1
+ * 		  because the last animation also takes time.
+ */
+#define TRANSITION(NAME)	COMPLEX_ANIMATION(NAME, DIGIT_ANIMATION_SPEED / (COMPLEX_ANIMATION_STEPS(NAME) + 1))
 
 /**
- * \brief Global variables for all segment transition animations
+ * \brief Global constant tables for all segment transition animations.
+ * 		  Each row of the Segments, Effects and Easings tables is one animation step, each column one animation within the step.
+ * 		  Everything is known at compile time, so the tables are placed in flash and nothing has to be built on the heap during boot.
  * \addtogroup TransitionAnimations
  * \{
  */
-Animator::ComplexAmination* Animate0to1 	= InitAnimate0to1(DIGIT_ANIMATION_SPEED);
-Animator::ComplexAmination* Animate1to2 	= InitAnimate1to2(DIGIT_ANIMATION_SPEED);
-Animator::ComplexAmination* Animate2to3 	= InitAnimate2to3(DIGIT_ANIMATION_SPEED);
-Animator::ComplexAmination* Animate3to4 	= InitAnimate3to4(DIGIT_ANIMATION_SPEED);
-Animator::ComplexAmination* Animate2to0 	= InitAnimate2to0(DIGIT_ANIMATION_SPEED);
-Animator::ComplexAmination* Animate4to5 	= InitAnimate4to5(DIGIT_ANIMATION_SPEED);
-Animator::ComplexAmination* Animate5to6 	= InitAnimate5to6(DIGIT_ANIMATION_SPEED);
-Animator::ComplexAmination* Animate5to0 	= InitAnimate5to0(DIGIT_ANIMATION_SPEED);
-Animator::ComplexAmination* Animate6to7 	= InitAnimate6to7(DIGIT_ANIMATION_SPEED);
-Animator::ComplexAmination* Animate7to8 	= InitAnimate7to8(DIGIT_ANIMATION_SPEED);
-Animator::ComplexAmination* Animate8to9 	= InitAnimate8to9(DIGIT_ANIMATION_SPEED);
-Animator::ComplexAmination* Animate9to0 	= InitAnimate9to0(DIGIT_ANIMATION_SPEED);
-Animator::ComplexAmination* AnimateOFFto1 	= InitAnimateOFFto1(DIGIT_ANIMATION_SPEED);
-Animator::ComplexAmination* Animate1toOFF 	= InitAnimate1toOFF(DIGIT_ANIMATION_SPEED);
-Animator::ComplexAmination* Animate9to8 	= InitAnimate9to8(DIGIT_ANIMATION_SPEED);
-Animator::ComplexAmination* Animate8to7 	= InitAnimate8to7(DIGIT_ANIMATION_SPEED);
-Animator::ComplexAmination* Animate7to6 	= InitAnimate7to6(DIGIT_ANIMATION_SPEED);
-Animator::ComplexAmination* Animate6to5 	= InitAnimate6to5(DIGIT_ANIMATION_SPEED);
-Animator::ComplexAmination* Animate5to4 	= InitAnimate5to4(DIGIT_ANIMATION_SPEED);
-Animator::ComplexAmination* Animate4to3 	= InitAnimate4to3(DIGIT_ANIMATION_SPEED);
-Animator::ComplexAmination* Animate3to2 	= InitAnimate3to2(DIGIT_ANIMATION_SPEED);
-Animator::ComplexAmination* Animate2to1 	= InitAnimate2to1(DIGIT_ANIMATION_SPEED);
-Animator::ComplexAmination* Animate1to0 	= InitAnimate1to0(DIGIT_ANIMATION_SPEED);
-Animator::ComplexAmination* Animate0to9 	= InitAnimate0to9(DIGIT_ANIMATION_SPEED);
-Animator::ComplexAmination* Animate0to5 	= InitAnimate0to5(DIGIT_ANIMATION_SPEED);
+static constexpr int16_t Animate0to1Segments[][2] = {
+	{TOP_LEFT_SEGMENT,		BOTTOM_LEFT_SEGMENT},
+	{TOP_MIDDLE_SEGMENT,	BOTTOM_MIDDLE_SEGMENT}
+};
+static constexpr AnimatableObject::AnimationFunction Animate0to1Effects[][2] = {
+	{AnimationEffects::AnimateOutToTop,		AnimationEffects::AnimateOutToBottom},
+	{AnimationEffects::AnimateOutToRight,	AnimationEffects::AnimateOutToRight}
+};
+static constexpr const EasingBase* Animate0to1Easings[][2] = {
+	{&cubicEaseIn,	&cubicEaseIn},
+	{&cubicEaseOut,	&cubicEaseOut}
+};
+const Animator::ComplexAmination Animate0to1 = TRANSITION(Animate0to1);
+
+static constexpr int16_t Animate1to2Segments[][2] = {
+	{BOTTOM_RIGHT_SEGMENT,	CENTER_SEGMENT},
+	{BOTTOM_LEFT_SEGMENT,	NO_SEGMENTS},
+	{BOTTOM_MIDDLE_SEGMENT,	TOP_MIDDLE_SEGMENT}
+};
+static constexpr AnimatableObject::AnimationFunction Animate1to2Effects[][2] = {
+	{AnimationEffects::AnimateOutToTop,		AnimationEffects::AnimateInToLeft},
+	{AnimationEffects::AnimateInToBottom,	NO_ANIMATION},
+	{AnimationEffects::AnimateInToRight,	AnimationEffects::AnimateInToLeft}
+};
+static constexpr const EasingBase* Animate1to2Easings[][2] = {
+	{&cubicEaseIn,		NO_EASING},
+	{NO_EASING,			NO_EASING},
+	{&bounceEaseOut,	&bounceEaseOut}
+};
+const Animator::ComplexAmination Animate1to2 = TRANSITION(Animate1to2);
+
+static constexpr int16_t Animate2to3Segments[][2] = {
+	{BOTTOM_LEFT_SEGMENT,	BOTTOM_RIGHT_SEGMENT}
+};
+static constexpr AnimatableObject::AnimationFunction Animate2to3Effects[][2] = {
+	{AnimationEffects::AnimateOutToBottom,	AnimationEffects::AnimateInToTop}
+};
+static constexpr const EasingBase* Animate2to3Easings[][2] = {
+	{&bounceEaseOut,	&bounceEaseOut}
+};
+const Animator::ComplexAmination Animate2to3 = TRANSITION(Animate2to3);
+
+static constexpr int16_t Animate2to0Segments[][3] = {
+	{TOP_LEFT_SEGMENT,	CENTER_SEGMENT,	BOTTOM_RIGHT_SEGMENT}
+};
+static constexpr AnimatableObject::AnimationFunction Animate2to0Effects[][3] = {
+	{AnimationEffects::AnimateInToBottom,	AnimationEffects::AnimateOutToRight,	AnimationEffects::AnimateInToBottom}
+};
+static constexpr const EasingBase* Animate2to0Easings[][3] = {
+	{&bounceEaseOut,	&cubicEaseInOut,	&bounceEaseOut}
+};
+const Animator::ComplexAmination Animate2to0 = TRANSITION(Animate2to0);
+
+static constexpr int16_t Animate3to4Segments[][3] = {
+	{BOTTOM_MIDDLE_SEGMENT,	TOP_LEFT_SEGMENT,	TOP_MIDDLE_SEGMENT}
+};
+static constexpr AnimatableObject::AnimationFunction Animate3to4Effects[][3] = {
+	{AnimationEffects::AnimateOutToRight,	AnimationEffects::AnimateInToBottom,	AnimationEffects::AnimateOutToLeft}
+};
+static constexpr const EasingBase* Animate3to4Easings[][3] = {
+	{&bounceEaseOut,	&bounceEaseOut,	&bounceEaseOut}
+};
+const Animator::ComplexAmination Animate3to4 = TRANSITION(Animate3to4);
+
+static constexpr int16_t Animate4to5Segments[][3] = {
+	{TOP_RIGHT_SEGMENT,	TOP_MIDDLE_SEGMENT,	BOTTOM_MIDDLE_SEGMENT}
+};
+static constexpr AnimatableObject::AnimationFunction Animate4to5Effects[][3] = {
+	{AnimationEffects::AnimateOutToTop,	AnimationEffects::AnimateInToLeft,	AnimationEffects::AnimateInToLeft}
+};
+static constexpr const EasingBase* Animate4to5Easings[][3] = {
+	{&bounceEaseOut,	&bounceEaseOut,	&bounceEaseOut}
+};
+const Animator::ComplexAmination Animate4to5 = TRANSITION(Animate4to5);
+
+static constexpr int16_t Animate5to6Segments[][1] = {
+	{BOTTOM_LEFT_SEGMENT}
+};
+static constexpr AnimatableObject::AnimationFunction Animate5to6Effects[][1] = {
+	{AnimationEffects::AnimateInToTop}
+};
+static constexpr const EasingBase* Animate5to6Easings[][1] = {
+	{&bounceEaseOut}
+};
+const Animator::ComplexAmination Animate5to6 = TRANSITION(Animate5to6);
+
+static constexpr int16_t Animate5to0Segments[][3] = {
+	{CENTER_SEGMENT,	BOTTOM_LEFT_SEGMENT,	TOP_RIGHT_SEGMENT}
+};
+static constexpr AnimatableObject::AnimationFunction Animate5to0Effects[][3] = {
+	{AnimationEffects::AnimateOutToRight,	AnimationEffects::AnimateInToBottom,	AnimationEffects::AnimateInToTop}
+};
+static constexpr const EasingBase* Animate5to0Easings[][3] = {
+	{&bounceEaseOut,	&bounceEaseOut,	&bounceEaseOut}
+};
+const Animator::ComplexAmination Animate5to0 = TRANSITION(Animate5to0);
+
+static constexpr int16_t Animate6to7Segments[][3] = {
+	{TOP_LEFT_SEGMENT,		CENTER_SEGMENT,	TOP_RIGHT_SEGMENT},
+	{BOTTOM_LEFT_SEGMENT,	NO_SEGMENTS,	NO_SEGMENTS},
+	{BOTTOM_MIDDLE_SEGMENT,	NO_SEGMENTS,	NO_SEGMENTS}
+};
+static constexpr AnimatableObject::AnimationFunction Animate6to7Effects[][3] = {
+	{AnimationEffects::AnimateOutToTop,		AnimationEffects::AnimateOutToLeft,	AnimationEffects::AnimateInToBottom},
+	{AnimationEffects::AnimateOutToBottom,	NO_ANIMATION,						NO_ANIMATION},
+	{AnimationEffects::AnimateOutToRight,	NO_ANIMATION,						NO_ANIMATION}
+};
+static constexpr const EasingBase* Animate6to7Easings[][3] = {
+	{&cubicEaseIn,	&cubicEaseIn,	&cubicEaseOut},
+	{NO_EASING,		NO_EASING,		NO_EASING},
+	{&cubicEaseOut,	NO_EASING,		NO_EASING}
+};
+const Animator::ComplexAmination Animate6to7 = TRANSITION(Animate6to7);
+
+static constexpr int16_t Animate7to8Segments[][2] = {
+	{TOP_LEFT_SEGMENT,		BOTTOM_MIDDLE_SEGMENT},
+	{BOTTOM_LEFT_SEGMENT,	CENTER_SEGMENT}
+};
+static constexpr AnimatableObject::AnimationFunction Animate7to8Effects[][2] = {
+	{AnimationEffects::AnimateInToBottom,	AnimationEffects::AnimateInToLeft},
+	{AnimationEffects::AnimateInToTop,		AnimationEffects::AnimateInToRight}
+};
+static constexpr const EasingBase* Animate7to8Easings[][2] = {
+	{&cubicEaseIn,	&cubicEaseIn},
+	{&cubicEaseOut,	&cubicEaseOut}
+};
+const Animator::ComplexAmination Animate7to8 = TRANSITION(Animate7to8);
+
+static constexpr int16_t Animate8to9Segments[][1] = {
+	{BOTTOM_LEFT_SEGMENT}
+};
+static constexpr AnimatableObject::AnimationFunction Animate8to9Effects[][1] = {
+	{AnimationEffects::AnimateOutToBottom}
+};
+static constexpr const EasingBase* Animate8to9Easings[][1] = {
+	{&bounceEaseOut}
+};
+const Animator::ComplexAmination Animate8to9 = TRANSITION(Animate8to9);
+
+static constexpr int16_t Animate9to0Segments[][2] = {
+	{CENTER_SEGMENT,	BOTTOM_LEFT_SEGMENT}
+};
+static constexpr AnimatableObject::AnimationFunction Animate9to0Effects[][2] = {
+	{AnimationEffects::AnimateOutToLeft,	AnimationEffects::AnimateInToBottom}
+};
+static constexpr const EasingBase* Animate9to0Easings[][2] = {
+	{&bounceEaseOut,	&bounceEaseOut}
+};
+const Animator::ComplexAmination Animate9to0 = TRANSITION(Animate9to0);
+
+static constexpr int16_t Animate1toOFFSegments[][2] = {
+	{BOTTOM_RIGHT_SEGMENT,	TOP_RIGHT_SEGMENT}
+};
+static constexpr AnimatableObject::AnimationFunction Animate1toOFFEffects[][2] = {
+	{AnimationEffects::AnimateOutToBottom,	AnimationEffects::AnimateOutToTop}
+};
+static constexpr const EasingBase* Animate1toOFFEasings[][2] = {
+	{&cubicEaseInOut,	&cubicEaseInOut}
+};
+const Animator::ComplexAmination Animate1toOFF = TRANSITION(Animate1toOFF);
+
+static constexpr int16_t AnimateOFFto1Segments[][2] = {
+	{TOP_RIGHT_SEGMENT,	BOTTOM_RIGHT_SEGMENT}
+};
+static constexpr AnimatableObject::AnimationFunction AnimateOFFto1Effects[][2] = {
+	{AnimationEffects::AnimateInToTop,	AnimationEffects::AnimateInToBottom}
+};
+static constexpr const EasingBase* AnimateOFFto1Easings[][2] = {
+	{&cubicEaseInOut,	&cubicEaseInOut}
+};
+const Animator::ComplexAmination AnimateOFFto1 = TRANSITION(AnimateOFFto1);
+
+static constexpr int16_t Animate9to8Segments[][1] = {
+	{BOTTOM_LEFT_SEGMENT}
+};
+static constexpr AnimatableObject::AnimationFunction Animate9to8Effects[][1] = {
+	{AnimationEffects::AnimateInToTop}
+};
+static constexpr const EasingBase* Animate9to8Easings[][1] = {
+	{&bounceEaseOut}
+};
+const Animator::ComplexAmination Animate9to8 = TRANSITION(Animate9to8);
+
+static constexpr int16_t Animate8to7Segments[][3] = {
+	{TOP_LEFT_SEGMENT,		CENTER_SEGMENT,	BOTTOM_LEFT_SEGMENT},
+	{BOTTOM_MIDDLE_SEGMENT,	NO_SEGMENTS,	NO_SEGMENTS}
+};
+static constexpr AnimatableObject::AnimationFunction Animate8to7Effects[][3] = {
+	{AnimationEffects::AnimateOutToTop,		AnimationEffects::AnimateOutToRight,	AnimationEffects::AnimateOutToBottom},
+	{AnimationEffects::AnimateOutToRight,	NO_ANIMATION,							NO_ANIMATION}
+};
+static constexpr const EasingBase* Animate8to7Easings[][3] = {
+	{&cubicEaseIn,	&cubicEaseIn,	&cubicEaseIn},
+	{&cubicEaseOut,	&cubicEaseOut,	NO_EASING}
+};
+const Animator::ComplexAmination Animate8to7 = TRANSITION(Animate8to7);
+
+static constexpr int16_t Animate7to6Segments[][3] = {
+	{TOP_RIGHT_SEGMENT,	TOP_LEFT_SEGMENT,		BOTTOM_MIDDLE_SEGMENT},
+	{CENTER_SEGMENT,	BOTTOM_LEFT_SEGMENT,	NO_SEGMENTS}
+};
+static constexpr AnimatableObject::AnimationFunction Animate7to6Effects[][3] = {
+	{AnimationEffects::AnimateOutToTop,		AnimationEffects::AnimateInToBottom,	AnimationEffects::AnimateInToLeft},
+	{AnimationEffects::AnimateInToRight,	AnimationEffects::AnimateInToTop,		NO_ANIMATION}
+};
+static constexpr const EasingBase* Animate7to6Easings[][3] = {
+	{&cubicEaseIn,	&cubicEaseIn,	&cubicEaseIn},
+	{&cubicEaseOut,	&cubicEaseOut,	NO_EASING}
+};
+const Animator::ComplexAmination Animate7to6 = TRANSITION(Animate7to6);
+
+static constexpr int16_t Animate6to5Segments[][1] = {
+	{BOTTOM_LEFT_SEGMENT}
+};
+static constexpr AnimatableObject::AnimationFunction Animate6to5Effects[][1] = {
+	{AnimationEffects::AnimateOutToBottom}
+};
+static constexpr const EasingBase* Animate6to5Easings[][1] = {
+	{&bounceEaseOut}
+};
+const Animator::ComplexAmination Animate6to5 = TRANSITION(Animate6to5);
+
+static constexpr int16_t Animate5to4Segments[][3] = {
+	{TOP_MIDDLE_SEGMENT,	TOP_RIGHT_SEGMENT,	BOTTOM_MIDDLE_SEGMENT}
+};
+static constexpr AnimatableObject::AnimationFunction Animate5to4Effects[][3] = {
+	{AnimationEffects::AnimateOutToRight,	AnimationEffects::AnimateInToBottom,	AnimationEffects::AnimateOutToRight}
+};
+static constexpr const EasingBase* Animate5to4Easings[][3] = {
+	{&bounceEaseOut,	&bounceEaseOut,	&bounceEaseOut}
+};
+const Animator::ComplexAmination Animate5to4 = TRANSITION(Animate5to4);
+
+static constexpr int16_t Animate4to3Segments[][3] = {
+	{TOP_LEFT_SEGMENT,	TOP_MIDDLE_SEGMENT,	BOTTOM_MIDDLE_SEGMENT}
+};
+static constexpr AnimatableObject::AnimationFunction Animate4to3Effects[][3] = {
+	{AnimationEffects::AnimateOutToTop,	AnimationEffects::AnimateInToRight,	AnimationEffects::AnimateInToLeft}
+};
+static constexpr const EasingBase* Animate4to3Easings[][3] = {
+	{&bounceEaseOut,	&bounceEaseOut,	&bounceEaseOut}
+};
+const Animator::ComplexAmination Animate4to3 = TRANSITION(Animate4to3);
+
+static constexpr int16_t Animate3to2Segments[][2] = {
+	{BOTTOM_RIGHT_SEGMENT,	BOTTOM_LEFT_SEGMENT}
+};
+static constexpr AnimatableObject::AnimationFunction Animate3to2Effects[][2] = {
+	{AnimationEffects::AnimateOutToBottom,	AnimationEffects::AnimateInToTop}
+};
+static constexpr const EasingBase* Animate3to2Easings[][2] = {
+	{&bounceEaseOut,	&bounceEaseOut}
+};
+const Animator::ComplexAmination Animate3to2 = TRANSITION(Animate3to2);
+
+static constexpr int16_t Animate2to1Segments[][2] = {
+	{TOP_MIDDLE_SEGMENT,	CENTER_SEGMENT},
+	{BOTTOM_LEFT_SEGMENT,	NO_SEGMENTS},
+	{BOTTOM_RIGHT_SEGMENT,	BOTTOM_MIDDLE_SEGMENT}
+};
+static constexpr AnimatableObject::AnimationFunction Animate2to1Effects[][2] = {
+	{AnimationEffects::AnimateOutToRight,	AnimationEffects::AnimateOutToLeft},
+	{AnimationEffects::AnimateOutToBottom,	NO_ANIMATION},
+	{AnimationEffects::AnimateInToTop,		AnimationEffects::AnimateOutToRight}
+};
+static constexpr const EasingBase* Animate2to1Easings[][2] = {
+	{&cubicEaseInOut,	&cubicEaseIn},
+	{NO_EASING,			NO_EASING},
+	{NO_EASING,			NO_EASING}
+};
+const Animator::ComplexAmination Animate2to1 = TRANSITION(Animate2to1);
+
+static constexpr int16_t Animate1to0Segments[][2] = {
+	{TOP_MIDDLE_SEGMENT,	BOTTOM_MIDDLE_SEGMENT},
+	{BOTTOM_LEFT_SEGMENT,	TOP_LEFT_SEGMENT}
+};
+static constexpr AnimatableObject::AnimationFunction Animate1to0Effects[][2] = {
+	{AnimationEffects::AnimateInToLeft,	AnimationEffects::AnimateInToLeft},
+	{AnimationEffects::AnimateInToTop,	AnimationEffects::AnimateInToBottom}
+};
+static constexpr const EasingBase* Animate1to0Easings[][2] = {
+	{&cubicEaseIn,		&cubicEaseIn},
+	{&bounceEaseOut,	&bounceEaseOut}
+};
+const Animator::ComplexAmination Animate1to0 = TRANSITION(Animate1to0);
+
+static constexpr int16_t Animate0to9Segments[][2] = {
+	{BOTTOM_LEFT_SEGMENT,	CENTER_SEGMENT}
+};
+static constexpr AnimatableObject::AnimationFunction Animate0to9Effects[][2] = {
+	{AnimationEffects::AnimateOutToTop,	AnimationEffects::AnimateInToRight}
+};
+static constexpr const EasingBase* Animate0to9Easings[][2] = {
+	{&bounceEaseOut,	&bounceEaseOut}
+};
+const Animator::ComplexAmination Animate0to9 = TRANSITION(Animate0to9);
+
+static constexpr int16_t Animate0to5Segments[][3] = {
+	{TOP_RIGHT_SEGMENT,	CENTER_SEGMENT,	BOTTOM_LEFT_SEGMENT}
+};
+static constexpr AnimatableObject::AnimationFunction Animate0to5Effects[][3] = {
+	{AnimationEffects::AnimateOutToBottom,	AnimationEffects::AnimateInToLeft,	AnimationEffects::AnimateOutToBottom}
+};
+static constexpr const EasingBase* Animate0to5Easings[][3] = {
+	{&cubicEaseInOut,	&cubicEaseInOut,	&cubicEaseInOut}
+};
+const Animator::ComplexAmination Animate0to5 = TRANSITION(Animate0to5);
 /** \} */
 
+/**
+ * \brief Transition between two digits that is generated by the #TransitionSynthesizer from the segment masks of both digits.
+ * 		  Used for every digit pair that has no hand written transition. The tables only contain the cells
+ * 		  that are needed (steps * columns) and are evaluated at compile time, so they end up in flash as well.
+ * 		  Segments that turn off ease in, the ones that turn on ease out.
+ */
+template<uint8_t FROM, uint8_t TO, typename Cells = typename MakeIndexSequence<TransitionSynthesizer::numSteps(FROM, TO) * TransitionSynthesizer::numColumns(FROM, TO)>::type>
+struct SynthesizedTransition;
+
+template<uint8_t FROM, uint8_t TO, size_t... I>
+struct SynthesizedTransition<FROM, TO, IndexSequence<I...>>
+{
+	static constexpr int16_t Segments[] = {TransitionSynthesizer::segmentCell(FROM, TO, I)...};
+	static constexpr AnimatableObject::AnimationFunction Effects[] = {TransitionSynthesizer::effectCell(FROM, TO, I)...};
+	static constexpr const EasingBase* Easings[] = {(TransitionSynthesizer::isOutgoingCell(FROM, TO, I) ? &cubicEaseIn : &cubicEaseOut)...};
+	static const Animator::ComplexAmination animation;
+};
+
+template<uint8_t FROM, uint8_t TO, size_t... I>
+constexpr int16_t SynthesizedTransition<FROM, TO, IndexSequence<I...>>::Segments[];
+
+template<uint8_t FROM, uint8_t TO, size_t... I>
+constexpr AnimatableObject::AnimationFunction SynthesizedTransition<FROM, TO, IndexSequence<I...>>::Effects[];
+
+template<uint8_t FROM, uint8_t TO, size_t... I>
+constexpr const EasingBase* SynthesizedTransition<FROM, TO, IndexSequence<I...>>::Easings[];
+
+template<uint8_t FROM, uint8_t TO, size_t... I>
+const Animator::ComplexAmination SynthesizedTransition<FROM, TO, IndexSequence<I...>>::animation = {
+	TransitionSynthesizer::numColumns(FROM, TO),
+	DIGIT_ANIMATION_SPEED / (TransitionSynthesizer::numSteps(FROM, TO) + 1), //+1 because the last animation also takes time
+	TransitionSynthesizer::numSteps(FROM, TO),
+	Segments,
+	Effects,
+	Easings
+};
+
+/**
+ * \brief Shorthand for the lookup table below
+ */
+#define SYNTHESIZED(FROM, TO)	&SynthesizedTransition<FROM, TO>::animation
+
 /**
  * \brief This transformation lookup table defines which animation to call for which transition.
  * 		  Every row decides from which digits we want to morph and than the column of the digit we want to morph to is selected.
  * 		  The resulting animation is then executed in case that transition is neccesary.
+ * 		  Pairs without a hand written transition use the #SynthesizedTransition of that pair.
  *
  */
-Animator::ComplexAmination* TransformationLookupTable[11][11] = {
-		  //To:0              1              2              3              4              5              6              7              8              9             OFF
-/*from 0	*/{nullptr      , Animate0to1  , nullptr      , nullptr      , nullptr      , Animate0to5  , nullptr      , nullptr      , nullptr      , Animate0to9  , nullptr      },
-/*from 1	*/{Animate1to0  , nullptr      , Animate1to2  , nullptr      , nullptr      , nullptr      , nullptr      , nullptr      , nullptr      , nullptr      , Animate1toOFF},
-/*from 2	*/{Animate2to0  , Animate2to1  , nullptr      , Animate2to3  , nullptr      , nullptr      , nullptr      , nullptr      , nullptr      , nullptr      , nullptr      },
-/*from 3	*/{nullptr      , nullptr      , Animate3to2  , nullptr      , Animate3to4  , nullptr      , nullptr      , nullptr      , nullptr      , nullptr      , nullptr      },
-/*from 4	*/{nullptr      , nullptr      , nullptr      , Animate4to3  , nullptr      , Animate4to5  , nullptr      , nullptr      , nullptr      , nullptr      , nullptr      },
-/*from 5	*/{Animate5to0  , nullptr      , nullptr      , nullptr      , Animate5to4  , nullptr      , Animate5to6  , nullptr      , nullptr      , nullptr      , nullptr      },
-/*from 6	*/{nullptr      , nullptr      , nullptr      , nullptr      , nullptr      , Animate6to5  , nullptr      , Animate6to7  , nullptr      , nullptr      , nullptr      },
-/*from 7	*/{nullptr      , nullptr      , nullptr      , nullptr      , nullptr      , nullptr      , Animate7to6  , nullptr      , Animate7to8  , nullptr      , nullptr      },
-/*from 8	*/{nullptr      , nullptr      , nullptr      , nullptr      , nullptr      , nullptr      , nullptr      , Animate8to7  , nullptr      , Animate8to9  , nullptr      },
-/*from 9	*/{Animate9to0  , nullptr      , nullptr      , nullptr      , nullptr      , nullptr      , nullptr      , nullptr      , Animate9to8  , nullptr      , nullptr      },
-/*from OFF	*/{nullptr      , AnimateOFFto1, nullptr      , nullptr      , nullptr      , nullptr      , nullptr      , nullptr      , nullptr      , nullptr      , nullptr      }
-};
-
-Animator::ComplexAmination* InitAnimate0to1(uint16_t totalAnimationLength)
-{
-	#undef LENGTH
-	#define LENGTH	2
-	Animator::animationStep* step0 = new Animator::animationStep;
-	step0->arrayIndex 		= new int16_t[LENGTH]								{TOP_LEFT_SEGMENT, 						BOTTOM_LEFT_SEGMENT};
-	step0->animationEffects = new AnimatableObject::AnimationFunction[LENGTH]	{AnimationEffects::AnimateOutToTop, 	AnimationEffects::AnimateOutToBottom};
-	step0->easingEffects 	= new EasingBase*[LENGTH] 							{cubicEaseIn, 							cubicEaseIn};
-	Animator::animationStep* step1 = new Animator::animationStep;
-	step1->arrayIndex 		= new int16_t[LENGTH]								{TOP_MIDDLE_SEGMENT, 					BOTTOM_MIDDLE_SEGMENT};
-	step1->animationEffects = new AnimatableObject::AnimationFunction[LENGTH]	{AnimationEffects::AnimateOutToRight, 	AnimationEffects::AnimateOutToRight};
-	step1->easingEffects 	= new EasingBase*[LENGTH]							{cubicEaseOut, 							cubicEaseOut};
-
-	LinkedList<Animator::animationStep*>* AnimationStepSequence = new LinkedList<Animator::animationStep*>();
-	AnimationStepSequence->add(step0);
-	AnimationStepSequence->add(step1);
-
-	Animator::ComplexAmination* animation 	= new Animator::ComplexAmination();
-	animation->animationComplexity 			= LENGTH;
-	animation->LengthPerAnimation 			= totalAnimationLength / (AnimationStepSequence->size() + 1); //+1 because I have to account for the last animation also taking time.
-	animation->animations 					= AnimationStepSequence;
-	return animation;
-}
-
-Animator::ComplexAmination* InitAnimate1to2(uint16_t totalAnimationLength)
-{
-	#undef LENGTH
-	#define LENGTH	2
-	Animator::animationStep* step0 = new Animator::animationStep;
-	step0->arrayIndex 		= new int16_t[LENGTH]								{BOTTOM_RIGHT_SEGMENT, 					CENTER_SEGMENT};
-	step0->animationEffects = new AnimatableObject::AnimationFunction[LENGTH]	{AnimationEffects::AnimateOutToTop, 	AnimationEffects::AnimateInToLeft};
-	step0->easingEffects 	= new EasingBase*[LENGTH] 							{cubicEaseIn,							NO_EASING};
-	Animator::animationStep* step1 = new Animator::animationStep;
-	step1->arrayIndex 		= new int16_t[LENGTH] 								{BOTTOM_LEFT_SEGMENT, 					NO_SEGMENTS};
-	step1->animationEffects = new AnimatableObject::AnimationFunction[LENGTH] 	{AnimationEffects::AnimateInToBottom,	NO_ANIMATION};
-	step1->easingEffects 	= new EasingBase*[LENGTH] 							{NO_EASING, 							NO_EASING};
-	Animator::animationStep* step2 = new Animator::animationStep;
-	step2->arrayIndex 		= new int16_t[LENGTH] 								{BOTTOM_MIDDLE_SEGMENT, 				TOP_MIDDLE_SEGMENT};
-	step2->animationEffects = new AnimatableObject::AnimationFunction[LENGTH] 	{AnimationEffects::AnimateInToRight, 	AnimationEffects::AnimateInToLeft};
-	step2->easingEffects 	= new EasingBase*[LENGTH] 							{bounceEaseOut, 						bounceEaseOut};
-
-	LinkedList<Animator::animationStep*>* AnimationStepSequence = new LinkedList<Animator::animationStep*>();
-	AnimationStepSequence->add(step0);
-	AnimationStepSequence->add(step1);
-	AnimationStepSequence->add(step2);
-
-	Animator::ComplexAmination* animation = new Animator::ComplexAmination();
-	animation->animationComplexity 	= LENGTH;
-	animation->LengthPerAnimation 	= totalAnimationLength / (AnimationStepSequence->size() + 1); //+1 because I have to account for the last animation also taking time.
-	animation->animations 			= AnimationStepSequence;
-	return animation;
-}
-
-Animator::ComplexAmination* InitAnimate2to3(uint16_t totalAnimationLength)
-{
-	#undef LENGTH
-	#define LENGTH	2
-	Animator::animationStep* step0 = new Animator::animationStep;
-	step0->arrayIndex 		= new int16_t[LENGTH] 								{BOTTOM_LEFT_SEGMENT, 					BOTTOM_RIGHT_SEGMENT};
-	step0->animationEffects = new AnimatableObject::AnimationFunction[LENGTH] 	{AnimationEffects::AnimateOutToBottom, 	AnimationEffects::AnimateInToTop};
-	step0->easingEffects 	= new EasingBase*[LENGTH] 							{bounceEaseOut, 						bounceEaseOut};
-
-	LinkedList<Animator::animationStep*>* AnimationStepSequence = new LinkedList<Animator::animationStep*>();
-	AnimationStepSequence->add(step0);
-
-	Animator::ComplexAmination* animation = new Animator::ComplexAmination();
-	animation->animationComplexity 	= LENGTH;
-	animation->LengthPerAnimation 	= totalAnimationLength / (AnimationStepSequence->size() + 1); //+1 because I have to account for the last animation also taking time.
-	animation->animations 			= AnimationStepSequence;
-	return animation;
-}
-
-Animator::ComplexAmination* InitAnimate2to0(uint16_t totalAnimationLength)
-{
-	#undef LENGTH
-	#define LENGTH	3
-	Animator::animationStep* step0 = new Animator::animationStep;
-	step0->arrayIndex 		= new int16_t[LENGTH] 								{TOP_LEFT_SEGMENT, 						CENTER_SEGMENT, 						BOTTOM_RIGHT_SEGMENT};
-	step0->animationEffects = new AnimatableObject::AnimationFunction[LENGTH] 	{AnimationEffects::AnimateInToBottom, 	AnimationEffects::AnimateOutToRight, 	AnimationEffects::AnimateInToBottom};
-	step0->easingEffects 	= new EasingBase*[LENGTH] 							{bounceEaseOut, 						cubicEaseInOut,							bounceEaseOut};
-
-	LinkedList<Animator::animationStep*>* AnimationStepSequence = new LinkedList<Animator::animationStep*>();
-	AnimationStepSequence->add(step0);
-
-	Animator::ComplexAmination* animation = new Animator::ComplexAmination();
-	animation->animationComplexity = LENGTH;
-	animation->LengthPerAnimation = totalAnimationLength / (AnimationStepSequence->size()+1); //+1 because I have to account for the last animation also taking time.
-	animation->animations = AnimationStepSequence;
-	return animation;
-}
-
-Animator::ComplexAmination* InitAnimate3to4(uint16_t totalAnimationLength)
-{
-	#undef LENGTH
-	#define LENGTH	3
-	Animator::animationStep* step0 = new Animator::animationStep;
-	step0->arrayIndex = new int16_t[LENGTH] 									{BOTTOM_MIDDLE_SEGMENT, 				TOP_LEFT_SEGMENT, 						TOP_MIDDLE_SEGMENT};
-	step0->animationEffects = new AnimatableObject::AnimationFunction[LENGTH] 	{AnimationEffects::AnimateOutToRight, 	AnimationEffects::AnimateInToBottom, 	AnimationEffects::AnimateOutToLeft};
-	step0->easingEffects 	= new EasingBase*[LENGTH] 							{bounceEaseOut, 						bounceEaseOut,							bounceEaseOut};
-
-	LinkedList<Animator::animationStep*>* AnimationStepSequence = new LinkedList<Animator::animationStep*>();
-	AnimationStepSequence->add(step0);
-
-	Animator::ComplexAmination* animation = new Animator::ComplexAmination();
-	animation->animationComplexity = LENGTH;
-	animation->LengthPerAnimation = totalAnimationLength / (AnimationStepSequence->size() + 1); //+1 because I have to account for the last animation also taking time.
-	animation->animations = AnimationStepSequence;
-	return animation;
-}
-
-Animator::ComplexAmination* InitAnimate4to5(uint16_t totalAnimationLength)
-{
-	#undef LENGTH
-	#define LENGTH	3
-	Animator::animationStep* step0 = new Animator::animationStep;
-	step0->arrayIndex 		= new int16_t[LENGTH] 								{TOP_RIGHT_SEGMENT, 					TOP_MIDDLE_SEGMENT, 				BOTTOM_MIDDLE_SEGMENT};
-	step0->animationEffects = new AnimatableObject::AnimationFunction[LENGTH] 	{AnimationEffects::AnimateOutToTop, 	AnimationEffects::AnimateInToLeft, 	AnimationEffects::AnimateInToLeft};
-	step0->easingEffects 	= new EasingBase*[LENGTH] 							{bounceEaseOut, 						bounceEaseOut,						bounceEaseOut};
-
-	LinkedList<Animator::animationStep*>* AnimationStepSequence = new LinkedList<Animator::animationStep*>();
-	AnimationStepSequence->add(step0);
-
-	Animator::ComplexAmination* animation = new Animator::ComplexAmination();
-	animation->animationComplexity = LENGTH;
-	animation->LengthPerAnimation = totalAnimationLength / (AnimationStepSequence->size() + 1); //+1 because I have to account for the last animation also taking time.
-	animation->animations = AnimationStepSequence;
-	return animation;
-}
-
-Animator::ComplexAmination* InitAnimate5to6(uint16_t totalAnimationLength)
-{
-	#undef LENGTH
-	#define LENGTH	1
-	Animator::animationStep* step0 = new Animator::animationStep;
-	step0->arrayIndex 		= new int16_t[1] 								{BOTTOM_LEFT_SEGMENT};
-	step0->animationEffects = new AnimatableObject::AnimationFunction[1] 	{AnimationEffects::AnimateInToTop};
-	step0->easingEffects 	= new EasingBase*[LENGTH] 						{bounceEaseOut};
-
-	LinkedList<Animator::animationStep*>* AnimationStepSequence = new LinkedList<Animator::animationStep*>();
-	AnimationStepSequence->add(step0);
-
-	Animator::ComplexAmination* animation = new Animator::ComplexAmination();
-	animation->animationComplexity 	= LENGTH;
-	animation->LengthPerAnimation 	= totalAnimationLength / (AnimationStepSequence->size() + 1); //+1 because I have to account for the last animation also taking time.
-	animation->animations 			= AnimationStepSequence;
-	return animation;
-}
-
-Animator::ComplexAmination* InitAnimate5to0(uint16_t totalAnimationLength)
-{
-	#undef LENGTH
-	#define LENGTH	3
-	Animator::animationStep* step0 = new Animator::animationStep;
-	step0->arrayIndex 		= new int16_t[LENGTH] 								{CENTER_SEGMENT, 						BOTTOM_LEFT_SEGMENT, 					TOP_RIGHT_SEGMENT};
-	step0->animationEffects = new AnimatableObject::AnimationFunction[LENGTH] 	{AnimationEffects::AnimateOutToRight, 	AnimationEffects::AnimateInToBottom, 	AnimationEffects::AnimateInToTop};
-	step0->easingEffects 	= new EasingBase*[LENGTH] 							{bounceEaseOut, 						bounceEaseOut,							bounceEaseOut};
-
-	LinkedList<Animator::animationStep*>* AnimationStepSequence = new LinkedList<Animator::animationStep*>();
-	AnimationStepSequence->add(step0);
-
-	Animator::ComplexAmination* animation = new Animator::ComplexAmination();
-	animation->animationComplexity 	= LENGTH;
-	animation->LengthPerAnimation 	= totalAnimationLength / (AnimationStepSequence->size() + 1); //+1 because I have to account for the last animation also taking time.
-	animation->animations 			= AnimationStepSequence;
-	return animation;
-}
-
-Animator::ComplexAmination* InitAnimate6to7(uint16_t totalAnimationLength)
-{
-	#undef LENGTH
-	#define LENGTH	3
-	Animator::animationStep* step0 = new Animator::animationStep;
-	step0->arrayIndex 		= new int16_t[LENGTH] 								{TOP_LEFT_SEGMENT, 						CENTER_SEGMENT, 						TOP_RIGHT_SEGMENT};
-	step0->animationEffects = new AnimatableObject::AnimationFunction[LENGTH] 	{AnimationEffects::AnimateOutToTop, 	AnimationEffects::AnimateOutToLeft, 	AnimationEffects::AnimateInToBottom};
-	step0->easingEffects 	= new EasingBase*[LENGTH] 							{cubicEaseIn, 							cubicEaseIn,							cubicEaseOut};
-	Animator::animationStep* step1 = new Animator::animationStep;
-	step1->arrayIndex 		= new int16_t[LENGTH] 								{BOTTOM_LEFT_SEGMENT, 					NO_SEGMENTS, 							NO_SEGMENTS};
-	step1->animationEffects = new AnimatableObject::AnimationFunction[LENGTH] 	{AnimationEffects::AnimateOutToBottom, 	NO_ANIMATION, 							NO_ANIMATION};
-	step1->easingEffects 	= new EasingBase*[LENGTH] 							{NO_EASING, 							NO_EASING,								NO_EASING};
-	Animator::animationStep* step2 = new Animator::animationStep;
-	step2->arrayIndex 		= new int16_t[LENGTH] 								{BOTTOM_MIDDLE_SEGMENT, 				NO_SEGMENTS, 							NO_SEGMENTS};
-	step2->animationEffects = new AnimatableObject::AnimationFunction[LENGTH] 	{AnimationEffects::AnimateOutToRight, 	NO_ANIMATION, 							NO_ANIMATION};
-	step2->easingEffects 	= new EasingBase*[LENGTH] 							{cubicEaseOut, 							NO_EASING,								NO_EASING};
-
-	LinkedList<Animator::animationStep*>* AnimationStepSequence = new LinkedList<Animator::animationStep*>();
-	AnimationStepSequence->add(step0);
-	AnimationStepSequence->add(step1);
-	AnimationStepSequence->add(step2);
-
-	Animator::ComplexAmination* animation = new Animator::ComplexAmination();
-	animation->animationComplexity 	= LENGTH;
-	animation->LengthPerAnimation 	= totalAnimationLength / (AnimationStepSequence->size() + 1); //+1 because I have to account for the last animation also taking time.
-	animation->animations 			= AnimationStepSequence;
-	return animation;
-}
-
-Animator::ComplexAmination* InitAnimate7to8(uint16_t totalAnimationLength)
-{
-	#undef LENGTH
-	#define LENGTH	2
-	Animator::animationStep* step0 = new Animator::animationStep;
-	step0->arrayIndex 		= new int16_t[LENGTH] 								{TOP_LEFT_SEGMENT, 						BOTTOM_MIDDLE_SEGMENT};
-	step0->animationEffects = new AnimatableObject::AnimationFunction[LENGTH] 	{AnimationEffects::AnimateInToBottom, 	AnimationEffects::AnimateInToLeft};
-	step0->easingEffects 	= new EasingBase*[LENGTH] 							{cubicEaseIn, 							cubicEaseIn};
-
-	Animator::animationStep* step1 = new Animator::animationStep;
-	step1->arrayIndex 		= new int16_t[LENGTH] 								{BOTTOM_LEFT_SEGMENT, 					CENTER_SEGMENT};
-	step1->animationEffects = new AnimatableObject::AnimationFunction[LENGTH] 	{AnimationEffects::AnimateInToTop, 		AnimationEffects::AnimateInToRight};
-	step1->easingEffects 	= new EasingBase*[LENGTH] 							{cubicEaseOut, 							cubicEaseOut};
-
-	LinkedList<Animator::animationStep*>* AnimationStepSequence = new LinkedList<Animator::animationStep*>();
-	AnimationStepSequence->add(step0);
-	AnimationStepSequence->add(step1);
-
-	Animator::ComplexAmination* animation = new Animator::ComplexAmination();
-	animation->animationComplexity 	= LENGTH;
-	animation->LengthPerAnimation 	= totalAnimationLength / (AnimationStepSequence->size() + 1); //+1 because I have to account for the last animation also taking time.
-	animation->animations 			= AnimationStepSequence;
-	return animation;
-}
-
-Animator::ComplexAmination* InitAnimate8to9(uint16_t totalAnimationLength)
-{
-	#undef LENGTH
-	#define LENGTH	1
-	Animator::animationStep* step0 = new Animator::animationStep;
-	step0->arrayIndex 		= new int16_t[LENGTH] 								{BOTTOM_LEFT_SEGMENT};
-	step0->animationEffects = new AnimatableObject::AnimationFunction[LENGTH] 	{AnimationEffects::AnimateOutToBottom};
-	step0->easingEffects 	= new EasingBase*[LENGTH] 							{bounceEaseOut};
-
-	LinkedList<Animator::animationStep*>* AnimationStepSequence = new LinkedList<Animator::animationStep*>();
-	AnimationStepSequence->add(step0);
-
-	Animator::ComplexAmination* animation = new Animator::ComplexAmination();
-	animation->animationComplexity 	= LENGTH;
-	animation->LengthPerAnimation 	= totalAnimationLength / (AnimationStepSequence->size() + 1); //+1 because I have to account for the last animation also taking time.
-	animation->animations 			= AnimationStepSequence;
-	return animation;
-}
-
-Animator::ComplexAmination* InitAnimate9to0(uint16_t totalAnimationLength)
-{
-	#undef LENGTH
-	#define LENGTH	2
-	Animator::animationStep* step0 = new Animator::animationStep;
-	step0->arrayIndex 		= new int16_t[LENGTH] 								{CENTER_SEGMENT, 						BOTTOM_LEFT_SEGMENT};
-	step0->animationEffects = new AnimatableObject::AnimationFunction[LENGTH] 	{AnimationEffects::AnimateOutToLeft, 	AnimationEffects::AnimateInToBottom};
-	step0->easingEffects 	= new EasingBase*[LENGTH] 							{bounceEaseOut, 						bounceEaseOut};
-
-	LinkedList<Animator::animationStep*>* AnimationStepSequence = new LinkedList<Animator::animationStep*>();
-	AnimationStepSequence->add(step0);
-
-	Animator::ComplexAmination* animation = new Animator::ComplexAmination();
-	animation->animationComplexity 	= LENGTH;
-	animation->LengthPerAnimation 	= totalAnimationLength / (AnimationStepSequence->size() + 1); //+1 because I have to account for the last animation also taking time.
-	animation->animations 			= AnimationStepSequence;
-	return animation;
-}
-
-Animator::ComplexAmination* InitAnimate1toOFF(uint16_t totalAnimationLength)
-{
-	#undef LENGTH
-	#define LENGTH	2
-	Animator::animationStep* step0 = new Animator::animationStep;
-	step0->arrayIndex 		= new int16_t[LENGTH] 								{BOTTOM_RIGHT_SEGMENT, 					TOP_RIGHT_SEGMENT};
-	step0->animationEffects = new AnimatableObject::AnimationFunction[LENGTH] 	{AnimationEffects::AnimateOutToBottom, 	AnimationEffects::AnimateOutToTop};
-	step0->easingEffects 	= new EasingBase*[LENGTH] 							{cubicEaseInOut, 						cubicEaseInOut};
-
-	LinkedList<Animator::animationStep*>* AnimationStepSequence = new LinkedList<Animator::animationStep*>();
-	AnimationStepSequence->add(step0);
-
-	Animator::ComplexAmination* animation = new Animator::ComplexAmination();
-	animation->animationComplexity 	= LENGTH;
-	animation->LengthPerAnimation 	= totalAnimationLength / (AnimationStepSequence->size() + 1); //+1 because I have to account for the last animation also taking time.
-	animation->animations 			= AnimationStepSequence;
-	return animation;
-}
-
-Animator::ComplexAmination* InitAnimateOFFto1(uint16_t totalAnimationLength)
-{
-	#undef LENGTH
-	#define LENGTH	2
-	Animator::animationStep* step0 = new Animator::animationStep;
-	step0->arrayIndex 		= new int16_t[LENGTH] 								{TOP_RIGHT_SEGMENT, 				BOTTOM_RIGHT_SEGMENT};
-	step0->animationEffects = new AnimatableObject::AnimationFunction[LENGTH] 	{AnimationEffects::AnimateInToTop, 	AnimationEffects::AnimateInToBottom};
-	step0->easingEffects 	= new EasingBase*[LENGTH] 							{cubicEaseInOut, 					cubicEaseInOut};
-
-	LinkedList<Animator::animationStep*>* AnimationStepSequence = new LinkedList<Animator::animationStep*>();
-	AnimationStepSequence->add(step0);
-
-	Animator::ComplexAmination* animation = new Animator::ComplexAmination();
-	animation->animationComplexity 	= LENGTH;
-	animation->LengthPerAnimation 	= totalAnimationLength / (AnimationStepSequence->size() + 1); //+1 because I have to account for the last animation also taking time.
-	animation->animations 			= AnimationStepSequence;
-	return animation;
-}
-
-Animator::ComplexAmination* InitAnimate9to8(uint16_t totalAnimationLength)
-{
-	#undef LENGTH
-	#define LENGTH 1
-	Animator::animationStep* step0 = new Animator::animationStep;
-	step0->arrayIndex 		= new int16_t[LENGTH] 								{BOTTOM_LEFT_SEGMENT};
-	step0->animationEffects = new AnimatableObject::AnimationFunction[LENGTH] 	{AnimationEffects::AnimateInToTop};
-	step0->easingEffects 	= new EasingBase*[LENGTH] 							{bounceEaseOut};
-
-	LinkedList<Animator::animationStep*>* AnimationStepSequence = new LinkedList<Animator::animationStep*>();
-	AnimationStepSequence->add(step0);
-
-	Animator::ComplexAmination* animation = new Animator::ComplexAmination();
-	animation->animationComplexity 	= LENGTH;
-	animation->LengthPerAnimation 	= totalAnimationLength / (AnimationStepSequence->size() + 1); //+1 because I have to account for the last animation also taking time.
-	animation->animations 			= AnimationStepSequence;
-	return animation;
-}
-
-Animator::ComplexAmination* InitAnimate8to7(uint16_t totalAnimationLength)
-{
-	#undef LENGTH
-	#define LENGTH 3
-	Animator::animationStep* step0 = new Animator::animationStep;
-	step0->arrayIndex 		= new int16_t[LENGTH] 								{TOP_LEFT_SEGMENT, 						CENTER_SEGMENT, 						BOTTOM_LEFT_SEGMENT};
-	step0->animationEffects = new AnimatableObject::AnimationFunction[LENGTH] 	{AnimationEffects::AnimateOutToTop, 	AnimationEffects::AnimateOutToRight, 	AnimationEffects::AnimateOutToBottom};
-	step0->easingEffects 	= new EasingBase*[LENGTH] 							{cubicEaseIn, 							cubicEaseIn, 							cubicEaseIn};
-	Animator::animationStep* step1 = new Animator::animationStep;
-	step1->arrayIndex 		= new int16_t[LENGTH] 								{BOTTOM_MIDDLE_SEGMENT, 				NO_SEGMENTS, 							NO_SEGMENTS};
-	step1->animationEffects = new AnimatableObject::AnimationFunction[LENGTH] 	{AnimationEffects::AnimateOutToRight, 	NO_ANIMATION, 							NO_ANIMATION};
-	step1->easingEffects 	= new EasingBase*[LENGTH] 							{cubicEaseOut, 							cubicEaseOut, 							NO_EASING};
-
-	LinkedList<Animator::animationStep*>* AnimationStepSequence = new LinkedList<Animator::animationStep*>();
-	AnimationStepSequence->add(step0);
-	AnimationStepSequence->add(step1);
-
-	Animator::ComplexAmination* animation = new Animator::ComplexAmination();
-	animation->animationComplexity 	= LENGTH;
-	animation->LengthPerAnimation 	= totalAnimationLength / (AnimationStepSequence->size() + 1); //+1 because I have to account for the last animation also taking time.
-	animation->animations 			= AnimationStepSequence;
-	return animation;
-}
-
-Animator::ComplexAmination* InitAnimate7to6(uint16_t totalAnimationLength)
-{
-	#undef LENGTH
-	#define LENGTH 3
-	Animator::animationStep* step0 = new Animator::animationStep;
-	step0->arrayIndex 		= new int16_t[LENGTH] 								{TOP_RIGHT_SEGMENT, 					TOP_LEFT_SEGMENT, 						BOTTOM_MIDDLE_SEGMENT};
-	step0->animationEffects = new AnimatableObject::AnimationFunction[LENGTH] 	{AnimationEffects::AnimateOutToTop, 	AnimationEffects::AnimateInToBottom, 	AnimationEffects::AnimateInToLeft};
-	step0->easingEffects 	= new EasingBase*[LENGTH] 							{cubicEaseIn, 							cubicEaseIn, 							cubicEaseIn};
-	Animator::animationStep* step1 = new Animator::animationStep;
-	step1->arrayIndex 		= new int16_t[LENGTH] 								{CENTER_SEGMENT, 						BOTTOM_LEFT_SEGMENT, 					NO_SEGMENTS};
-	step1->animationEffects = new AnimatableObject::AnimationFunction[LENGTH] 	{AnimationEffects::AnimateInToRight, 	AnimationEffects::AnimateInToTop, 		NO_ANIMATION};
-	step1->easingEffects 	= new EasingBase*[LENGTH] 							{cubicEaseOut, 							cubicEaseOut, 							NO_EASING};
-
-	LinkedList<Animator::animationStep*>* AnimationStepSequence = new LinkedList<Animator::animationStep*>();
-	AnimationStepSequence->add(step0);
-	AnimationStepSequence->add(step1);
-
-	Animator::ComplexAmination* animation = new Animator::ComplexAmination();
-	animation->animationComplexity 	= LENGTH;
-	animation->LengthPerAnimation 	= totalAnimationLength / (AnimationStepSequence->size() + 1); //+1 because I have to account for the last animation also taking time.
-	animation->animations 			= AnimationStepSequence;
-	return animation;
-}
-
-Animator::ComplexAmination* InitAnimate6to5(uint16_t totalAnimationLength)
-{
-	#undef LENGTH
-	#define LENGTH 1
-	Animator::animationStep* step0 = new Animator::animationStep;
-	step0->arrayIndex 		= new int16_t[LENGTH] 								{BOTTOM_LEFT_SEGMENT};
-	step0->animationEffects = new AnimatableObject::AnimationFunction[LENGTH] 	{AnimationEffects::AnimateOutToBottom};
-	step0->easingEffects 	= new EasingBase*[LENGTH] 							{bounceEaseOut};
-
-	LinkedList<Animator::animationStep*>* AnimationStepSequence = new LinkedList<Animator::animationStep*>();
-	AnimationStepSequence->add(step0);
-
-	Animator::ComplexAmination* animation = new Animator::ComplexAmination();
-	animation->animationComplexity 	= LENGTH;
-	animation->LengthPerAnimation 	= totalAnimationLength / (AnimationStepSequence->size() + 1); //+1 because I have to account for the last animation also taking time.
-	animation->animations 			= AnimationStepSequence;
-	return animation;
-}
-
-Animator::ComplexAmination* InitAnimate5to4(uint16_t totalAnimationLength)
-{
-	#undef LENGTH
-	#define LENGTH 3
-	Animator::animationStep* step0 = new Animator::animationStep;
-	step0->arrayIndex 		= new int16_t[LENGTH] 								{TOP_MIDDLE_SEGMENT, 					TOP_RIGHT_SEGMENT, 						BOTTOM_MIDDLE_SEGMENT};
-	step0->animationEffects = new AnimatableObject::AnimationFunction[LENGTH] 	{AnimationEffects::AnimateOutToRight, 	AnimationEffects::AnimateInToBottom,	AnimationEffects::AnimateOutToRight};
-	step0->easingEffects 	= new EasingBase*[LENGTH] 							{bounceEaseOut, 						bounceEaseOut, 							bounceEaseOut};
-
-	LinkedList<Animator::animationStep*>* AnimationStepSequence = new LinkedList<Animator::animationStep*>();
-	AnimationStepSequence->add(step0);
-
-	Animator::ComplexAmination* animation = new Animator::ComplexAmination();
-	animation->animationComplexity 	= LENGTH;
-	animation->LengthPerAnimation 	= totalAnimationLength / (AnimationStepSequence->size() + 1); //+1 because I have to account for the last animation also taking time.
-	animation->animations 			= AnimationStepSequence;
-	return animation;
-}
-
-Animator::ComplexAmination* InitAnimate4to3(uint16_t totalAnimationLength)
-{
-	#undef LENGTH
-	#define LENGTH 3
-	Animator::animationStep* step0 = new Animator::animationStep;
-	step0->arrayIndex 		= new int16_t[LENGTH] 								{TOP_LEFT_SEGMENT, 						TOP_MIDDLE_SEGMENT, 				BOTTOM_MIDDLE_SEGMENT};
-	step0->animationEffects = new AnimatableObject::AnimationFunction[LENGTH] 	{AnimationEffects::AnimateOutToTop, 	AnimationEffects::AnimateInToRight,	AnimationEffects::AnimateInToLeft};
-	step0->easingEffects 	= new EasingBase*[LENGTH] 							{bounceEaseOut, 						bounceEaseOut, 						bounceEaseOut};
-
-	LinkedList<Animator::animationStep*>* AnimationStepSequence = new LinkedList<Animator::animationStep*>();
-	AnimationStepSequence->add(step0);
-
-	Animator::ComplexAmination* animation = new Animator::ComplexAmination();
-	animation->animationComplexity 	= LENGTH;
-	animation->LengthPerAnimation 	= totalAnimationLength / (AnimationStepSequence->size() + 1); //+1 because I have to account for the last animation also taking time.
-	animation->animations 			= AnimationStepSequence;
-	return animation;
-}
-
-Animator::ComplexAmination* InitAnimate3to2(uint16_t totalAnimationLength)
-{
-	#undef LENGTH
-	#define LENGTH 2
-	Animator::animationStep* step0 = new Animator::animationStep;
-	step0->arrayIndex 		= new int16_t[LENGTH] 								{BOTTOM_RIGHT_SEGMENT, 					BOTTOM_LEFT_SEGMENT};
-	step0->animationEffects = new AnimatableObject::AnimationFunction[LENGTH] 	{AnimationEffects::AnimateOutToBottom, 	AnimationEffects::AnimateInToTop};
-	step0->easingEffects 	= new EasingBase*[LENGTH] 							{bounceEaseOut, 						bounceEaseOut};
-
-	LinkedList<Animator::animationStep*>* AnimationStepSequence = new LinkedList<Animator::animationStep*>();
-	AnimationStepSequence->add(step0);
-
-	Animator::ComplexAmination* animation = new Animator::ComplexAmination();
-	animation->animationComplexity 	= LENGTH;
-	animation->LengthPerAnimation 	= totalAnimationLength / (AnimationStepSequence->size() + 1); //+1 because I have to account for the last animation also taking time.
-	animation->animations 			= AnimationStepSequence;
-	return animation;
-}
-
-Animator::ComplexAmination* InitAnimate2to1(uint16_t totalAnimationLength)
-{
-	#undef LENGTH
-	#define LENGTH 2
-	Animator::animationStep* step0 = new Animator::animationStep;
-	step0->arrayIndex 		= new int16_t[LENGTH] 								{TOP_MIDDLE_SEGMENT, 					CENTER_SEGMENT};
-	step0->animationEffects = new AnimatableObject::AnimationFunction[LENGTH] 	{AnimationEffects::AnimateOutToRight, 	AnimationEffects::AnimateOutToLeft};
-	step0->easingEffects 	= new EasingBase*[LENGTH] 							{cubicEaseInOut, 						cubicEaseIn};
-	Animator::animationStep* step1 = new Animator::animationStep;
-	step1->arrayIndex 		= new int16_t[LENGTH] 								{BOTTOM_LEFT_SEGMENT, 					NO_SEGMENTS};
-	step1->animationEffects = new AnimatableObject::AnimationFunction[LENGTH] 	{AnimationEffects::AnimateOutToBottom, 	NO_ANIMATION};
-	step1->easingEffects 	= new EasingBase*[LENGTH] 							{NO_EASING, 							NO_EASING};
-	Animator::animationStep* step2 = new Animator::animationStep;
-	step2->arrayIndex 		= new int16_t[LENGTH] 								{BOTTOM_RIGHT_SEGMENT, 					BOTTOM_MIDDLE_SEGMENT};
-	step2->animationEffects = new AnimatableObject::AnimationFunction[LENGTH] 	{AnimationEffects::AnimateInToTop, 		AnimationEffects::AnimateOutToRight};
-	step2->easingEffects 	= new EasingBase*[LENGTH] 							{NO_EASING, 							NO_EASING};
-
-	LinkedList<Animator::animationStep*>* AnimationStepSequence = new LinkedList<Animator::animationStep*>();
-	AnimationStepSequence->add(step0);
-	AnimationStepSequence->add(step1);
-	AnimationStepSequence->add(step2);
-
-	Animator::ComplexAmination* animation = new Animator::ComplexAmination();
-	animation->animationComplexity 	= LENGTH;
-	animation->LengthPerAnimation 	= totalAnimationLength / (AnimationStepSequence->size() + 1); //+1 because I have to account for the last animation also taking time.
-	animation->animations 			= AnimationStepSequence;
-	return animation;
-}
-
-Animator::ComplexAmination* InitAnimate1to0(uint16_t totalAnimationLength)
-{
-	#undef LENGTH
-	#define LENGTH 2
-	Animator::animationStep* step0 = new Animator::animationStep;
-	step0->arrayIndex 		= new int16_t[LENGTH] 								{TOP_MIDDLE_SEGMENT, 					BOTTOM_MIDDLE_SEGMENT};
-	step0->animationEffects = new AnimatableObject::AnimationFunction[LENGTH] 	{AnimationEffects::AnimateInToLeft, 	AnimationEffects::AnimateInToLeft};
-	step0->easingEffects 	= new EasingBase*[LENGTH] 							{cubicEaseIn, 							cubicEaseIn};
-	Animator::animationStep* step1 = new Animator::animationStep;
-	step1->arrayIndex 		= new int16_t[LENGTH] 								{BOTTOM_LEFT_SEGMENT, 					TOP_LEFT_SEGMENT};
-	step1->animationEffects = new AnimatableObject::AnimationFunction[LENGTH] 	{AnimationEffects::AnimateInToTop, 		AnimationEffects::AnimateInToBottom};
-	step1->easingEffects 	= new EasingBase*[LENGTH] 							{bounceEaseOut, 						bounceEaseOut};
-
-	LinkedList<Animator::animationStep*>* AnimationStepSequence = new LinkedList<Animator::animationStep*>();
-	AnimationStepSequence->add(step0);
-	AnimationStepSequence->add(step1);
-
-	Animator::ComplexAmination* animation = new Animator::ComplexAmination();
-	animation->animationComplexity 	= LENGTH;
-	animation->LengthPerAnimation 	= totalAnimationLength / (AnimationStepSequence->size() + 1); //+1 because I have to account for the last animation also taking time.
-	animation->animations 			= AnimationStepSequence;
-	return animation;
-}
-
-Animator::ComplexAmination* InitAnimate0to9(uint16_t totalAnimationLength)
-{
-	#undef LENGTH
-	#define LENGTH 2
-	Animator::animationStep* step0 = new Animator::animationStep;
-	step0->arrayIndex 		= new int16_t[LENGTH] 								{BOTTOM_LEFT_SEGMENT, 					CENTER_SEGMENT};
-	step0->animationEffects = new AnimatableObject::AnimationFunction[LENGTH] 	{AnimationEffects::AnimateOutToTop, 	AnimationEffects::AnimateInToRight};
-	step0->easingEffects 	= new EasingBase*[LENGTH] 							{bounceEaseOut, 						bounceEaseOut};
-
-	LinkedList<Animator::animationStep*>* AnimationStepSequence = new LinkedList<Animator::animationStep*>();
-	AnimationStepSequence->add(step0);
-
-	Animator::ComplexAmination* animation = new Animator::ComplexAmination();
-	animation->animationComplexity 	= LENGTH;
-	animation->LengthPerAnimation 	= totalAnimationLength / (AnimationStepSequence->size() + 1); //+1 because I have to account for the last animation also taking time.
-	animation->animations 			= AnimationStepSequence;
-	return animation;
-}
-
-Animator::ComplexAmination* InitAnimate0to5(uint16_t totalAnimationLength)
-{
-	#undef LENGTH
-	#define LENGTH 3
-	Animator::animationStep* step0 = new Animator::animationStep;
-	step0->arrayIndex 		= new int16_t[LENGTH] 								{TOP_RIGHT_SEGMENT, 					CENTER_SEGMENT, 					BOTTOM_LEFT_SEGMENT};
-	step0->animationEffects = new AnimatableObject::AnimationFunction[LENGTH] 	{AnimationEffects::AnimateOutToBottom, 	AnimationEffects::AnimateInToLeft, 	AnimationEffects::AnimateOutToBottom};
-	step0->easingEffects 	= new EasingBase*[LENGTH] 							{cubicEaseInOut, 						cubicEaseInOut, 					cubicEaseInOut};
-
-	LinkedList<Animator::animationStep*>* AnimationStepSequence = new LinkedList<Animator::animationStep*>();
-	AnimationStepSequence->add(step0);
-
-	Animator::ComplexAmination* animation = new Animator::ComplexAmination();
-	animation->animationComplexity 	= LENGTH;
-	animation->LengthPerAnimation 	= totalAnimationLength / (AnimationStepSequence->size() + 1); //+1 because I have to account for the last animation also taking time.
-	animation->animations 			= AnimationStepSequence;
-	return animation;
-}
\ No newline at end of file
+const Animator::ComplexAmination* const TransformationLookupTable[11][11] = {
+		  //To:0                    1                    2                    3                    4                    5                    6                    7                    8                    9                    OFF
+/*from 0	*/{nullptr            , &Animate0to1       , SYNTHESIZED(0, 2)  , SYNTHESIZED(0, 3)  , SYNTHESIZED(0, 4)  , &Animate0to5       , SYNTHESIZED(0, 6)  , SYNTHESIZED(0, 7)  , SYNTHESIZED(0, 8)  , &Animate0to9       , SYNTHESIZED(0, 10)},
+/*from 1	*/{&Animate1to0       , nullptr            , &Animate1to2       , SYNTHESIZED(1, 3)  , SYNTHESIZED(1, 4)  , SYNTHESIZED(1, 5)  , SYNTHESIZED(1, 6)  , SYNTHESIZED(1, 7)  , SYNTHESIZED(1, 8)  , SYNTHESIZED(1, 9)  , &Animate1toOFF},
+/*from 2	*/{&Animate2to0       , &Animate2to1       , nullptr            , &Animate2to3       , SYNTHESIZED(2, 4)  , SYNTHESIZED(2, 5)  , SYNTHESIZED(2, 6)  , SYNTHESIZED(2, 7)  , SYNTHESIZED(2, 8)  , SYNTHESIZED(2, 9)  , SYNTHESIZED(2, 10)},
+/*from 3	*/{SYNTHESIZED(3, 0)  , SYNTHESIZED(3, 1)  , &Animate3to2       , nullptr            , &Animate3to4       , SYNTHESIZED(3, 5)  , SYNTHESIZED(3, 6)  , SYNTHESIZED(3, 7)  , SYNTHESIZED(3, 8)  , SYNTHESIZED(3, 9)  , SYNTHESIZED(3, 10)},
+/*from 4	*/{SYNTHESIZED(4, 0)  , SYNTHESIZED(4, 1)  , SYNTHESIZED(4, 2)  , &Animate4to3       , nullptr            , &Animate4to5       , SYNTHESIZED(4, 6)  , SYNTHESIZED(4, 7)  , SYNTHESIZED(4, 8)  , SYNTHESIZED(4, 9)  , SYNTHESIZED(4, 10)},
+/*from 5	*/{&Animate5to0       , SYNTHESIZED(5, 1)  , SYNTHESIZED(5, 2)  , SYNTHESIZED(5, 3)  , &Animate5to4       , nullptr            , &Animate5to6       , SYNTHESIZED(5, 7)  , SYNTHESIZED(5, 8)  , SYNTHESIZED(5, 9)  , SYNTHESIZED(5, 10)},
+/*from 6	*/{SYNTHESIZED(6, 0)  , SYNTHESIZED(6, 1)  , SYNTHESIZED(6, 2)  , SYNTHESIZED(6, 3)  , SYNTHESIZED(6, 4)  , &Animate6to5       , nullptr            , &Animate6to7       , SYNTHESIZED(6, 8)  , SYNTHESIZED(6, 9)  , SYNTHESIZED(6, 10)},
+/*from 7	*/{SYNTHESIZED(7, 0)  , SYNTHESIZED(7, 1)  , SYNTHESIZED(7, 2)  , SYNTHESIZED(7, 3)  , SYNTHESIZED(7, 4)  , SYNTHESIZED(7, 5)  , &Animate7to6       , nullptr            , &Animate7to8       , SYNTHESIZED(7, 9)  , SYNTHESIZED(7, 10)},
+/*from 8	*/{SYNTHESIZED(8, 0)  , SYNTHESIZED(8, 1)  , SYNTHESIZED(8, 2)  , SYNTHESIZED(8, 3)  , SYNTHESIZED(8, 4)  , SYNTHESIZED(8, 5)  , SYNTHESIZED(8, 6)  , &Animate8to7       , nullptr            , &Animate8to9       , SYNTHESIZED(8, 10)},
+/*from 9	*/{&Animate9to0       , SYNTHESIZED(9, 1)  , SYNTHESIZED(9, 2)  , SYNTHESIZED(9, 3)  , SYNTHESIZED(9, 4)  , SYNTHESIZED(9, 5)  , SYNTHESIZED(9, 6)  , SYNTHESIZED(9, 7)  , &Animate9to8       , nullptr            , SYNTHESIZED(9, 10)},
+/*from OFF	*/{SYNTHESIZED(10, 0) , &AnimateOFFto1     , SYNTHESIZED(10, 2) , SYNTHESIZED(10, 3) , SYNTHESIZED(10, 4) , SYNTHESIZED(10, 5) , SYNTHESIZED(10, 6) , SYNTHESIZED(10, 7) , SYNTHESIZED(10, 8) , SYNTHESIZED(10, 9) , nullptr}
+};
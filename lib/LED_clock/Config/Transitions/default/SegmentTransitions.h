@@ -2,7 +2,7 @@
  * \file SegmentTransitions.h
  * \author Florian Laschober
  * \brief The default set of animations
- *        A good set of animation for a decent amount of scenarios. But not all cases are covered by it.
+ *        Hand written transitions for the most common digit changes, every other pair of digits uses a transition generated by the #TransitionSynthesizer.
  */
 
 #ifndef __SEGMENT_TRANSITIONS_H_
@@ -14,38 +14,55 @@
  * \brief Lookup table to know which animation to call for which transition
  *
  */
-extern Animator::ComplexAmination* TransformationLookupTable[11][11];
+extern const Animator::ComplexAmination* const TransformationLookupTable[11][11];
+
+/**
+ * \brief Easing of the blend that redirects a digit whose transition is still running, see #SevenSegment::DisplayNumber
+ */
+extern const EasingBase* const RetargetEasing;
+
+/**
+ * \brief Easing of the crossfade when the color of the segments or the downlights changes, see #COLOR_FADE_DURATION.
+ * 		  Has to start fast, a dragged color slider restarts the fade on every change.
+ */
+extern const EasingBase* const ColorFadeEasing;
+
+/**
+ * \brief Easing of a brightness channel moving to a new level, see #CHANNEL_BRIGHTNESS_INTERPOLATION.
+ * 		  Starts fast for the same reason as #ColorFadeEasing.
+ */
+extern const EasingBase* const BrightnessEasing;
 
 /**
  * \brief All avaliable animations to morph between digits
  * \addtogroup DigitMorphAnimations
  * \{
  */
-extern Animator::ComplexAmination* Animate0to1;
-extern Animator::ComplexAmination* Animate1to2;
-extern Animator::ComplexAmination* Animate2to3;
-extern Animator::ComplexAmination* Animate3to4;
-extern Animator::ComplexAmination* Animate2to0;
-extern Animator::ComplexAmination* Animate4to5;
-extern Animator::ComplexAmination* Animate5to6;
-extern Animator::ComplexAmination* Animate5to0;
-extern Animator::ComplexAmination* Animate6to7;
-extern Animator::ComplexAmination* Animate7to8;
-extern Animator::ComplexAmination* Animate8to9;
-extern Animator::ComplexAmination* Animate9to0;
-extern Animator::ComplexAmination* AnimateOFFto1;
-extern Animator::ComplexAmination* Animate1toOFF;
-extern Animator::ComplexAmination* Animate9to8;
-extern Animator::ComplexAmination* Animate8to7;
-extern Animator::ComplexAmination* Animate7to6;
-extern Animator::ComplexAmination* Animate6to5;
-extern Animator::ComplexAmination* Animate5to4;
-extern Animator::ComplexAmination* Animate4to3;
-extern Animator::ComplexAmination* Animate3to2;
-extern Animator::ComplexAmination* Animate2to1;
-extern Animator::ComplexAmination* Animate1to0;
-extern Animator::ComplexAmination* Animate0to9;
-extern Animator::ComplexAmination* Animate0to5;
+extern const Animator::ComplexAmination Animate0to1;
+extern const Animator::ComplexAmination Animate1to2;
+extern const Animator::ComplexAmination Animate2to3;
+extern const Animator::ComplexAmination Animate3to4;
+extern const Animator::ComplexAmination Animate2to0;
+extern const Animator::ComplexAmination Animate4to5;
+extern const Animator::ComplexAmination Animate5to6;
+extern const Animator::ComplexAmination Animate5to0;
+extern const Animator::ComplexAmination Animate6to7;
+extern const Animator::ComplexAmination Animate7to8;
+extern const Animator::ComplexAmination Animate8to9;
+extern const Animator::ComplexAmination Animate9to0;
+extern const Animator::ComplexAmination AnimateOFFto1;
+extern const Animator::ComplexAmination Animate1toOFF;
+extern const Animator::ComplexAmination Animate9to8;
+extern const Animator::ComplexAmination Animate8to7;
+extern const Animator::ComplexAmination Animate7to6;
+extern const Animator::ComplexAmination Animate6to5;
+extern const Animator::ComplexAmination Animate5to4;
+extern const Animator::ComplexAmination Animate4to3;
+extern const Animator::ComplexAmination Animate3to2;
+extern const Animator::ComplexAmination Animate2to1;
+extern const Animator::ComplexAmination Animate1to0;
+extern const Animator::ComplexAmination Animate0to9;
+extern const Animator::ComplexAmination Animate0to5;
 
 /** \} */
 #endif
\ No newline at end of file
@@ -30,6 +30,16 @@
  */
 #define NO_ANIMATION	0
 
+/**
+ * \brief Progress of an animation that has finished, #AnimatableObject::AnimationProgress is a signed Q16.16 fixed point number
+ */
+#define ANIMATION_PROGRESS_ONE	EASING_FIXED_ONE
+
+/**
+ * \brief Passed as state to #AnimatableObject::handle and #Animator::handle to let the animations run by the time instead of setting an exact state
+ */
+#define ANIMATOR_NO_STATE		UINT32_MAX
+
 class Animator;
 class Segment;
 
@@ -44,10 +54,16 @@ public:
 	 */
 	typedef void AnimationCallBack(void);
 
+	/**
+	 * \brief Progress of an animation as signed Q16.16 fixed point number. 0 is the start and #ANIMATION_PROGRESS_ONE the end of the animation.
+	 * 		  Easings can undershoot below 0 and overshoot above #ANIMATION_PROGRESS_ONE.
+	 */
+	typedef int32_t AnimationProgress;
+
 	/**
 	 * \brief Typedef for animation effect functions. These should be implemented explicitly for every object that inherits from #AnimatableObject
 	 */
-    typedef void (*AnimationFunction)(CRGB* leds, uint16_t length, CRGB animationColor, uint16_t totalSteps, int32_t currentStep, bool invert);
+    typedef void (*AnimationFunction)(CRGB* leds, uint16_t length, CRGB animationColor, AnimationProgress progress, bool invert);
 private:
     friend class Animator;
     friend class Segment;
@@ -55,14 +71,15 @@ private:
 	typedef void (Animator::*ComplexAnimationCallBack)(AnimatableObject * sourceObject);
 
     AnimationFunction effect;
-	EasingBase* easing;
-	uint16_t AnimationDuration;
-	uint64_t AnimationStartTimestamp;
-	uint16_t currentAnimationTime;
-	double tickLength;
+	const EasingBase* easing;
+	uint32_t AnimationDuration;
+	uint32_t AnimationStartTimestamp;
+	uint32_t currentAnimationTime;
+	uint64_t progressScale;
 	uint16_t fps;
-	uint16_t numStates;
-	uint16_t oldState;
+	uint32_t tickInterval;
+	uint32_t lastTickTime; // slot of the last tick on the grid of tickInterval, can be slightly ahead of the frame that ticked
+	AnimationProgress oldProgress;
 	bool animationStarted;
 	void* complexAnimationInst;
 
@@ -71,6 +88,8 @@ private:
 	Animator* ComplexAnimationManager;
 	ComplexAnimationCallBack ComplexAnimStartCallback;
 	ComplexAnimationCallBack ComplexAnimDoneCallback;
+	Animator* scheduler;
+	int16_t schedulerSlot;
 
 	/**
 	 * \brief Gets called by #AnimatableObject::handle when the animation is finished.
@@ -78,42 +97,44 @@ private:
 	void done();
 
 	/**
-	 * \brief Gets the current state of the animation including all easings that might affect it.
+	 * \brief Gets the current progress of the animation including all easings that might affect it.
 	 *
-	 * \return int32_t the current state of the animation. Can also be negative in case of an easing that undershoots
+	 * \return AnimationProgress the current progress of the animation. Can also be negative in case of an easing that undershoots
 	 */
-	int32_t getState();
+	AnimationProgress getProgress();
 
 	/**
-	 * \brief setting the animation to the state passed as a parameter
+	 * \brief setting the animation to the progress passed as a parameter
 	 *
-	 * \param currentState "progress" of the current animation that is being displayed
+	 * \param progress progress of the current animation that is being displayed
 	 */
-	virtual void tick(int32_t currentState);
+	virtual void tick(AnimationProgress progress);
 
 protected:
 	AnimatableObject();
-	AnimatableObject(uint16_t OverallDuration, uint16_t steps);
+	AnimatableObject(uint32_t OverallDuration, uint16_t steps);
 	~AnimatableObject();
 
 	/**
-	 * \brief Set the overall duration of any animation called on this object
+	 * \brief Set the overall duration of any animation called on this object.
+	 * 		  Internally the animation runs on a microsecond timeline, so durations up to ~71 minutes are possible.
 	 *
 	 * \param duration animation duration in ms
 	 */
-	void setAnimationDuration(uint16_t duration);
+	void setAnimationDuration(uint32_t duration);
 
 	/**
-	 * \brief Set the overall duration of any animation called on this object
+	 * \brief Get the overall duration of any animation called on this object
 	 *
-	 * \param duration animation duration in ms
+	 * \return uint32_t animation duration in ms
 	 */
-	uint16_t getAnimationDuration();
+	uint32_t getAnimationDuration();
 
 	/**
 	 * \brief Set the target Frames Per Second for any animation called on this object.
+	 * 		  The object is only ticked by the #Animator once 1/fps passed since its last tick.
 	 * \note  This does not guarantee that the animation is actually running on that refresh rate.
-	 * 	      If it is set too fast the system will run it at the maximum possible framerate instead.
+	 * 	      If it is set faster than the frame rate of the #Animator (#Animator::getFrameRate) it is ticked once every frame instead.
 	 *
 	 * \param setAnimationFps how often the animation should be updated on the actual LEDs in Frames/Second
 	 */
@@ -136,11 +157,12 @@ protected:
 	void reset();
 
 	/**
-	 * \brief Gets called by the #Animator #Animator::handle method when the animation is finished.
+	 * \brief Gets called by the #Animator once per frame while the animation is running.
 	 *
-	 * \param state if not -1 any animations currently running are going to be set to an exact state
+	 * \param frameTime time in µs at the start of the current frame, sampled once by the #Animator for all objects
+	 * \param state if not #ANIMATOR_NO_STATE any animations currently running are going to be set to an exact state, in ms since the start of the animation
 	 */
-	void handle(uint32_t state = -1);
+	void handle(uint32_t frameTime, uint32_t state = ANIMATOR_NO_STATE);
 
 	/**
 	 * \brief Set the animation effect to the current object
@@ -154,7 +176,7 @@ protected:
 	 *
 	 * \param easingEffect effect to apply to the animation as an additional "modifier"
 	 */
-	virtual void setAnimationEasing(EasingBase* easingEffect);
+	virtual void setAnimationEasing(const EasingBase* easingEffect);
 public:
 	/**
 	 * \brief Set a callback to be executued once an animation has finished running
@@ -12,10 +12,66 @@
 #define FASTLED_INTERNAL
 #include <FastLED.h>
 #include "AnimatableObject.h"
+#include "LEDOutput.h"
 #include "Configuration.h"
 
 class AnimatableObject;
 
+/**
+ * \brief Number of 32 bit words needed for the running bitmask of the #Animator
+ */
+#define ANIMATOR_RUNNING_WORDS	((ANIMATOR_MAX_OBJECTS + 31) / 32)
+
+/**
+ * \brief Returned instead of a #Animator::ComplexAnimationID if the animation could not be created
+ */
+#define INVALID_COMPLEX_ANIMATION_ID	UINT32_MAX
+
+/**
+ * \brief Shortest frame of the #Animator in µs, see #ANIMATION_MAX_FPS
+ */
+#define ANIMATOR_MIN_FRAME_PERIOD_US	(1000000UL / ANIMATION_MAX_FPS)
+
+/**
+ * \brief Margin in percent the frame period keeps above the time a frame takes to update and show, see #Animator::getFramePeriod
+ */
+#define ANIMATOR_FRAME_HEADROOM		25
+
+/**
+ * \brief How fast the measured update and show times follow a decrease. A longer time is taken over right away,
+ * 		  a shorter one only closes 1/ANIMATOR_TIMING_DECAY of the difference per frame
+ */
+#define ANIMATOR_TIMING_DECAY		16
+
+/**
+ * \brief Change of the frame rate in fps that is logged to the serial monitor
+ */
+#define ANIMATOR_FPS_REPORT_STEP	5
+
+/**
+ * \brief Range of the speed of complex animations in percent, see #Animator::setAnimationSpeed
+ */
+#define ANIMATOR_MIN_SPEED	10
+#define ANIMATOR_MAX_SPEED	1000
+
+/**
+ * \brief Number of steps of a complex animation definition called NAME, see #COMPLEX_ANIMATION
+ */
+#define COMPLEX_ANIMATION_STEPS(NAME)	(sizeof(NAME##Segments) / sizeof(NAME##Segments[0]))
+
+/**
+ * \brief Create a #Animator::ComplexAmination from the three constant tables NAME##Segments, NAME##Effects and NAME##Easings.
+ * 		  Each of them has one row per animation step and one column per animation that runs during the step.
+ */
+#define COMPLEX_ANIMATION(NAME, LENGTH_PER_ANIMATION)	{ \
+		sizeof(NAME##Segments[0]) / sizeof(NAME##Segments[0][0]), \
+		LENGTH_PER_ANIMATION, \
+		COMPLEX_ANIMATION_STEPS(NAME), \
+		&NAME##Segments[0][0], \
+		&NAME##Effects[0][0], \
+		&NAME##Easings[0][0] \
+	}
+
 /**
  * \brief The Animator class is responsible for handling all animations of objects that inherit from #AnimatableObject
  * 		  In the system there can be more than one Animator running at the same time.
@@ -24,55 +80,127 @@ class Animator
 {
 public:
 	/**
-	 * \brief Configuration structure used in the linked list to construct an animation chain
+	 * \brief Configuration structure for a complex animation. All steps are stored as one contiguous structure of arrays
+	 * 		  so the whole definition can be a constant table that lives in flash. Entry j of step i is located at
+	 * 		  index i * animationComplexity + j of each of the three arrays. Use #COMPLEX_ANIMATION to create one.
 	 *
-	 * \note All three lists have to have the same length. The length also must be consistent across all animation steps.
-	 * 		 If the system crashes when calling an animation it is most likeley due to missing arrays or missmatched array lengths.
+	 * \note All three arrays have to hold numSteps * animationComplexity elements.
+	 * 		 If the system crashes when calling an animation it is most likeley due to missmatched array lengths.
 	 *
+	 * \param animationComplexity Maximum of how many animations can be triggered at the same time
+	 * \param LengthPerAnimation How long one of the animations in the chain should last for at an animation speed of 100%.
+	 * 		  This is the normalized time base of the chain, the actual length is scaled when a step starts, see #Animator::setAnimationSpeed
+	 * \param numSteps Number of animation steps that shall be played in sequence
 	 * \param arrayIndex index of the array position where the objects that shall be animated is located. Set to -1 to ignore
-	 * \param animationEffects array of animation effects that shall be played back
-	 * \param easingEffects array of easing effect ("modifiers") that shall be applied to the animation
+	 * \param animationEffects animation effects that shall be played back
+	 * \param easingEffects easing effect ("modifiers") that shall be applied to the animation
 	 */
 	typedef struct {
-		int16_t* arrayIndex;
-		AnimatableObject::AnimationFunction* animationEffects;
-		EasingBase** easingEffects;
-	} animationStep;
+		uint8_t animationComplexity;
+		uint16_t LengthPerAnimation;
+		uint8_t numSteps;
+		const int16_t* arrayIndex;
+		const AnimatableObject::AnimationFunction* animationEffects;
+		const EasingBase* const* easingEffects;
+	} ComplexAmination;
 
 	/**
-	 * \brief Configuration structure for a complex animation
+	 * \brief Callback which is executed once a complex animation (or all of them) finished
 	 *
-	 * \note All list elements must have the same array length
+	 * \param context pointer that was passed when registering the callback
+	 */
+	typedef void (*CompletionCallback)(void* context);
+
+	/**
+	 * \brief Called once at the end of every frame after all running objects were updated, see #Animator::setRenderStage
 	 *
-	 * \param animationComplexity Maximum of how many animations can be triggered at the same time
-	 * \param LengthPerAnimation How long one of the animations in the chain should last for
-	 * \param animations list of animation steps that shall be played in sequence
+	 * \param context pointer that was passed when registering the render stage
 	 */
-	typedef struct {
-		uint8_t animationComplexity;
-		uint16_t LengthPerAnimation;
-		LinkedList<animationStep*>* animations;
-	} ComplexAmination;
+	typedef void (*RenderStage)(void* context);
+
+	/**
+	 * \brief Handle of a complex animation. Holds the slot in the instance pool of the #Animator and the generation of that slot,
+	 * 		  so a handle of an animation which finished in the meantime is detected instead of touching a reused slot.
+	 */
+	typedef uint32_t ComplexAnimationID;
+
+private:
+	friend class AnimatableObject;
 
 	struct ComplexAnimationInstance {
-		ComplexAmination* animation;
+		const ComplexAmination* animation;
 		bool loop;
 		uint16_t counter;
 		AnimatableObject** objects;
 		bool running;
+		bool played; // started by PlayComplexAnimation and owned by the Animator, instances from BuildComplexAnimation are owned by the caller
+		CompletionCallback onComplete;
+		void* onCompleteContext;
+		uint16_t generation;
+		bool inUse;
 	};
 
-private:
+	ComplexAnimationInstance complexAnimationPool[ANIMATOR_MAX_COMPLEX_ANIMATIONS];
+
 	static Animator* currentInstance;
-	LinkedList<AnimatableObject*> AnimatableObjects;
-	static unsigned long lastLEDUpdate;
+	AnimatableObject* AnimatableObjects[ANIMATOR_MAX_OBJECTS];
+	uint16_t numAnimatableObjects;
+	uint32_t runningObjects[ANIMATOR_RUNNING_WORDS];
+	FastLEDOutput fastLEDOutput;
+	LEDOutput* output;
+	uint8_t dirtyStrips;
+	uint32_t stripShowTime[ANIMATOR_MAX_LED_STRIPS]; // longest recent show that contained the strip in µs, see #Animator::trackTiming
+	uint32_t frameWorkTime; // longest recent time from the start of #Animator::update to the show of the frame in µs
+	bool frameUpdated; // set by #Animator::update, the next #Animator::showStrips measures the work of the frame
+	uint32_t framePeriod;
+	uint16_t reportedFrameRate;
+	uint32_t nextFrameTime;
+	uint32_t frameTime;
+	bool frameInProgress;
+	uint16_t runningComplexAnimations;
+	CompletionCallback onIdle;
+	void* onIdleContext;
+	RenderStage renderStage;
+	void* renderStageContext;
+	uint16_t speedPercent;
+	uint32_t durationScale;
+
+	/**
+	 * \brief Flips the running bit of an object. Called by #AnimatableObject::start and #AnimatableObject::stop
+	 *
+	 * \param slot index of the object in #Animator::AnimatableObjects
+	 * \param running true if the object has an animation running
+	 */
+	void setRunning(int16_t slot, bool running);
 
-	int16_t getIndexInList(AnimatableObject* object);
 	void animationIterationStartCallback(AnimatableObject* sourceObject);
 	void animationIterationDoneCallback(AnimatableObject* sourceObject);
 
 	void startAnimationStep(uint16_t stepindex, ComplexAnimationInstance* animationInst);
 
+	/**
+	 * \brief Drops all references to a complex animation, fires its completion callbacks and returns its slot to the pool
+	 */
+	void finishComplexAnimation(ComplexAnimationInstance* animationInst);
+
+	/**
+	 * \brief Look up the pool slot of a handle
+	 *
+	 * \return ComplexAnimationInstance* the instance or nullptr if the handle is invalid or the animation already finished
+	 */
+	ComplexAnimationInstance* getComplexAnimation(ComplexAnimationID animationID);
+	ComplexAnimationID getComplexAnimationID(ComplexAnimationInstance* animationInst);
+
+	/**
+	 * \brief Follow a measured duration: a longer one is taken over right away, a shorter one slowly, see #ANIMATOR_TIMING_DECAY
+	 */
+	static uint32_t trackTiming(uint32_t tracked, uint32_t measured);
+
+	/**
+	 * \brief Derive #Animator::framePeriod from the measured update and show times and the wire time of the strips
+	 */
+	void updateFramePeriod();
+
 	/**
 	 * \brief Construct a new Animator object
 	 */
@@ -91,6 +219,7 @@ public:
 
 	/**
 	 * \brief Add an animatable object to the Animator. The object is then updated by it.
+	 * \note At most #ANIMATOR_MAX_OBJECTS can be added, any further objects are rejected.
 	 *
 	 * \param animationToAdd Pointer to the object whose animations should be handled by this animator.
 	 */
@@ -106,11 +235,101 @@ public:
 	void remove(AnimatableObject* animationToRemove);
 
 	/**
-	 * \brief To be called periodically as fast as possible. Updates all animation states of all #AnimatableObjects assigned to this #Animator
+	 * \brief To be called periodically. Once per frame (#Animator::getFramePeriod) it updates the animation states of all #AnimatableObjects
+	 * 		  assigned to this #Animator which currently have an animation running and pushes the changed LED strips out.
+	 * 		  Calls in between frames return right away. Idle objects are not touched at all.
+	 *
+	 * \param state if not #ANIMATOR_NO_STATE any animations currently running are going to be set to an exact state, regardless of the frame timing
+	 */
+	void handle(uint32_t state = ANIMATOR_NO_STATE);
+
+	/**
+	 * \brief Update all running objects right away without pushing anything out to the LEDs and without looking at the frame timing.
+	 * 		  Used when the LED output is done by someone else, e.g. the render task of the #DisplayManager.
+	 * 		  The time is sampled once and passed to all objects. The time until the next #Animator::showStrips counts as the work of the frame.
+	 *
+	 * \param state if not #ANIMATOR_NO_STATE any animations currently running are going to be set to an exact state
+	 */
+	void update(uint32_t state = ANIMATOR_NO_STATE);
+
+	/**
+	 * \brief Register a stage that renders the work the objects queued during a frame in one pass.
+	 * 		  It is called at the end of #Animator::update, before the LEDs are pushed out.
+	 *
+	 * \param stage function to call, nullptr to remove it. Replaces any stage registered earlier
+	 * \param context passed to the stage
+	 */
+	void setRenderStage(RenderStage stage, void* context = nullptr);
+
+	/**
+	 * \brief Check if objects should queue their rendering for the render stage instead of writing the LEDs right away.
+	 * 		  This is the case while the objects are updated during a frame and a render stage is registered.
+	 */
+	bool isBatchingFrame();
+
+	/**
+	 * \brief Check if the next frame is due and if so schedule the one after it. Frames are spaced by exactly #Animator::getFramePeriod,
+	 * 		  if the caller fell behind by more than a frame the schedule restarts from now instead of trying to catch up.
+	 *
+	 * \return true if the caller should render a frame now
+	 */
+	bool frameDue();
+
+	/**
+	 * \brief Time until the next frame is due, use it to sleep instead of polling #Animator::handle
+	 *
+	 * \return uint32_t time in ms rounded up, 0 if a frame is due already
+	 */
+	uint32_t getTimeUntilNextFrame();
+
+	/**
+	 * \brief Length of one frame: the work of a frame plus the longer of the longest measured show of any strip and the wire time
+	 * 		  of all strips (#LEDOutput::getWireTime), with #ANIMATOR_FRAME_HEADROOM on top and at least #ANIMATOR_MIN_FRAME_PERIOD_US.
+	 * 		  The work of a frame is measured from the start of #Animator::update to #Animator::showStrips, so it includes everything
+	 * 		  the owner does in between, e.g. the brightness, the color fades and the compositor of the #DisplayManager.
+	 * 		  Short strips run faster, long ones never get a show before the last one is out.
+	 *
+	 * \return uint32_t period in µs
+	 */
+	uint32_t getFramePeriod();
+
+	/**
+	 * \brief Frame rate that follows from #Animator::getFramePeriod
+	 *
+	 * \return uint16_t frames per second
+	 */
+	uint16_t getFrameRate();
+
+	/**
+	 * \brief The time animations are based on: the time the current frame started while the objects are updated, otherwise micros()
+	 *
+	 * \return uint32_t time in µs
+	 */
+	uint32_t now();
+
+	/**
+	 * \brief Set how fast complex animations are played. Steps that are already running keep their length, all following steps use the new speed.
+	 * 		  Only a scale factor is changed, the animation definitions stay untouched.
+	 *
+	 * \param percent speed relative to the definition of the animations, 100 plays them as defined, 200 twice as fast
+	 * 				  \range #ANIMATOR_MIN_SPEED - #ANIMATOR_MAX_SPEED, values outside are clamped
+	 */
+	void setAnimationSpeed(uint16_t percent);
+
+	/**
+	 * \brief Get the speed of complex animations
 	 *
-	 * \param state if not -1 any animations currently running are going to be set to an exact state
+	 * \return uint16_t speed in percent, see #Animator::setAnimationSpeed
 	 */
-	void handle(uint32_t state = -1);
+	uint16_t getAnimationSpeed();
+
+	/**
+	 * \brief Scale a length given at a speed of 100% to the current speed of the complex animations
+	 *
+	 * \param duration length in ms at 100%
+	 * \return uint32_t length in ms at the current speed
+	 */
+	uint32_t getScaledDuration(uint32_t duration);
 
 	/**
 	 * \brief Setup all parameters for an animation of an object assigned to this #Animator but do not start it.
@@ -119,9 +338,9 @@ public:
 	 * \param animationEffect Animation effect that should be used next time an animation for this object is started.
 	 * \param duration Total duration of the animation effect once it is started.
 	 * \param easing [optional] default = #NO_EASING; Easing effect to apply "on top" of the animation
-	 * \param fps [optional] default = #ANIMATION_TARGET_FPS; Target FPS to run the animation at
+	 * \param fps [optional] default = #ANIMATION_MAX_FPS; Target FPS to run the animation at
 	 */
-	void setAnimation(AnimatableObject* object, AnimatableObject::AnimationFunction animationEffect, uint16_t duration, EasingBase* easing = NO_EASING, uint8_t fps = ANIMATION_TARGET_FPS);
+	void setAnimation(AnimatableObject* object, AnimatableObject::AnimationFunction animationEffect, uint32_t duration, const EasingBase* easing = NO_EASING, uint8_t fps = ANIMATION_MAX_FPS);
 
 	/**
 	 * \brief Setup all parameters for an animation of an object assigned to this #Animator and start it right away.
@@ -130,9 +349,9 @@ public:
 	 * \param animationEffect Animation effect that should be started
 	 * \param duration Total duration of the animation effect
 	 * \param easing [optional] default = #NO_EASING; Easing effect to apply "on top" of the animation
-	 * \param fps [optional] default = #ANIMATION_TARGET_FPS; Target FPS to run the animation at
+	 * \param fps [optional] default = #ANIMATION_MAX_FPS; Target FPS to run the animation at
 	 */
-	void startAnimation(AnimatableObject* object, AnimatableObject::AnimationFunction animationEffect, uint16_t duration, EasingBase* easing = NO_EASING, uint8_t fps = ANIMATION_TARGET_FPS);
+	void startAnimation(AnimatableObject* object, AnimatableObject::AnimationFunction animationEffect, uint32_t duration, const EasingBase* easing = NO_EASING, uint8_t fps = ANIMATION_MAX_FPS);
 
 	/**
 	 * \brief Setup the most important parameters for an animation of an object assigned to this #Animator and start it right away.
@@ -141,7 +360,7 @@ public:
 	 * \param animationEffect Animation effect that should be started
 	 * \param easing [optional] default = #NO_EASING; Easing effect to apply "on top" of the animation
 	 */
-	void startAnimation(AnimatableObject* object, AnimatableObject::AnimationFunction animationEffect, EasingBase* easing = NO_EASING);
+	void startAnimation(AnimatableObject* object, AnimatableObject::AnimationFunction animationEffect, const EasingBase* easing = NO_EASING);
 
 	/**
 	 * \brief Starts an animation which was previously setup
@@ -157,7 +376,7 @@ public:
 	 * \param object Object for which to set the suration for
 	 * \param duration Total animation duration in ms once it is started.
 	 */
-	void setAnimationDuration(AnimatableObject* object, uint16_t duration);
+	void setAnimationDuration(AnimatableObject* object, uint32_t duration);
 
 	/**
 	 * \brief Calls the #AnimatableObject::stop function on the given object.
@@ -187,10 +406,10 @@ public:
 	 * \param animation pointer to the animation that shall be played
 	 * \param animationObjectsArray Array of the objects that shall be animated. The indices for the array are defined in the animation itself
 	 * \param looping Whether the animation shall be looped or not
-	 * \return uint32_t The animation ID of the newly started animation
-	 * 					-1 which results to the max 32 bit value represents an error while starting the animation
+	 * \return ComplexAnimationID The animation ID of the newly started animation
+	 * 					#INVALID_COMPLEX_ANIMATION_ID represents an error while starting the animation or a full instance pool
 	 */
-	ComplexAnimationInstance* PlayComplexAnimation(ComplexAmination* animation, AnimatableObject* animationObjectsArray[], bool looping = false);
+	ComplexAnimationID PlayComplexAnimation(const ComplexAmination* animation, AnimatableObject* animationObjectsArray[], bool looping = false);
 
 	/**
 	 * \brief Builds a complex animation but does not start it.
@@ -198,40 +417,138 @@ public:
 	 * \param animation pointer to the animation that shall be played
 	 * \param animationObjectsArray Array of the objects that shall be animated. The indices for the array are defined in the animation itself
 	 * \param looping Whether the animation shall be looped or not
-	 * \return uint32_t The animation ID of the newly started animation
-	 * 					-1 which results to the max 32 bit value represents an error while starting the animation
+	 * \return ComplexAnimationID The animation ID of the new animation. It stays valid until it is passed to #Animator::releaseComplexAnimation
+	 * 					#INVALID_COMPLEX_ANIMATION_ID represents an error while building the animation or a full instance pool
 	 */
-	ComplexAnimationInstance* BuildComplexAnimation(ComplexAmination* animation, AnimatableObject* animationObjectsArray[], bool looping = false);
+	ComplexAnimationID BuildComplexAnimation(const ComplexAmination* animation, AnimatableObject* animationObjectsArray[], bool looping = false);
 
 	/**
 	 * \brief set a complex animation to a specific step and state
 	 *
-	 * \param animationInst animation to use, retrived by calling #Animator::BuildComplexAnimation
+	 * \param animationID animation to use, retrived by calling #Animator::BuildComplexAnimation
 	 * \param step Step of the complex animation which shall be executed
 	 * \param state state of the current step
 	 */
-	void setComplexAnimationStep(ComplexAnimationInstance* animationInst, uint8_t step, uint32_t state);
+	void setComplexAnimationStep(ComplexAnimationID animationID, uint8_t step, uint32_t state);
 
 	/**
 	 * \brief disables looping of the complex animation so that it sops running after the current cycle is done running
 	 *
 	 * \param animationID ID of the animation which shall be stopped
 	 */
-	void ComplexAnimationStopLooping(ComplexAnimationInstance* animationInst);
+	void ComplexAnimationStopLooping(ComplexAnimationID animationID);
 
 	/**
-	 * \brief Blocks exectution of further code until the currently running animation is complete
+	 * \brief disables looping of all complex animations started with #Animator::PlayComplexAnimation,
+	 * 		  so that each of them stops after its current cycle
+	 */
+	void AllComplexAnimationsStopLooping();
+
+	/**
+	 * \brief Blocks exectution of further code until the currently running animation is complete.
+	 * 		  Keeps calling #Animator::handle and sleeps in between the frames, so it must only be used from the context that drives this #Animator.
+	 * 		  Other tasks should use #Animator::onComplexAnimationComplete instead.
 	 *
 	 * \param animationID ID of the animation which shall be waited for
 	 */
-	void WaitForComplexAnimationCompletion(ComplexAnimationInstance* animationInst);
+	void WaitForComplexAnimationCompletion(ComplexAnimationID animationID);
+
+	/**
+	 * \brief Register a callback that is executed from within #Animator::update once the complex animation finished.
+	 * 		  A looping animation only finishes after #Animator::ComplexAnimationStopLooping was called.
+	 * 		  An animation also counts as finished when another complex animation takes over its objects.
+	 *
+	 * \param animationID animation ID as returned by #Animator::PlayComplexAnimation
+	 * \param callback function to call, replaces any callback registered earlier for this animation
+	 * \param context passed to the callback
+	 * \return false if the animation is not running anymore, the callback is not registered in that case
+	 */
+	bool onComplexAnimationComplete(ComplexAnimationID animationID, CompletionCallback callback, void* context);
+
+	/**
+	 * \brief Register a callback that is executed from within #Animator::update once no complex animation is playing anymore
+	 *
+	 * \param callback function to call, replaces any callback registered earlier
+	 * \param context passed to the callback
+	 * \return false if no complex animation is playing right now, the callback is not registered in that case
+	 */
+	bool onAllComplexAnimationsComplete(CompletionCallback callback, void* context);
+
+	/**
+	 * \brief Get the number of complex animations started with #Animator::PlayComplexAnimation that did not finish yet
+	 */
+	uint16_t getNumRunningComplexAnimations();
+
+	/**
+	 * \brief Check if a complex animation is still referenced by any of the objects of this #Animator
+	 *
+	 * \param animationID animation ID as returned by #Animator::PlayComplexAnimation
+	 * \return true if the animation did not finish yet
+	 */
+	bool isComplexAnimationRunning(ComplexAnimationID animationID);
 
 	/**
-	 * \brief Delays further execution of code without blocking any currently ongoing animations
+	 * \brief Return an animation created with #Animator::BuildComplexAnimation to the instance pool. Played animations are released automatically once they finish,
+	 * 		  releasing one that is still playing cancels it: the remaining steps are not started and its completion callbacks fire right away.
+	 * 		  The step that is currently running on the objects is not stopped.
+	 *
+	 * \param animationID animation ID as returned by #Animator::BuildComplexAnimation or #Animator::PlayComplexAnimation
+	 */
+	void releaseComplexAnimation(ComplexAnimationID animationID);
+
+	/**
+	 * \brief Delays further execution of code without blocking any currently ongoing animations.
+	 * 		  Sleeps between the frames instead of spinning.
 	 *
 	 * \param delayInMs time to wait before moving on in ms
 	 */
 	void delay(uint32_t delayInMs);
+
+	/**
+	 * \brief Register a LED strip with the FastLED backend so that it is only pushed out by #Animator::handle when its content changed.
+	 * 		  If no strip is registered at all every update calls FastLED.show().
+	 *
+	 * \param controller FastLED controller of the strip as returned by FastLED.addLeds()
+	 * \return uint8_t ID of the strip to be used with #Animator::markStripDirty
+	 */
+	uint8_t addLEDStrip(CLEDController* controller);
+
+	/**
+	 * \brief Push the LED strips through another backend, for example a #MockLEDOutput on the host.
+	 * 		  The backend has to use the same strip IDs as the strips registered with #Animator::addLEDStrip.
+	 *
+	 * \param backend backend to use from now on, nullptr goes back to the FastLED backend
+	 */
+	void setOutput(LEDOutput* backend);
+
+	LEDOutput* getOutput();
+
+	/**
+	 * \brief Flag a LED strip as changed, it will be pushed out with the next LED update
+	 *
+	 * \param strip ID of the strip as returned by #Animator::addLEDStrip
+	 */
+	void markStripDirty(uint8_t strip);
+
+	/**
+	 * \brief Flag all LED strips as changed, for example because the global brightness changed
+	 */
+	void markAllStripsDirty();
+
+	/**
+	 * \brief Get the set of LED strips that changed since the last call and clear it
+	 *
+	 * \return uint8_t bitmask of the strip IDs as returned by #Animator::addLEDStrip
+	 */
+	uint8_t takeDirtyStrips();
+
+	/**
+	 * \brief Push the given LED strips out to the LEDs through the backend, see #Animator::setOutput.
+	 * 		  If the backend has no strips FastLED.show() is always called.
+	 *
+	 * \param strips bitmask of the strip IDs to push out, usually the result of #Animator::takeDirtyStrips
+	 */
+	void showStrips(uint8_t strips);
 };
 
 #endif
@@ -0,0 +1,117 @@
+/**
+ * \file EasedTransition.h
+ * \author Florian Laschober
+ * \brief Eased transition of a value over time, shared by the color fades and the brightness levels
+ */
+
+#ifndef __EASED_TRANSITION_H_
+#define __EASED_TRANSITION_H_
+
+#include <Arduino.h>
+#include "AnimatableObject.h"
+
+/**
+ * \brief Moves a value from the one that is current right now to a target over time. Changing the target while a transition
+ * 		  is running continues smoothly from the intermediate value. Only holds the value, using it is up to the owner.
+ * 		  The timing and the easing are handled here, the derived class only provides the interpolation:
+ * 			- static Value interpolate(Value from, Value to, AnimatableObject::AnimationProgress progress):
+ * 			  value at the eased progress, which can undershoot below 0 and overshoot above #ANIMATION_PROGRESS_ONE
+ *
+ * \tparam Derived class that implements the interpolation
+ * \tparam Value type of the value, has to be copyable and comparable with ==
+ */
+template<typename Derived, typename Value>
+class EasedTransition
+{
+protected:
+	Value from;
+	Value to;
+	Value current;
+	uint32_t startTime;
+	uint32_t duration;
+	const EasingBase* easing;
+	bool running;
+
+	/**
+	 * \param initialValue value before the first transition
+	 */
+	EasedTransition(Value initialValue) : from(initialValue), to(initialValue), current(initialValue), startTime(0), duration(0), easing(NO_EASING), running(false)
+	{
+	}
+
+public:
+	/**
+	 * \brief Start a transition from the current value to the target. Does nothing if the target is already reached or being moved to,
+	 * 		  so calling this repeatedly with the same value doesn't restart the transition.
+	 *
+	 * \param target value to move to
+	 * \param transitionDuration length of the transition in ms, 0 jumps to the target
+	 * \param now current time in ms
+	 * \param transitionEasing [optional] default = #NO_EASING; Easing applied to the transition
+	 */
+	void start(Value target, uint32_t transitionDuration, uint32_t now, const EasingBase* transitionEasing = NO_EASING)
+	{
+		if(target == to && (running == true || current == target))
+		{
+			return;
+		}
+		if(transitionDuration == 0)
+		{
+			jumpTo(target);
+			return;
+		}
+		from = current;
+		to = target;
+		startTime = now;
+		duration = transitionDuration;
+		easing = transitionEasing;
+		running = true;
+	}
+
+	/**
+	 * \brief Stop a running transition and set the value right away
+	 */
+	void jumpTo(Value value)
+	{
+		from = to = current = value;
+		running = false;
+	}
+
+	/**
+	 * \brief Advance the transition to the given time
+	 *
+	 * \param now current time in ms
+	 * \return true if the current value changed, false if it did not or no transition is running
+	 */
+	bool update(uint32_t now)
+	{
+		if(running == false)
+		{
+			return false;
+		}
+		uint32_t elapsed = now - startTime;
+		if(elapsed >= duration)
+		{
+			current = to;
+			running = false;
+			return true;
+		}
+		AnimatableObject::AnimationProgress progress = ((uint64_t)elapsed << EASING_FIXED_SHIFT) / duration;
+		if(easing != nullptr)
+		{
+			progress = easing->easeFixed(progress);
+		}
+		Value previous = current;
+		current = Derived::interpolate(from, to, progress);
+		return !(current == previous);
+	}
+
+	/**
+	 * \brief Value the transition ends at
+	 */
+	Value getTarget() const { return to; }
+
+	bool isRunning() const { return running; }
+};
+
+#endif
@@ -0,0 +1,85 @@
+/**
+ * \file LEDOutput.h
+ * \author Florian Laschober
+ * \brief Interface of the backends that push the LED strips out, and the FastLED backend used on the device
+ */
+
+#ifndef __LED_OUTPUT_H_
+#define __LED_OUTPUT_H_
+
+#include <Arduino.h>
+#define FASTLED_INTERNAL
+#include <FastLED.h>
+#include "Configuration.h"
+
+/**
+ * \brief Maximum number of LED strips (FastLED controllers) whose dirty state is tracked by the #Animator
+ */
+#define ANIMATOR_MAX_LED_STRIPS	8
+
+/**
+ * \brief Backend that pushes the content of the LED strips to the LEDs. The #Animator decides which strips changed,
+ * 		  the backend decides how they are sent.
+ */
+class LEDOutput
+{
+public:
+	virtual ~LEDOutput() {}
+
+	virtual uint8_t getNumStrips() = 0;
+
+	/**
+	 * \brief Number of LEDs of a strip, 0 if the strip doesn't exist
+	 */
+	virtual uint16_t getNumLeds(uint8_t strip) = 0;
+
+	/**
+	 * \brief true if the data of several strips is clocked out at the same time, so a show takes as long as the longest strip
+	 * 		  instead of the sum of all of them
+	 */
+	virtual bool isConcurrent() = 0;
+
+	/**
+	 * \brief Push the given strips out to the LEDs
+	 *
+	 * \param strips bitmask of the strip IDs, only contains registered strips
+	 * \param brightness global brightness the LEDs are scaled with on the way out
+	 */
+	virtual void show(uint8_t strips, uint8_t brightness) = 0;
+
+	/**
+	 * \brief Time the data of the given strips needs on the wire, including the latch at the end.
+	 * 		  Modeled from the number of LEDs, see #LED_WIRE_TIME_PER_LED_US and #LED_LATCH_TIME_US
+	 *
+	 * \param strips bitmask of the strip IDs
+	 * \return uint32_t time in µs
+	 */
+	uint32_t getWireTime(uint8_t strips);
+};
+
+/**
+ * \brief Backend for strips driven by FastLED. When more than one strip changed all of them are sent with a single
+ * 		  FastLED.show(), the RMT driver of the ESP32 clocks out all channels at the same time.
+ */
+class FastLEDOutput : public LEDOutput
+{
+private:
+	CLEDController* strips[ANIMATOR_MAX_LED_STRIPS];
+	uint8_t numStrips;
+
+public:
+	FastLEDOutput();
+
+	/**
+	 * \param controller FastLED controller of the strip as returned by FastLED.addLeds()
+	 * \return uint8_t ID of the strip
+	 */
+	uint8_t addStrip(CLEDController* controller);
+
+	uint8_t getNumStrips() { return numStrips; }
+	uint16_t getNumLeds(uint8_t strip);
+	bool isConcurrent() { return true; }
+	void show(uint8_t strips, uint8_t brightness);
+};
+
+#endif
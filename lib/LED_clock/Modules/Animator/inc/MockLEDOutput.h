@@ -0,0 +1,85 @@
+/**
+ * \file MockLEDOutput.h
+ * \author Florian Laschober
+ * \brief Backend that records the frames instead of sending them, for host builds
+ */
+
+#ifndef __MOCK_LED_OUTPUT_H_
+#define __MOCK_LED_OUTPUT_H_
+
+#include "LEDOutput.h"
+
+/**
+ * \brief Records every show instead of driving LEDs: the number of frames per strip, a checksum of the last frame of every
+ * 		  strip and the time the data would have needed on the wire. Allows measuring the output cost of a strip layout without hardware.
+ */
+class MockLEDOutput : public LEDOutput
+{
+private:
+	struct Strip {
+		const CRGB* leds;
+		uint16_t numLeds;
+		uint32_t frames;
+		uint32_t checksum;
+	};
+
+	Strip strips[ANIMATOR_MAX_LED_STRIPS];
+	uint8_t numStrips;
+	bool concurrent;
+	uint32_t frames;
+	uint64_t totalWireTime;
+	uint32_t maxWireTime;
+	uint8_t lastBrightness;
+
+public:
+	/**
+	 * \param concurrentStrips [optional] default = true; whether the modeled hardware sends all strips at the same time
+	 */
+	MockLEDOutput(bool concurrentStrips = true);
+
+	/**
+	 * \param leds buffer the strip shows
+	 * \param numLeds number of LEDs of the strip
+	 * \return uint8_t ID of the strip
+	 */
+	uint8_t addStrip(const CRGB* leds, uint16_t numLeds);
+
+	uint8_t getNumStrips() { return numStrips; }
+	uint16_t getNumLeds(uint8_t strip);
+	bool isConcurrent() { return concurrent; }
+	void show(uint8_t strips, uint8_t brightness);
+
+	/**
+	 * \brief Clear all recorded frames, the strips stay registered
+	 */
+	void reset();
+
+	/**
+	 * \brief Number of shows, no matter how many strips each of them contained
+	 */
+	uint32_t getFrameCount() { return frames; }
+
+	/**
+	 * \brief Number of shows that contained the given strip
+	 */
+	uint32_t getFrameCount(uint8_t strip);
+
+	/**
+	 * \brief FNV-1a checksum of the last frame that was sent on the given strip, 0 if it was never sent
+	 */
+	uint32_t getChecksum(uint8_t strip);
+
+	/**
+	 * \brief Sum of the modeled wire time of all shows in µs
+	 */
+	uint64_t getTotalWireTime() { return totalWireTime; }
+
+	/**
+	 * \brief Longest modeled wire time of a single show in µs
+	 */
+	uint32_t getMaxWireTime() { return maxWireTime; }
+
+	uint8_t getLastBrightness() { return lastBrightness; }
+};
+
+#endif
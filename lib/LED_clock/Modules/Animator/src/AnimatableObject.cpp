@@ -1,17 +1,18 @@
 #include "AnimatableObject.h"
+#include "Animator.h"
 
-AnimatableObject::AnimatableObject()
+AnimatableObject::AnimatableObject() : AnimatableObject(0, 0)
 {
-	AnimatableObject(0, 0);
 }
 
-AnimatableObject::AnimatableObject(uint16_t OverallDuration, uint16_t steps)
+AnimatableObject::AnimatableObject(uint32_t OverallDuration, uint16_t steps)
 {
-	AnimationDuration = OverallDuration;
-	tickLength = 20;
+	AnimationDuration = 0;
+	progressScale = 0;
 	animationStarted = false;
 	fps = 0;
-	numStates = 0;
+	tickInterval = 0;
+	lastTickTime = 0;
 	finishedCallback = nullptr;
 	startCallback = nullptr;
 	ComplexAnimStartCallback = nullptr;
@@ -20,33 +21,49 @@ AnimatableObject::AnimatableObject(uint16_t OverallDuration, uint16_t steps)
     effect = nullptr;
 	easing = nullptr;
 	currentAnimationTime = 0;
-	oldState = UINT16_MAX;
+	oldProgress = INT32_MIN;
 	complexAnimationInst = nullptr;
+	scheduler = nullptr;
+	schedulerSlot = -1;
+	setAnimationDuration(OverallDuration);
 }
 
 AnimatableObject::~AnimatableObject()
 {
 }
 
-void AnimatableObject::handle(uint32_t state)
+void AnimatableObject::handle(uint32_t frameTime, uint32_t state)
 {
-	unsigned long currentMillis = millis();
 	if(animationStarted == true)
 	{
-		if(state != -1)
+		if(state != ANIMATOR_NO_STATE)
 		{
-			currentAnimationTime = constrain(state, 0, AnimationDuration);
+			currentAnimationTime = state < AnimationDuration / 1000 ? state * 1000 : AnimationDuration;
 		}
 		else
 		{
-			currentAnimationTime = currentMillis - AnimationStartTimestamp;
+			//signed difference so that a wrap of micros() after ~71 minutes does not matter
+			int32_t elapsed = (int32_t)(frameTime - AnimationStartTimestamp);
+			currentAnimationTime = elapsed < 0 ? 0 : (uint32_t)elapsed < AnimationDuration ? elapsed : AnimationDuration;
+			//only tick as often as the fps of this object ask for, but never skip the final state.
+			//Ticks sit on a grid of tickInterval and a frame that wakes up to half an interval early still gets its tick,
+			//otherwise the jitter of the frame timing drops every other tick when the fps are close to the frame rate
+			if(currentAnimationTime < AnimationDuration && (int32_t)(frameTime - lastTickTime) < (int32_t)(tickInterval - tickInterval / 2))
+			{
+				return;
+			}
 		}
 
-		uint16_t currentState = getState();
-		if(oldState != currentState)
+		AnimationProgress progress = getProgress();
+		if(oldProgress != progress)
 		{
-			tick(currentState);
-			oldState = currentState;
+			tick(progress);
+			oldProgress = progress;
+			lastTickTime += tickInterval;
+			if((int32_t)(frameTime - lastTickTime) >= (int32_t)tickInterval) // fell behind by more than a tick, restart the grid from now
+			{
+				lastTickTime = frameTime;
+			}
 		}
 		if(currentAnimationTime >= AnimationDuration)
 		{
@@ -55,14 +72,17 @@ void AnimatableObject::handle(uint32_t state)
 	}
 }
 
-void AnimatableObject::tick(int32_t currentState)
+void AnimatableObject::tick(AnimationProgress progress)
 {
 
 }
 
-void AnimatableObject::setAnimationDuration(uint16_t duration)
+void AnimatableObject::setAnimationDuration(uint32_t duration)
 {
-	AnimationDuration = duration;
+	AnimationDuration = duration * 1000;
+	//progress = time * progressScale >> 32, calculated here once so that no division is needed per frame.
+	//32 fractional bits keep the error below one LSB of the progress for any duration that fits the µs timeline
+	progressScale = AnimationDuration > 0 ? ((uint64_t)ANIMATION_PROGRESS_ONE << 32) / AnimationDuration : 0;
 }
 
 void AnimatableObject::setAnimationFps(uint16_t FramesPerSecond)
@@ -74,26 +94,27 @@ void AnimatableObject::setAnimationFps(uint16_t FramesPerSecond)
 	{
 		fps = FramesPerSecond;
 	}
-	numStates = round(fps * ((double)getAnimationDuration() / 1000.0));
+	tickInterval = fps > 0 ? 1000000 / fps : 0;
 }
 
-uint16_t AnimatableObject::getAnimationDuration()
+uint32_t AnimatableObject::getAnimationDuration()
 {
-	return AnimationDuration;
+	return AnimationDuration / 1000;
 }
 
 void AnimatableObject::start()
 {
-	AnimationStartTimestamp = millis();
 	if(animationStarted == true) // only start the animation if it's not already started
 	{
 		reset();
 	}
+	//use the time of the current frame so that animations started from callbacks line up with the frame they were started in
+	AnimationStartTimestamp = scheduler != nullptr ? scheduler->now() : micros();
+	lastTickTime = AnimationStartTimestamp - tickInterval;
 	animationStarted = true;
-	if(easing != nullptr)
+	if(scheduler != nullptr)
 	{
-		easing->setTotalChangeInPosition(numStates);
-		easing->setDuration(AnimationDuration);
+		scheduler->setRunning(schedulerSlot, true);
 	}
 	if(startCallback != nullptr)
 	{
@@ -108,13 +129,17 @@ void AnimatableObject::start()
 void AnimatableObject::stop()
 {
 	animationStarted = false;
+	if(scheduler != nullptr)
+	{
+		scheduler->setRunning(schedulerSlot, false);
+	}
 }
 
 void AnimatableObject::reset()
 {
 	stop();
 	currentAnimationTime = 0;
-	oldState = UINT16_MAX;
+	oldProgress = INT32_MIN;
 }
 
 void AnimatableObject::done()
@@ -130,13 +155,14 @@ void AnimatableObject::done()
 	}
 }
 
-int32_t AnimatableObject::getState()
+AnimatableObject::AnimationProgress AnimatableObject::getProgress()
 {
+	AnimationProgress progress = currentAnimationTime >= AnimationDuration ? ANIMATION_PROGRESS_ONE : (currentAnimationTime * progressScale) >> 32;
 	if(easing != nullptr)
 	{
-		return easing->ease(currentAnimationTime);
+		return easing->easeFixed(progress);
 	}
-	return map(currentAnimationTime, 0, AnimationDuration, 0, numStates);
+	return progress;
 }
 
 void AnimatableObject::setAnimationDoneCallback(AnimationCallBack* callback)
@@ -154,7 +180,7 @@ void AnimatableObject::setAnimationEffect(AnimatableObject::AnimationFunction ne
 	effect = newEffect;
 }
 
-void AnimatableObject::setAnimationEasing(EasingBase* easingEffect)
+void AnimatableObject::setAnimationEasing(const EasingBase* easingEffect)
 {
 	easing = easingEffect;
 }
\ No newline at end of file
@@ -1,9 +1,37 @@
 #include "Animator.h"
-unsigned long Animator::lastLEDUpdate=0;
 Animator* Animator::currentInstance = nullptr;
 
 Animator::Animator()
 {
+	numAnimatableObjects = 0;
+	output = &fastLEDOutput;
+	dirtyStrips = 0;
+	for (uint8_t i = 0; i < ANIMATOR_MAX_LED_STRIPS; i++)
+	{
+		stripShowTime[i] = 0;
+	}
+	frameWorkTime = 0;
+	frameUpdated = false;
+	framePeriod = ANIMATOR_MIN_FRAME_PERIOD_US;
+	reportedFrameRate = 0;
+	nextFrameTime = 0;
+	frameTime = 0;
+	frameInProgress = false;
+	runningComplexAnimations = 0;
+	onIdle = nullptr;
+	onIdleContext = nullptr;
+	renderStage = nullptr;
+	renderStageContext = nullptr;
+	setAnimationSpeed(DEFAULT_ANIMATION_SPEED);
+	for (uint8_t i = 0; i < ANIMATOR_MAX_COMPLEX_ANIMATIONS; i++)
+	{
+		complexAnimationPool[i].generation = 1;
+		complexAnimationPool[i].inUse = false;
+	}
+	for (uint8_t i = 0; i < ANIMATOR_RUNNING_WORDS; i++)
+	{
+		runningObjects[i] = 0;
+	}
 }
 
 Animator::~Animator()
@@ -20,50 +48,259 @@ Animator* Animator::getInstance()
 	return currentInstance;
 }
 
-int16_t Animator::getIndexInList(AnimatableObject* object)
+void Animator::setRunning(int16_t slot, bool running)
 {
-	for (int i = 0; i < AnimatableObjects.size(); i++)
+	if(slot < 0 || slot >= numAnimatableObjects)
 	{
-		if(AnimatableObjects.get(i) == object)
-		{
-			return i;
-		}
+		return;
+	}
+	if(running == true)
+	{
+		runningObjects[slot / 32] |= (1UL << (slot % 32));
+	}
+	else
+	{
+		runningObjects[slot / 32] &= ~(1UL << (slot % 32));
 	}
-	return -1;
 }
 
 void Animator::add(AnimatableObject* animationToAdd)
 {
-	if(getIndexInList(animationToAdd) == -1)
+	if(animationToAdd->scheduler == this)
+	{
+		return;
+	}
+	if(numAnimatableObjects >= ANIMATOR_MAX_OBJECTS)
 	{
-		AnimatableObjects.add(animationToAdd);
+		Serial.printf("[E] Animator is full (%d objects). Increase ANIMATOR_MAX_OBJECTS\n\r", ANIMATOR_MAX_OBJECTS);
+		return;
 	}
+	animationToAdd->scheduler = this;
+	animationToAdd->schedulerSlot = numAnimatableObjects;
+	AnimatableObjects[numAnimatableObjects++] = animationToAdd;
+	setRunning(animationToAdd->schedulerSlot, animationToAdd->animationStarted);
 }
 
 void Animator::remove(AnimatableObject* animationToRemove)
 {
-	int16_t indexToRemove = getIndexInList(animationToRemove);
-	if(indexToRemove != -1)
+	if(animationToRemove->scheduler != this)
 	{
-		AnimatableObjects.remove(indexToRemove);
+		return;
+	}
+	int16_t indexToRemove = animationToRemove->schedulerSlot;
+	int16_t lastIndex = numAnimatableObjects - 1;
+	setRunning(indexToRemove, false);
+	//move the last object into the free slot to keep the table contiguous, its old bit has to be cleared while the slot is still valid
+	AnimatableObject* lastObject = AnimatableObjects[lastIndex];
+	setRunning(lastIndex, false);
+	AnimatableObjects[lastIndex] = nullptr;
+	numAnimatableObjects--;
+	if(lastObject != animationToRemove)
+	{
+		AnimatableObjects[indexToRemove] = lastObject;
+		lastObject->schedulerSlot = indexToRemove;
+		setRunning(indexToRemove, lastObject->animationStarted);
 	}
+	animationToRemove->scheduler = nullptr;
+	animationToRemove->schedulerSlot = -1;
 }
 
 void Animator::handle(uint32_t state)
 {
-	for (int i = 0; i < AnimatableObjects.size(); i++)
+	if(state == ANIMATOR_NO_STATE && frameDue() == false)
+	{
+		return;
+	}
+	update(state);
+	showStrips(takeDirtyStrips());
+}
+
+bool Animator::frameDue()
+{
+	uint32_t currentMicros = micros();
+	if((int32_t)(currentMicros - nextFrameTime) < 0)
+	{
+		return false;
+	}
+	nextFrameTime += framePeriod;
+	if((int32_t)(currentMicros - nextFrameTime) >= 0)
+	{
+		nextFrameTime = currentMicros + framePeriod;
+	}
+	return true;
+}
+
+uint32_t Animator::getTimeUntilNextFrame()
+{
+	int32_t remaining = (int32_t)(nextFrameTime - micros());
+	return remaining > 0 ? (remaining + 999) / 1000 : 0;
+}
+
+uint32_t Animator::getFramePeriod()
+{
+	return framePeriod;
+}
+
+uint16_t Animator::getFrameRate()
+{
+	return 1000000UL / framePeriod;
+}
+
+uint32_t Animator::trackTiming(uint32_t tracked, uint32_t measured)
+{
+	return measured >= tracked ? measured : tracked - (tracked - measured + ANIMATOR_TIMING_DECAY - 1) / ANIMATOR_TIMING_DECAY;
+}
+
+void Animator::updateFramePeriod()
+{
+	uint8_t numStrips = output->getNumStrips();
+	uint32_t showTime = output->getWireTime(UINT8_MAX);
+	for (uint8_t i = 0; i < numStrips && i < ANIMATOR_MAX_LED_STRIPS; i++)
 	{
-		AnimatableObjects.get(i)->handle(state);
+		showTime = stripShowTime[i] > showTime ? stripShowTime[i] : showTime;
 	}
+	uint32_t period = (frameWorkTime + showTime) * (100 + ANIMATOR_FRAME_HEADROOM) / 100;
+	framePeriod = period > ANIMATOR_MIN_FRAME_PERIOD_US ? period : ANIMATOR_MIN_FRAME_PERIOD_US;
 
-	if(lastLEDUpdate + FASTLED_SAFE_DELAY_MS < millis())
+	uint16_t frameRate = getFrameRate();
+	if(frameRate + ANIMATOR_FPS_REPORT_STEP <= reportedFrameRate || frameRate >= reportedFrameRate + ANIMATOR_FPS_REPORT_STEP)
+	{
+		Serial.printf("[Animator::updateFramePeriod] Running at %d fps (frame %lu us, show %lu us, work %lu us)\n\r", frameRate, (unsigned long)framePeriod, (unsigned long)showTime, (unsigned long)frameWorkTime);
+		reportedFrameRate = frameRate;
+	}
+}
+
+uint32_t Animator::now()
+{
+	return frameInProgress == true ? frameTime : micros();
+}
+
+void Animator::update(uint32_t state)
+{
+	frameTime = micros();
+	frameInProgress = true;
+	for (uint8_t word = 0; word < ANIMATOR_RUNNING_WORDS; word++)
+	{
+		uint32_t pending = runningObjects[word];
+		while(pending != 0)
+		{
+			uint8_t bit = __builtin_ctz(pending);
+			AnimatableObjects[word * 32 + bit]->handle(frameTime, state);
+			//re-read the mask as callbacks of the handled object may have started or stopped other objects
+			pending = bit < 31 ? runningObjects[word] & (UINT32_MAX << (bit + 1)) : 0;
+		}
+	}
+	if(renderStage != nullptr)
+	{
+		renderStage(renderStageContext);
+	}
+	frameInProgress = false;
+	frameUpdated = true;
+}
+
+void Animator::setRenderStage(RenderStage stage, void* context)
+{
+	renderStage = stage;
+	renderStageContext = context;
+}
+
+bool Animator::isBatchingFrame()
+{
+	return frameInProgress == true && renderStage != nullptr;
+}
+
+uint8_t Animator::addLEDStrip(CLEDController* controller)
+{
+	uint8_t strip = fastLEDOutput.addStrip(controller);
+	markStripDirty(strip);
+	updateFramePeriod();
+	return strip;
+}
+
+void Animator::setOutput(LEDOutput* backend)
+{
+	output = backend != nullptr ? backend : &fastLEDOutput;
+	for (uint8_t i = 0; i < ANIMATOR_MAX_LED_STRIPS; i++)
+	{
+		stripShowTime[i] = 0;
+	}
+	markAllStripsDirty();
+	updateFramePeriod();
+}
+
+LEDOutput* Animator::getOutput()
+{
+	return output;
+}
+
+void Animator::markStripDirty(uint8_t strip)
+{
+	dirtyStrips |= (1 << strip);
+}
+
+void Animator::markAllStripsDirty()
+{
+	dirtyStrips = UINT8_MAX;
+}
+
+uint8_t Animator::takeDirtyStrips()
+{
+	uint8_t strips = dirtyStrips;
+	dirtyStrips = 0;
+	return strips;
+}
+
+void Animator::showStrips(uint8_t strips)
+{
+	uint32_t showStart = micros();
+	if(frameUpdated == true)
+	{
+		//everything since the update belongs to the frame as well, e.g. composing the LEDs
+		frameWorkTime = trackTiming(frameWorkTime, showStart - frameTime);
+		frameUpdated = false;
+	}
+	uint8_t numStrips = output->getNumStrips();
+	if(numStrips == 0) // nothing registered, so there is no way to know what changed
 	{
-		lastLEDUpdate = millis();
 		FastLED.show();
+		return;
 	}
+	strips &= UINT8_MAX >> (8 - numStrips);
+	if(strips == 0)
+	{
+		return;
+	}
+	//the owner of the strips keeps the global brightness within the power budget, see #DisplayManager::presentFrame
+	output->show(strips, FastLED.getBrightness());
+	uint32_t showTime = micros() - showStart;
+	for (uint8_t i = 0; i < numStrips; i++)
+	{
+		if((strips & (1 << i)) != 0)
+		{
+			stripShowTime[i] = trackTiming(stripShowTime[i], showTime);
+		}
+	}
+	updateFramePeriod();
+}
+
+void Animator::setAnimationSpeed(uint16_t percent)
+{
+	speedPercent = percent < ANIMATOR_MIN_SPEED ? ANIMATOR_MIN_SPEED : percent > ANIMATOR_MAX_SPEED ? ANIMATOR_MAX_SPEED : percent;
+	//Q16.16 factor from the normalized length to the real one, so starting a step needs no division
+	durationScale = (100UL << 16) / speedPercent;
 }
 
-void Animator::setAnimation(AnimatableObject* object, AnimatableObject::AnimationFunction animationEffect, uint16_t duration, EasingBase* easing, uint8_t fps)
+uint16_t Animator::getAnimationSpeed()
+{
+	return speedPercent;
+}
+
+uint32_t Animator::getScaledDuration(uint32_t duration)
+{
+	return ((uint64_t)duration * durationScale) >> 16;
+}
+
+void Animator::setAnimation(AnimatableObject* object, AnimatableObject::AnimationFunction animationEffect, uint32_t duration, const EasingBase* easing, uint8_t fps)
 {
 	object->setAnimationDuration(duration);
 	object->setAnimationFps(fps);
@@ -71,18 +308,18 @@ void Animator::setAnimation(AnimatableObject* object, AnimatableObject::Animatio
 	object->setAnimationEasing(easing);
 }
 
-void Animator::setAnimationDuration(AnimatableObject* object, uint16_t duration)
+void Animator::setAnimationDuration(AnimatableObject* object, uint32_t duration)
 {
 	object->setAnimationDuration(duration);
 }
 
-void Animator::startAnimation(AnimatableObject* object, AnimatableObject::AnimationFunction animationEffect, uint16_t duration, EasingBase* easing, uint8_t fps)
+void Animator::startAnimation(AnimatableObject* object, AnimatableObject::AnimationFunction animationEffect, uint32_t duration, const EasingBase* easing, uint8_t fps)
 {
 	setAnimation(object, animationEffect, duration, easing, fps);
 	startAnimation(object);
 }
 
-void Animator::startAnimation(AnimatableObject* object, AnimatableObject::AnimationFunction animationEffect, EasingBase* easing)
+void Animator::startAnimation(AnimatableObject* object, AnimatableObject::AnimationFunction animationEffect, const EasingBase* easing)
 {
 	startAnimation(object, animationEffect, object->getAnimationDuration(), easing);
 }
@@ -110,9 +347,12 @@ AnimatableObject::AnimationFunction Animator::getAnimationEffect(AnimatableObjec
 void Animator::delay(uint32_t delayInMs)
 {
 	unsigned long startMillis = millis();
-	while(millis() - startMillis < delayInMs)
+	uint32_t elapsed;
+	while((elapsed = millis() - startMillis) < delayInMs)
 	{
 		handle();
+		uint32_t timeUntilNextFrame = getTimeUntilNextFrame();
+		::delay(timeUntilNextFrame < delayInMs - elapsed ? timeUntilNextFrame : delayInMs - elapsed);
 	}
 }
 
@@ -131,7 +371,7 @@ void Animator::animationIterationDoneCallback(AnimatableObject* sourceObject)
 	}
 	ComplexAnimationInstance* currentAnimation = (ComplexAnimationInstance*) sourceObject->complexAnimationInst;
 
-	if(++currentAnimation->counter < currentAnimation->animation->animations->size())
+	if(++currentAnimation->counter < currentAnimation->animation->numSteps)
 	{
 		startAnimationStep(currentAnimation->counter, currentAnimation);
 	}
@@ -144,18 +384,87 @@ void Animator::animationIterationDoneCallback(AnimatableObject* sourceObject)
 		}
 		else
 		{
-			//make sure that no references to this animations are retained before deleting it
-			for (int i = 0; i < AnimatableObjects.size(); i++)
-			{
-				AnimatableObject* currentObject = AnimatableObjects.get(i);
-				if(currentObject->complexAnimationInst == currentAnimation)
-				{
-					currentObject->complexAnimationInst = nullptr;
-				}
-			}
-			delete currentAnimation;
+			finishComplexAnimation(currentAnimation);
+		}
+	}
+}
+
+void Animator::finishComplexAnimation(ComplexAnimationInstance* animationInst)
+{
+	//make sure that no references to this animations are retained before deleting it
+	for (uint16_t i = 0; i < numAnimatableObjects; i++)
+	{
+		AnimatableObject* currentObject = AnimatableObjects[i];
+		if(currentObject->complexAnimationInst == animationInst)
+		{
+			currentObject->complexAnimationInst = nullptr;
+			//a step that is still running must not advance the chain anymore once it is done
+			currentObject->ComplexAnimDoneCallback = nullptr;
+			currentObject->ComplexAnimStartCallback = nullptr;
 		}
 	}
+	if(animationInst->onComplete != nullptr)
+	{
+		animationInst->onComplete(animationInst->onCompleteContext);
+	}
+	bool played = animationInst->played;
+	//invalidate all handles that are still around for this slot
+	animationInst->inUse = false;
+	animationInst->generation++;
+	if(played == true && runningComplexAnimations > 0 && --runningComplexAnimations == 0 && onIdle != nullptr)
+	{
+		CompletionCallback callback = onIdle;
+		onIdle = nullptr;
+		callback(onIdleContext);
+	}
+}
+
+Animator::ComplexAnimationInstance* Animator::getComplexAnimation(ComplexAnimationID animationID)
+{
+	uint16_t slot = animationID & 0xFFFF;
+	if(animationID == INVALID_COMPLEX_ANIMATION_ID || slot >= ANIMATOR_MAX_COMPLEX_ANIMATIONS)
+	{
+		return nullptr;
+	}
+	ComplexAnimationInstance* animationInst = &complexAnimationPool[slot];
+	if(animationInst->inUse == false || animationInst->generation != (animationID >> 16))
+	{
+		return nullptr;
+	}
+	return animationInst;
+}
+
+Animator::ComplexAnimationID Animator::getComplexAnimationID(ComplexAnimationInstance* animationInst)
+{
+	return ((ComplexAnimationID)animationInst->generation << 16) | (animationInst - complexAnimationPool);
+}
+
+bool Animator::onComplexAnimationComplete(ComplexAnimationID animationID, CompletionCallback callback, void* context)
+{
+	ComplexAnimationInstance* animationInst = getComplexAnimation(animationID);
+	if(animationInst == nullptr)
+	{
+		return false;
+	}
+	animationInst->onComplete = callback;
+	animationInst->onCompleteContext = context;
+	return true;
+}
+
+bool Animator::onAllComplexAnimationsComplete(CompletionCallback callback, void* context)
+{
+	if(runningComplexAnimations == 0)
+	{
+		return false;
+	}
+	onIdle = callback;
+	onIdleContext = context;
+	return true;
+}
+
+uint16_t Animator::getNumRunningComplexAnimations()
+{
+	return runningComplexAnimations;
 }
 
 void Animator::startAnimationStep(uint16_t stepindex, ComplexAnimationInstance* animationInst)
@@ -166,25 +475,35 @@ void Animator::startAnimationStep(uint16_t stepindex, ComplexAnimationInstance*
 		return;
 	}
 
-	animationStep* StepToStart = animationInst->animation->animations->get(stepindex);
+	const ComplexAmination* animation = animationInst->animation;
+	uint16_t firstEntry = stepindex * animation->animationComplexity;
+	const int16_t* arrayIndex = &animation->arrayIndex[firstEntry];
+	const AnimatableObject::AnimationFunction* animationEffects = &animation->animationEffects[firstEntry];
+	const EasingBase* const* easingEffects = &animation->easingEffects[firstEntry];
 	bool hasCallbacks = false;
 	bool wasEmpty = true;
 	AnimatableObject* currentObject;
-	for (int j = 0; j < animationInst->animation->animationComplexity; j++)
+	for (int j = 0; j < animation->animationComplexity; j++)
 	{
-		if(StepToStart->arrayIndex[j] != -1)
+		if(arrayIndex[j] != -1)
 		{
-			currentObject = animationInst->objects[StepToStart->arrayIndex[j]];
-			setAnimationDuration(currentObject, animationInst->animation->LengthPerAnimation);
+			currentObject = animationInst->objects[arrayIndex[j]];
+			setAnimationDuration(currentObject, getScaledDuration(animationInst->animation->LengthPerAnimation));
 			currentObject->ComplexAnimationManager = this;
 			if(hasCallbacks == false) //only assign the callbacks to one object as all of them should start and end at the same time
 			{
 				hasCallbacks = true;
+				ComplexAnimationInstance* previousAnimation = (ComplexAnimationInstance*)currentObject->complexAnimationInst;
+				if(previousAnimation != nullptr && previousAnimation != animationInst && previousAnimation->played == true)
+				{
+					//the animation that was playing on this object can never finish now, so end it here
+					finishComplexAnimation(previousAnimation);
+				}
 				currentObject->complexAnimationInst = animationInst;
 				currentObject->ComplexAnimDoneCallback = &Animator::animationIterationDoneCallback;
 				currentObject->ComplexAnimStartCallback = &Animator::animationIterationStartCallback;
 			}
-			startAnimation(currentObject, StepToStart->animationEffects[j], StepToStart->easingEffects[j]);
+			startAnimation(currentObject, animationEffects[j], easingEffects[j]);
 			animationInst->running = true;
 			wasEmpty = false;
 		}
@@ -195,19 +514,23 @@ void Animator::startAnimationStep(uint16_t stepindex, ComplexAnimationInstance*
 	}
 }
 
-Animator::ComplexAnimationInstance* Animator::PlayComplexAnimation(ComplexAmination* animation, AnimatableObject* animationObjectsArray[], bool looping)
+Animator::ComplexAnimationID Animator::PlayComplexAnimation(const ComplexAmination* animation, AnimatableObject* animationObjectsArray[], bool looping)
 {
-	ComplexAnimationInstance* ComplexAnimation = BuildComplexAnimation(animation, animationObjectsArray, looping);
+	ComplexAnimationID animationID = BuildComplexAnimation(animation, animationObjectsArray, looping);
+	ComplexAnimationInstance* ComplexAnimation = getComplexAnimation(animationID);
 	if(ComplexAnimation == nullptr)
 	{
-		return nullptr;
+		return INVALID_COMPLEX_ANIMATION_ID;
 	}
+	ComplexAnimation->played = true;
+	runningComplexAnimations++;
 	startAnimationStep(0, ComplexAnimation);
-	return ComplexAnimation;
+	return animationID;
 }
 
-void Animator::ComplexAnimationStopLooping(ComplexAnimationInstance* animationInst)
+void Animator::ComplexAnimationStopLooping(ComplexAnimationID animationID)
 {
+	ComplexAnimationInstance* animationInst = getComplexAnimation(animationID);
 	if(animationInst == nullptr)
 	{
 		Serial.println("[E] Complex animation ID was invalid");
@@ -216,101 +539,132 @@ void Animator::ComplexAnimationStopLooping(ComplexAnimationInstance* animationIn
 	animationInst->loop = false;
 }
 
-void Animator::WaitForComplexAnimationCompletion(ComplexAnimationInstance* animationInst)
+void Animator::AllComplexAnimationsStopLooping()
 {
-	ComplexAnimationStopLooping(animationInst);
-	bool animationRunning = true;
-	bool animationReferenceFound;
-	while(animationRunning == true) //wait until the animation is removed from the list
+	for (uint8_t i = 0; i < ANIMATOR_MAX_COMPLEX_ANIMATIONS; i++)
 	{
-		animationReferenceFound = false;
-		for (int i = 0; i < AnimatableObjects.size(); i++)
-		{
-			if(AnimatableObjects.get(i)->complexAnimationInst == animationInst)
-			{
-				animationReferenceFound = true;
-			}
-		}
-		if(animationReferenceFound == false)
+		if(complexAnimationPool[i].inUse == true && complexAnimationPool[i].played == true)
 		{
-			animationRunning = false;
+			complexAnimationPool[i].loop = false;
 		}
+	}
+}
+
+void Animator::WaitForComplexAnimationCompletion(ComplexAnimationID animationID)
+{
+	ComplexAnimationStopLooping(animationID);
+	while(isComplexAnimationRunning(animationID) == true)
+	{
 		handle();
+		::delay(getTimeUntilNextFrame());
 	}
+	handle();
 }
 
-Animator::ComplexAnimationInstance* Animator::BuildComplexAnimation(ComplexAmination* animation, AnimatableObject* animationObjectsArray[], bool looping)
+bool Animator::isComplexAnimationRunning(ComplexAnimationID animationID)
 {
-	if(animation->animations == nullptr)
+	return getComplexAnimation(animationID) != nullptr;
+}
+
+void Animator::releaseComplexAnimation(ComplexAnimationID animationID)
+{
+	ComplexAnimationInstance* animationInst = getComplexAnimation(animationID);
+	if(animationInst != nullptr)
+	{
+		finishComplexAnimation(animationInst);
+	}
+}
+
+Animator::ComplexAnimationID Animator::BuildComplexAnimation(const ComplexAmination* animation, AnimatableObject* animationObjectsArray[], bool looping)
+{
+	if(animation == nullptr || animation->arrayIndex == nullptr)
 	{
 		Serial.println("[E] animation chain was null pointer!");
-		return nullptr;
+		return INVALID_COMPLEX_ANIMATION_ID;
 	}
 	if(animationObjectsArray == nullptr)
 	{
 		Serial.println("[E] animation objects was null pointer!");
-		return nullptr;
+		return INVALID_COMPLEX_ANIMATION_ID;
 	}
-
-	ComplexAnimationInstance* ComplexAnimation = new ComplexAnimationInstance {
-		.animation = animation,
-		.loop = looping,
-		.counter = 0,
-		.objects = animationObjectsArray,
-		.running = false
-	};
-	if(ComplexAnimation == nullptr)
+	if(animation->numSteps < 1)
 	{
-		Serial.println("[E] Animation object could not be instantiated!");
-		return nullptr;
+		Serial.println("[E] animation chain size was zero this Should not be the case!");
+		return INVALID_COMPLEX_ANIMATION_ID;
 	}
-	if(animation->animations->size() >= 1)
+
+	ComplexAnimationInstance* ComplexAnimation = nullptr;
+	for (uint8_t i = 0; i < ANIMATOR_MAX_COMPLEX_ANIMATIONS; i++)
 	{
-		return ComplexAnimation;
+		if(complexAnimationPool[i].inUse == false)
+		{
+			ComplexAnimation = &complexAnimationPool[i];
+			break;
+		}
 	}
-	else
+	if(ComplexAnimation == nullptr)
 	{
-		Serial.println("[E] animation chain size was zero this Should not be the case!");
-		return nullptr;
+		Serial.printf("[E] All %d complex animation instances are in use. Increase ANIMATOR_MAX_COMPLEX_ANIMATIONS\n\r", ANIMATOR_MAX_COMPLEX_ANIMATIONS);
+		return INVALID_COMPLEX_ANIMATION_ID;
 	}
+	ComplexAnimation->animation = animation;
+	ComplexAnimation->loop = looping;
+	ComplexAnimation->counter = 0;
+	ComplexAnimation->objects = animationObjectsArray;
+	ComplexAnimation->running = false;
+	ComplexAnimation->played = false;
+	ComplexAnimation->onComplete = nullptr;
+	ComplexAnimation->onCompleteContext = nullptr;
+	ComplexAnimation->inUse = true;
+	return getComplexAnimationID(ComplexAnimation);
 }
 
-void Animator::setComplexAnimationStep(ComplexAnimationInstance* animationInst, uint8_t step, uint32_t state)
+void Animator::setComplexAnimationStep(ComplexAnimationID animationID, uint8_t step, uint32_t state)
 {
+	ComplexAnimationInstance* animationInst = getComplexAnimation(animationID);
 	if(animationInst == nullptr)
 	{
-		Serial.printf("[E] Complex animation instance was nullpointer. Animation step %d was not started\n\r", step);
+		Serial.printf("[E] Complex animation ID was invalid. Animation step %d was not started\n\r", step);
 		return;
 	}
-	if(step > animationInst->animation->animations->size() - 1)
+	if(step >= animationInst->animation->numSteps)
 	{
-		Serial.printf("[E] invalid step (%d) for complex animation; Highest allowed step: %d\n\r", step, animationInst->animation->animations->size());
+		Serial.printf("[E] invalid step (%d) for complex animation; Highest allowed step: %d\n\r", step, animationInst->animation->numSteps - 1);
 		return;
 	}
 
-	animationStep* StepToStart = animationInst->animation->animations->get(step);
+	const ComplexAmination* animation = animationInst->animation;
+	uint16_t firstEntry = step * animation->animationComplexity;
+	const int16_t* arrayIndex = &animation->arrayIndex[firstEntry];
+	const AnimatableObject::AnimationFunction* animationEffects = &animation->animationEffects[firstEntry];
+	const EasingBase* const* easingEffects = &animation->easingEffects[firstEntry];
 	bool hasCallbacks = false;
 	bool wasEmpty = true;
 	AnimatableObject* currentObject;
-	for (int j = 0; j < animationInst->animation->animationComplexity; j++)
+	for (int j = 0; j < animation->animationComplexity; j++)
 	{
-		if(StepToStart->arrayIndex[j] != -1)
+		if(arrayIndex[j] != -1)
 		{
-			currentObject = animationInst->objects[StepToStart->arrayIndex[j]];
-			setAnimationDuration(currentObject, animationInst->animation->LengthPerAnimation);
+			currentObject = animationInst->objects[arrayIndex[j]];
+			setAnimationDuration(currentObject, getScaledDuration(animationInst->animation->LengthPerAnimation));
 			currentObject->ComplexAnimationManager = this;
 			if(hasCallbacks == false) //only assign the callbacks to one object as all of them should start and end at the same time
 			{
 				hasCallbacks = true;
+				ComplexAnimationInstance* previousAnimation = (ComplexAnimationInstance*)currentObject->complexAnimationInst;
+				if(previousAnimation != nullptr && previousAnimation != animationInst && previousAnimation->played == true)
+				{
+					finishComplexAnimation(previousAnimation);
+				}
 				currentObject->complexAnimationInst = animationInst;
 			}
-			startAnimation(currentObject, StepToStart->animationEffects[j], StepToStart->easingEffects[j]);
+			startAnimation(currentObject, animationEffects[j], easingEffects[j]);
 			animationInst->running = true;
 			wasEmpty = false;
 			//make sure to disable all other animations of this animation chain
-			for (int i = 0; i < AnimatableObjects.size(); i++)
+			for (uint16_t i = 0; i < numAnimatableObjects; i++)
 			{
-				AnimatableObject* cObject = AnimatableObjects.get(i);
+				AnimatableObject* cObject = AnimatableObjects[i];
 				cObject->startCallback = nullptr;
 				cObject->finishedCallback = nullptr;
 				cObject->ComplexAnimDoneCallback = nullptr;
@@ -320,13 +674,13 @@ void Animator::setComplexAnimationStep(ComplexAnimationInstance* animationInst,
 					if(cObject != currentObject)
 					{
 						cObject->complexAnimationInst = nullptr;
-						cObject->handle(cObject->AnimationDuration);
+						cObject->handle(now(), cObject->getAnimationDuration());
 					}
 				}
 			}
 		}
 	}
-	handle(state);
+	update(state);
 	if(wasEmpty == true)
 	{
 		Serial.printf("[Animator::setComplexAnimationStep] Complex animation start point was empty. Animation step (%d) was not started.\n\r", step);
@@ -0,0 +1,67 @@
+/**
+ * \file LEDOutput.cpp
+ * \author Florian Laschober
+ * \brief Implementation of the wire time model and of the FastLED backend
+ */
+
+#include "LEDOutput.h"
+
+uint32_t LEDOutput::getWireTime(uint8_t strips)
+{
+	uint32_t total = 0;
+	for (uint8_t i = 0; i < getNumStrips(); i++)
+	{
+		if((strips & (1 << i)) == 0)
+		{
+			continue;
+		}
+		uint32_t stripTime = (uint32_t)getNumLeds(i) * LED_WIRE_TIME_PER_LED_US + LED_LATCH_TIME_US;
+		if(isConcurrent() == true)
+		{
+			total = stripTime > total ? stripTime : total;
+		}
+		else
+		{
+			total += stripTime;
+		}
+	}
+	return total;
+}
+
+FastLEDOutput::FastLEDOutput()
+{
+	numStrips = 0;
+}
+
+uint8_t FastLEDOutput::addStrip(CLEDController* controller)
+{
+	if(numStrips >= ANIMATOR_MAX_LED_STRIPS)
+	{
+		Serial.printf("[E] FastLEDOutput can only drive %d LED strips\n\r", ANIMATOR_MAX_LED_STRIPS);
+		return ANIMATOR_MAX_LED_STRIPS - 1;
+	}
+	strips[numStrips] = controller;
+	return numStrips++;
+}
+
+uint16_t FastLEDOutput::getNumLeds(uint8_t strip)
+{
+	return strip < numStrips ? strips[strip]->size() : 0;
+}
+
+void FastLEDOutput::show(uint8_t strips, uint8_t brightness)
+{
+	//several strips go out in parallel, so sending the unchanged ones along costs no extra time. Only a single strip out of many is sent on its own
+	if((strips & (strips - 1)) != 0 || numStrips == 1)
+	{
+		FastLED.show(brightness);
+		return;
+	}
+	for (uint8_t i = 0; i < numStrips; i++)
+	{
+		if(strips & (1 << i))
+		{
+			this->strips[i]->showLeds(brightness);
+		}
+	}
+}
@@ -0,0 +1,81 @@
+/**
+ * \file MockLEDOutput.cpp
+ * \author Florian Laschober
+ * \brief Implementation of the member functions of the MockLEDOutput class
+ */
+
+#include "MockLEDOutput.h"
+
+MockLEDOutput::MockLEDOutput(bool concurrentStrips)
+{
+	numStrips = 0;
+	concurrent = concurrentStrips;
+	reset();
+}
+
+uint8_t MockLEDOutput::addStrip(const CRGB* leds, uint16_t numLeds)
+{
+	if(numStrips >= ANIMATOR_MAX_LED_STRIPS)
+	{
+		Serial.printf("[E] MockLEDOutput can only record %d LED strips\n\r", ANIMATOR_MAX_LED_STRIPS);
+		return ANIMATOR_MAX_LED_STRIPS - 1;
+	}
+	strips[numStrips].leds = leds;
+	strips[numStrips].numLeds = numLeds;
+	strips[numStrips].frames = 0;
+	strips[numStrips].checksum = 0;
+	return numStrips++;
+}
+
+uint16_t MockLEDOutput::getNumLeds(uint8_t strip)
+{
+	return strip < numStrips ? strips[strip].numLeds : 0;
+}
+
+void MockLEDOutput::show(uint8_t strips, uint8_t brightness)
+{
+	for (uint8_t i = 0; i < numStrips; i++)
+	{
+		if((strips & (1 << i)) == 0)
+		{
+			continue;
+		}
+		Strip& strip = this->strips[i];
+		const uint8_t* data = (const uint8_t*)strip.leds;
+		uint32_t checksum = 2166136261u;
+		for (uint32_t j = 0; j < strip.numLeds * sizeof(CRGB); j++)
+		{
+			checksum = (checksum ^ data[j]) * 16777619u;
+		}
+		strip.checksum = checksum;
+		strip.frames++;
+	}
+	uint32_t wireTime = getWireTime(strips);
+	totalWireTime += wireTime;
+	maxWireTime = wireTime > maxWireTime ? wireTime : maxWireTime;
+	lastBrightness = brightness;
+	frames++;
+}
+
+void MockLEDOutput::reset()
+{
+	for (uint8_t i = 0; i < numStrips; i++)
+	{
+		strips[i].frames = 0;
+		strips[i].checksum = 0;
+	}
+	frames = 0;
+	totalWireTime = 0;
+	maxWireTime = 0;
+	lastBrightness = 0;
+}
+
+uint32_t MockLEDOutput::getFrameCount(uint8_t strip)
+{
+	return strip < numStrips ? strips[strip].frames : 0;
+}
+
+uint32_t MockLEDOutput::getChecksum(uint8_t strip)
+{
+	return strip < numStrips ? strips[strip].checksum : 0;
+}
@@ -97,14 +97,8 @@ void ClockState::handleStates()
 			ShelfDisplays->displayTimer(currentTime.hours, currentTime.minutes, currentTime.seconds);
 		break;
 		case ClockState::TIMER_NOTIFICATION:
-			if(currentAlarmSignalState == true)
-			{
-				ShelfDisplays->setGlobalBrightness(NOTIFICATION_BRIGHTNESS, false);
-			}
-			else
-			{
-				ShelfDisplays->setGlobalBrightness(0, false);
-			}
+			//flash an overlay on top of the digits and the downlights, the brightness and the running animations stay untouched
+			ShelfDisplays->setOverlay(DisplayManager::NOTIFICATION_LAYER, NOTIFICATION_OVERLAY_COLOR, currentAlarmSignalState ? 0 : NOTIFICATION_OVERLAY_OPACITY, DisplayManager::BLEND_NORMAL, DisplayManager::TARGET_DIGITS | DisplayManager::TARGET_DOWNLIGHTS);
 			currentAlarmSignalState = !currentAlarmSignalState;
 			alarmToggleCount++;
 			#if TIMER_FLASH_TIME == true
@@ -114,26 +108,20 @@ void ClockState::handleStates()
 			#endif
 			if(alarmToggleCount >= TIMER_FLASH_COUNT)
 			{
-				ShelfDisplays->setGlobalBrightness(clockBrightness);
+				ShelfDisplays->setLayer(DisplayManager::NOTIFICATION_LAYER, 0);
 				ShelfDisplays->displayTime(currentTime.hours, currentTime.minutes);
 				alarmToggleCount = 0;
 				MainState = ClockState::CLOCK_MODE;
 			}
 		break;
 		case ClockState::ALARM_NOTIFICATION:
-			if(currentAlarmSignalState == true)
-			{
-				ShelfDisplays->setGlobalBrightness(NOTIFICATION_BRIGHTNESS, false);
-			}
-			else
-			{
-				ShelfDisplays->setGlobalBrightness(0, false);
-			}
+			//flash an overlay on top of the digits and the downlights, the brightness and the running animations stay untouched
+			ShelfDisplays->setOverlay(DisplayManager::NOTIFICATION_LAYER, NOTIFICATION_OVERLAY_COLOR, currentAlarmSignalState ? 0 : NOTIFICATION_OVERLAY_OPACITY, DisplayManager::BLEND_NORMAL, DisplayManager::TARGET_DIGITS | DisplayManager::TARGET_DOWNLIGHTS);
 			currentAlarmSignalState = !currentAlarmSignalState;
 			ShelfDisplays->displayTime(currentTime.hours, currentTime.minutes);
 			if(!timeM->isAlarmActive())
 			{
-				ShelfDisplays->setGlobalBrightness(clockBrightness);
+				ShelfDisplays->setLayer(DisplayManager::NOTIFICATION_LAYER, 0);
 				MainState = ClockState::CLOCK_MODE;
 			}
 		break;
@@ -0,0 +1,72 @@
+/**
+ * \file BrightnessLevel.h
+ * \author Florian Laschober
+ * \brief Eased brightness level that is applied to base colors at output time
+ */
+
+#ifndef __BRIGHTNESS_LEVEL_H_
+#define __BRIGHTNESS_LEVEL_H_
+
+#include <Arduino.h>
+#define FASTLED_INTERNAL
+#include "FastLED.h"
+#include "EasedTransition.h"
+
+/**
+ * \brief Brightness level of a group of LEDs which moves to a new level over time. The colors of the LEDs are stored at full
+ * 		  brightness and only scaled by the level when they are written to the output, so dimming never changes the stored colors.
+ * 		  The level is mapped to the scale through a gamma corrected lookup table, see #BrightnessLevel::buildScaleTable.
+ * 		  Everything after building the table is integer math. Starting, stopping and advancing the transition is done by #EasedTransition.
+ */
+class BrightnessLevel : public EasedTransition<BrightnessLevel, uint8_t>
+{
+private:
+	friend class EasedTransition<BrightnessLevel, uint8_t>;
+
+	/**
+	 * \brief Scale applied to the LEDs for every level
+	 */
+	static uint8_t scaleTable[256];
+
+	/**
+	 * \brief Level at the eased progress, easings that overshoot must not wrap around the ends of the level
+	 */
+	static uint8_t interpolate(uint8_t from, uint8_t to, AnimatableObject::AnimationProgress progress);
+
+public:
+	/**
+	 * \brief Construct a new BrightnessLevel object which is not running
+	 *
+	 * \param initialLevel level before the first change
+	 */
+	BrightnessLevel(uint8_t initialLevel = 255);
+
+	/**
+	 * \brief Fill the lookup table from level to scale. Has to be called once before the first scale is read.
+	 * 		  Every level above 0 maps to a scale of at least 1 so a dimmed channel never turns off completely.
+	 *
+	 * \param gamma exponent of the curve, 1.0 is linear
+	 */
+	static void buildScaleTable(double gamma);
+
+	/**
+	 * \brief Level at the moment of the last update
+	 */
+	uint8_t getLevel() const { return current; }
+
+	/**
+	 * \brief Gamma corrected scale of the current level
+	 */
+	uint8_t getScale() const { return scaleTable[current]; }
+
+	/**
+	 * \brief Render a base color at the given scale. A scale of 255 returns the color unchanged,
+	 * 		  any other scale keeps channels that are not 0 lit.
+	 */
+	static CRGB apply(CRGB base, uint8_t scale)
+	{
+		return base.nscale8_video(scale);
+	}
+};
+
+#endif
@@ -15,14 +15,32 @@
 #include "SevenSegment.h"
 #include "TimeManager.h"
 #include "Configuration.h"
+#include "ColorFade.h"
+#include "BrightnessLevel.h"
+#include "PowerEstimator.h"
+#include "StreamingFilter.h"
+#include "SpatialEffects.h"
 #include "LinkedList.h"
+#include "DisplayConfiguration.h"
 #include "Animations.h"
 
+#if defined(NATIVE_BUILD)
+	// there is no FreeRTOS on the host, frames are rendered from DisplayManager::handle() instead
+	#undef USE_RENDER_TASK
+	#define USE_RENDER_TASK false
+#endif
+
 /**
  * \brief Macro to shorten the name of the function to make usage easier in the animation config files.
  */
 #define SEGMENT(POSITION, DISPLAY)		DisplayManager::getGlobalSegmentIndex(POSITION, DISPLAY)
 
+/**
+ * \brief Event bits set by the render task once an animation somebody waits for is done
+ */
+#define RENDER_EVENT_LOADING_ANIMATION_DONE		(1 << 0)
+#define RENDER_EVENT_ALL_ANIMATIONS_DONE		(1 << 1)
+
 /**
  * \brief The display manager is responsible to Manage all displays.
  *        It holds an instance to every display avaliable on the clock and manages the
@@ -31,15 +49,65 @@
  */
 class DisplayManager
 {
+public:
+	/**
+	 * \brief Layers of the compositor, they are combined in this order from the bottom to the top
+	 */
+	enum CompositorLayerID {
+		DIGIT_LAYER,		/** content of all segments */
+		DOWNLIGHT_LAYER,	/** content of the downlights */
+		OVERLAY_LAYER,		/** general purpose overlay, also shows the spatial effects */
+		NOTIFICATION_LAYER,	/** overlay used by the timer and alarm notifications */
+		NUM_COMPOSITOR_LAYERS
+	};
+
+	/**
+	 * \brief How a layer is combined with everything below it. The result is mixed with what is below by the opacity of the layer.
+	 */
+	enum BlendMode {
+		BLEND_NORMAL,	/** the layer replaces what is below */
+		BLEND_ADD,		/** the layer is added to what is below */
+		BLEND_MULTIPLY,	/** what is below is scaled by the layer, a dark layer dims it */
+		BLEND_TINT		/** what is below takes the color of the layer but keeps its brightness, LEDs that are off stay off */
+	};
+
+	/**
+	 * \brief Independent brightness channels, applied on top of the global brightness when the layers are combined
+	 */
+	enum BrightnessChannel {
+		HOUR_BRIGHTNESS,
+		MINUTE_BRIGHTNESS,
+		DOWNLIGHT_BRIGHTNESS,
+		NUM_BRIGHTNESS_CHANNELS
+	};
+
+	/**
+	 * \brief LEDs a layer is applied to, can be combined
+	 */
+	enum LayerTarget {
+		TARGET_DIGITS = 1 << 0,
+		TARGET_DOWNLIGHTS = 1 << 1
+	};
+
 private:
-	//segment configurations
-	static SevenSegment::SegmentPosition SegmentPositions[NUM_SEGMENTS];
-	static Segment::direction SegmentDirections[NUM_SEGMENTS];
-	static SevenSegment::SevenSegmentMode SegmentDisplayModes[NUM_DISPLAYS];
-	static uint8_t displayIndex[NUM_SEGMENTS];
+	/**
+	 * \brief One layer of the compositor. The base layers take their content from the back buffers, overlays are a solid color,
+	 * 		  a color per range of the front buffers or take it from a buffer that covers the digits.
+	 */
+	struct CompositorLayer {
+		const CRGB* source;
+		const CRGB* rangeColors;
+		CRGB color;
+		uint8_t opacity;
+		BlendMode mode;
+		uint8_t targets;
+	};
+
 	static DisplayManager* instance;
 
 	Animator* animationManager;
+	uint8_t clockLEDStrip;
+	uint8_t downlightLEDStrip;
 	Segment* allSegments[NUM_SEGMENTS];
 	SevenSegment* Displays[NUM_DISPLAYS];
 	uint8_t currentLEDBrightness;
@@ -47,30 +115,220 @@ private:
 	uint8_t LEDBrightnessSetPoint;
 	uint8_t LEDBrightnessCurrent;
 	uint64_t lastBrightnessChange;
-    CubicEase* lightSensorEasing;
-	Animator::ComplexAnimationInstance* loadingAnimationID;
+	ColorFade downlightColor;
+	bool colorFadesRunning;
+
+	/**
+	 * \brief Level of every brightness channel. Together with the colors of the segments and the downlights they
+	 * 		  form the (base color, level) pairs that are combined in #DisplayManager::composeLayers
+	 */
+	BrightnessLevel channels[NUM_BRIGHTNESS_CHANNELS];
+	bool channelTransitionsRunning;
+
+	/**
+	 * \brief Gamma corrected scale of every channel and of every segment, kept up to date by #DisplayManager::applyChannelBrightness
+	 */
+	uint8_t channelScales[NUM_BRIGHTNESS_CHANNELS];
+	uint8_t segmentScales[NUM_SEGMENTS];
+
+	/**
+	 * \brief Current draw of the front buffers, updated for every strip that is composed. Replaces the power limit of FastLED
+	 * 		  which scanned all LEDs on every show.
+	 */
+	PowerEstimator powerEstimator;
+
+	/**
+	 * \brief Ranges of the front buffers (one per segment and one for the downlights, the same as the ranges of the #PowerEstimator)
+	 * 		  that have to be composed again although their segment did not write its LEDs, e.g. because their brightness or a layer changed
+	 */
+	bool rangeDirty[POWER_ESTIMATOR_RANGES];
+	Animator::ComplexAnimationID loadingAnimationID;
 
 	uint32_t progressTotal;
 	uint32_t currentProgressOffset;
 	uint8_t currentProgressStep;
-	Animator::ComplexAnimationInstance* loadingAnimationInst;
+	Animator::ComplexAnimationID loadingAnimationInst;
 
-	typedef struct {
-		SegmentPositions_t segmentPosition;
-		DisplayIDs Display;
-	} SegmentInstanceError;
-	static LinkedList<SegmentInstanceError>* SegmentIndexErrorList;
+	unsigned long lastFrameTime;
 
+	/**
+	 * \brief Back buffers, all segments and setters write here. The compositor combines them with the overlays
+	 * 		  into the front buffers at frame boundaries.
+	 */
 	CRGB leds[NUM_LEDS];
 	#if APPEND_DOWN_LIGHTERS == false
 		CRGB DownlightLeds[ADDITIONAL_LEDS];
 	#endif
 
+	/**
+	 * \brief Part of the back buffers that holds the downlights, either appended to the clock LEDs or their own buffer
+	 */
+	CRGB* downlightBuffer;
+
+	/**
+	 * \brief Front buffers which hold the output of the compositor and get pushed out to the LEDs
+	 */
+	CRGB frontLeds[NUM_LEDS];
+	#if APPEND_DOWN_LIGHTERS == false
+		CRGB frontDownlightLeds[ADDITIONAL_LEDS];
+	#endif
+
+	CompositorLayer layers[NUM_COMPOSITOR_LAYERS];
+
+	/**
+	 * \brief Colors of the overlays per range of the front buffers, see #DisplayManager::setDisplayOverlay
+	 */
+	CRGB overlayRangeColors[NUM_COMPOSITOR_LAYERS - OVERLAY_LAYER][POWER_ESTIMATOR_RANGES];
+
+	/**
+	 * \brief The spatial effects are rendered here and shown by the #OVERLAY_LAYER
+	 */
+	CRGB effectLeds[SPATIAL_NUM_LEDS];
+	AnimatableObject* spatialEffect;
+
+	#if USE_RENDER_TASK == true
+		SemaphoreHandle_t renderMutex;
+		TaskHandle_t renderTaskHandle;
+		EventGroupHandle_t renderEvents;
+
+		static void renderTask(void* parameter);
+		static void loadingAnimationDoneCallback(void* context);
+		static void allAnimationsDoneCallback(void* context);
+
+		/**
+		 * \brief Create the render task. Called once the segments are initialized
+		 */
+		void startRenderTask();
+	#endif
+
+	/**
+	 * \brief Holds the render lock for as long as it exists. Every public function that touches the back buffers
+	 * 		  or the animation state takes it so the render task never sees a half done update.
+	 * 		  Does nothing as long as the render task is not running.
+	 */
+	class RenderLock
+	{
+	private:
+		DisplayManager* owner;
+	public:
+		RenderLock(DisplayManager* displayManager);
+		~RenderLock();
+	};
+
+	/**
+	 * \brief true if the LEDs are updated by the render task and not by #DisplayManager::handle
+	 */
+	bool isRenderTaskRunning();
+
+	/**
+	 * \brief Advance the brightness easing (and light sensor) by one step
+	 */
+	void updateBrightness();
+
+	/**
+	 * \brief Advance all running color crossfades by one step, see #COLOR_FADE_DURATION.
+	 * 		  Only touches the segments and downlights while a fade is actually running.
+	 */
+	void updateColorFades();
+
+	/**
+	 * \brief Advance the eased transitions of the brightness channels by one step, see #CHANNEL_BRIGHTNESS_INTERPOLATION
+	 */
+	void updateChannelBrightness();
+
+	/**
+	 * \brief Look up the scale of the current level of a channel and flag the LEDs it belongs to as changed
+	 */
+	void applyChannelBrightness(BrightnessChannel channel);
+
+	/**
+	 * \brief Brightness channel a segment belongs to, derived from the display it is part of
+	 */
+	static constexpr BrightnessChannel getBrightnessChannel(uint16_t segment)
+	{
+		return DisplayConfiguration::displayIndex[segment] == LOWER_DIGIT_HOUR_DISPLAY || DisplayConfiguration::displayIndex[segment] == HIGHER_DIGIT_HOUR_DISPLAY ? HOUR_BRIGHTNESS : MINUTE_BRIGHTNESS;
+	}
+
+	/**
+	 * \brief Compose the changed back buffers into the front buffers under the render lock and push them out to the LEDs
+	 */
+	void presentFrame();
+
+	/**
+	 * \brief Combine one base layer, scaled by its brightness channels, and all overlays on top of it into the output in a single pass.
+	 * 		  Only runs of LEDs whose segment changed or whose range is flagged in #DisplayManager::rangeDirty are composed and
+	 * 		  report their new load, all others keep their output. An overlay with its own buffer changes every LED, so it composes all runs.
+	 * 		  Falls back to a plain copy where the base layer is fully opaque and at full brightness and no overlay is visible.
+	 *
+	 * \param output front buffer to write
+	 * \param input back buffer holding the content of the base layer
+	 * \param numLeds number of LEDs to compose
+	 * \param baseLayer #DIGIT_LAYER or #DOWNLIGHT_LAYER
+	 * \param scales brightness scale of every run of LEDs
+	 * \param ledsPerScale number of LEDs that share one scale
+	 * \param firstPowerRange range of the #PowerEstimator the first run of LEDs reports its load to, every following run uses the next one
+	 */
+	void composeLayers(CRGB* output, const CRGB* input, uint16_t numLeds, CompositorLayerID baseLayer, const uint8_t* scales, uint16_t ledsPerScale, uint8_t firstPowerRange);
+
+	/**
+	 * \brief Flag the LED strips a layer is applied to and all their ranges as changed
+	 */
+	void markLayerDirty(uint8_t targets);
+
+	/**
+	 * \brief Combine a layer with what is below it
+	 *
+	 * \param below result of all layers below
+	 * \param layer color of the layer
+	 * \param mode how to combine the two
+	 * \param opacity 0 leaves below untouched, 255 applies the layer fully
+	 */
+	static CRGB blendLayer(CRGB below, CRGB layer, BlendMode mode, uint8_t opacity);
+
+	/**
+	 * \brief Hides the #OVERLAY_LAYER once a spatial effect finished
+	 */
+	static void spatialEffectDoneCallback();
+
+	/**
+	 * \brief Calls #DisplayManager::presentFrame if no render task is running and the last frame is at least one frame of the #Animator ago (#Animator::getFramePeriod)
+	 */
+	void presentFrameIfDue();
+
 	#if ENABLE_LIGHT_SENSOR == true
-		LinkedList<uint16_t> lightSensorMeasurements;
-		uint64_t lastSensorMeasurement;
+		/**
+		 * \brief Last #LIGHT_SENSOR_AVERAGE readings of the light sensor, only touched by the sampler
+		 */
+		StreamingFilter<LIGHT_SENSOR_AVERAGE> lightSensorFilter;
+		uint64_t lastSensorMeasurement; // only used while reading the sensor from the render loop
+
+		/**
+		 * \brief Brightness reduction the sampler computed from the filtered readings, applied by #DisplayManager::updateBrightness
+		 */
+		volatile uint8_t lightSensorTarget;
 		uint8_t lightSensorBrightness;
+
+		/**
+		 * \brief Read the light sensor once and update #DisplayManager::lightSensorTarget from the filtered readings
+		 */
 		void takeBrightnessMeasurement();
+
+		#if !defined(NATIVE_BUILD)
+			TaskHandle_t lightSensorTaskHandle;
+
+			/**
+			 * \brief Samples the light sensor in the background so the ADC reads never delay a frame
+			 */
+			static void lightSensorTask(void* parameter);
+		#endif
+
+		/**
+		 * \brief Start the background sampler. Called once the segments are initialized, not from the constructor which runs
+		 * 		  during static initialization before setup(). If there is none the sensor is read from #DisplayManager::updateBrightness instead
+		 */
+		void startLightSensorSampler();
+
+		bool isLightSensorSamplerRunning();
 	#endif
 
 	//void AnimationManagersTemporaryOverride(Animator* OverrideanimationManager);
@@ -91,7 +349,7 @@ public:
 	static DisplayManager* getInstance();
 
 	/**
-	 * \brief Initialize all the segment using the configuration from \ref DisplayConfiguration.cpp
+	 * \brief Initialize all the segment using the configuration from \ref DisplayConfiguration.h
 	 * \param indexOfFirstLed 	Index of the first led in the string that is part of a segment (usually 0)
 	 * \param ledsPerSegment 	Sets the number of LEDs that are in one segment. this will be the same for all segments
 	 * \param initialColor 		Sets the initial color of all the segments. This does not switch any segments on by it's own
@@ -100,29 +358,33 @@ public:
 	void InitSegments(uint16_t indexOfFirstLed, uint8_t ledsPerSegment, CRGB initialColor, uint8_t initBrightness = 128);
 
 	/**
-	 * \brief Sets the color of all segments and updates it immediately for all segments that are currently switched on
+	 * \brief Sets the color of all segments and crossfades all segments that are currently switched on to it
 	 * \param color Color to set the LEDs to
+	 * \param enableSmoothTransition [optional] default = true; false to change the color immediately instead of fading over #COLOR_FADE_DURATION
 	 */
-	void setAllSegmentColors(CRGB color);
+	void setAllSegmentColors(CRGB color, bool enableSmoothTransition = true);
 
 	/**
-	 * \brief Sets the color of the the segments which are displaying hours and updates it immediately for all segments that are currently switched on
+	 * \brief Sets the color of the the segments which are displaying hours and crossfades all segments that are currently switched on to it
 	 * \param color Color to set the LEDs to
+	 * \param enableSmoothTransition [optional] default = true; false to change the color immediately instead of fading over #COLOR_FADE_DURATION
 	 */
-	void setHourSegmentColors(CRGB color);
+	void setHourSegmentColors(CRGB color, bool enableSmoothTransition = true);
 
 	/**
-	 * \brief Sets the color of the the segments which are displaying minutes and updates it immediately for all segments that are currently switched on
+	 * \brief Sets the color of the the segments which are displaying minutes and crossfades all segments that are currently switched on to it
 	 * \param color Color to set the LEDs to
+	 * \param enableSmoothTransition [optional] default = true; false to change the color immediately instead of fading over #COLOR_FADE_DURATION
 	 */
-	void setMinuteSegmentColors(CRGB color);
+	void setMinuteSegmentColors(CRGB color, bool enableSmoothTransition = true);
 
 	/**
-	 * \brief Sets the color of a single segment and updates it immediately 
+	 * \brief Sets the color of a single segment and crossfades it to that color
 	 * \segment int Segment index to set color for
 	 * \param color Color to set the LEDs to
+	 * \param enableSmoothTransition [optional] default = true; false to change the color immediately instead of fading over #COLOR_FADE_DURATION
 	 */
-	void setSegmentColor(int segment, CRGB color);
+	void setSegmentColor(int segment, CRGB color, bool enableSmoothTransition = true);
 
 	/**
 	 * \brief Displays the numbers given as they are on the respective displays
@@ -149,14 +411,24 @@ public:
 	void displayTimer(uint8_t hours, uint8_t minutes, uint8_t seconds);
 
 	/**
-	 * \brief Has to be called cyclicly in the loop to enable live updating of the LEDs
+	 * \brief Has to be called cyclicly in the loop to enable live updating of the LEDs. Renders at most one frame
+	 * 		  every #Animator::getFramePeriod, calls in between return right away.
+	 * 		  Does nothing while the render task (#USE_RENDER_TASK) is running as it updates the LEDs on its own.
 	 */
 	void handle();
 
 	/**
-	 * \brief Sets the color of the interrior LEDs and displays it immediately
+	 * \brief Sleep until the next frame is due. Call it at the end of the loop so it does not spin faster than the display is updated.
+	 * 		  Returns right away while the render task (#USE_RENDER_TASK) is running, the loop is not tied to the frames then.
+	 */
+	void waitForNextFrame();
+
+	/**
+	 * \brief Sets the color of the interrior LEDs and crossfades them to it
+	 * \param color Color to set the LEDs to
+	 * \param enableSmoothTransition [optional] default = true; false to change the color immediately instead of fading over #COLOR_FADE_DURATION
 	 */
-	void setInternalLEDColor(CRGB color);
+	void setInternalLEDColor(CRGB color, bool enableSmoothTransition = true);
 
 
 	/**
@@ -177,9 +449,19 @@ public:
 
 	/**
 	 * \brief Wait until the currently set complex animation is finished.
+	 * 		  While the render task is running the caller is suspended until the animation signals its completion.
+	 * 		  Gives up after #ANIMATION_WAIT_TIMEOUT_MS.
 	 */
 	void waitForLoadingAnimationFinish();
 
+	/**
+	 * \brief Wait until all currently playing complex animations (e.g. digit transitions) are finished.
+	 * 		  Looping animations are stopped after their current cycle, otherwise they would never finish.
+	 * 		  While the render task is running the caller is suspended until the last animation signals its completion.
+	 * 		  Gives up after #ANIMATION_WAIT_TIMEOUT_MS.
+	 */
+	void waitForAnimations();
+
 	/**
 	 * \brief Turns all displays off completely, Does not affect interior lights
 	 */
@@ -205,6 +487,7 @@ public:
 
 	/**
 	 * \brief Use this delay instead of the Arduino delay to enable Display updates during the delay.
+	 * 		  While the render task is running this just sleeps and leaves the CPU to other tasks.
 	 * \param timeInMs Delay time in ms
 	 */
 	void delay(uint32_t timeInMs);
@@ -216,6 +499,108 @@ public:
 	 */
 	void setGlobalBrightness(uint8_t brightness, bool enableSmoothTransition = true);
 
+	/**
+	 * \brief Sets the speed of the digit transitions and the loading animation, takes effect with the next animation step
+	 * \param percent speed relative to #DIGIT_ANIMATION_SPEED and #LOADING_ANIMATION_DURATION, 100 is the configured speed, see #Animator::setAnimationSpeed
+	 */
+	void setAnimationSpeed(uint16_t percent);
+
+	/**
+	 * \brief Speed of the digit transitions and the loading animation as it is used, limited to #ANIMATOR_MIN_SPEED...#ANIMATOR_MAX_SPEED
+	 *
+	 * \return uint16_t speed in percent, see #DisplayManager::setAnimationSpeed
+	 */
+	uint16_t getAnimationSpeed();
+
+	/**
+	 * \brief Change the level of one brightness channel. The stored colors are not touched, the level is applied through a
+	 * 		  gamma corrected lookup table when the layers are combined.
+	 * \param channel channel to change
+	 * \param level 0 turns the channel off, 255 is full brightness
+	 * \param enableSmoothTransition [optional] default = true; false to change the level immediately instead of easing over #CHANNEL_BRIGHTNESS_INTERPOLATION
+	 */
+	void setChannelBrightness(BrightnessChannel channel, uint8_t level, bool enableSmoothTransition = true);
+
+	/**
+	 * \brief Level a brightness channel is set to or easing towards
+	 */
+	uint8_t getChannelBrightness(BrightnessChannel channel);
+
+	/**
+	 * \brief Estimated current the LEDs draw with the last frame that was shown, including the reduction to stay within #MAX_MILLIAMPS
+	 *
+	 * \return uint32_t current in mA
+	 */
+	uint32_t getEstimatedMilliamps();
+
+	/**
+	 * \brief Change the opacity and blend mode of a layer. The layers are combined once per frame, so this neither touches
+	 * 		  the back buffers nor disturbs running animations.
+	 * \param layer layer to change
+	 * \param opacity 0 hides the layer, 255 applies it fully
+	 * \param mode how the layer is combined with the layers below it
+	 */
+	void setLayer(CompositorLayerID layer, uint8_t opacity, BlendMode mode = BLEND_NORMAL);
+
+	/**
+	 * \brief Show a solid color overlay on top of the digits and/or the downlights
+	 * \param layer #OVERLAY_LAYER or #NOTIFICATION_LAYER
+	 * \param color color of the overlay
+	 * \param opacity 0 hides the overlay, 255 applies it fully
+	 * \param mode how the overlay is combined with the layers below it
+	 * \param targets combination of #LayerTarget the overlay is applied to
+	 */
+	void setOverlay(CompositorLayerID layer, CRGB color, uint8_t opacity, BlendMode mode = BLEND_NORMAL, uint8_t targets = TARGET_DIGITS);
+
+	/**
+	 * \brief Show an overlay with its own color on every display, e.g. to tell the displays apart in test mode.
+	 * 		  Does nothing if the overlay already shows exactly this, so it can be called repeatedly.
+	 * \param layer #OVERLAY_LAYER or #NOTIFICATION_LAYER
+	 * \param displayColors color of the overlay on each display, in the order of #DisplayConfiguration::displayIndex
+	 * \param opacity 0 hides the overlay, 255 applies it fully
+	 * \param mode [optional] default = #BLEND_TINT; how the overlay is combined with the layers below it
+	 */
+	void setDisplayOverlay(CompositorLayerID layer, const CRGB displayColors[NUM_DISPLAYS], uint8_t opacity, BlendMode mode = BLEND_TINT);
+
+	/**
+	 * \brief Play an effect across all digits of the shelf, see #SpatialEffects. The effect is rendered once per frame into its own buffer
+	 * 		  and combined with the digits by the #OVERLAY_LAYER, which is hidden again once the effect finished.
+	 * 		  Replaces a spatial effect that is still playing.
+	 *
+	 * \tparam Effect type of the effect, for example #SpatialEffects::Sweep
+	 * \param effect effect to play
+	 * \param duration duration of the effect in ms
+	 * \param mode [optional] default = #BLEND_NORMAL; how the effect is combined with the digits
+	 * \param opacity [optional] default = 255; opacity of the effect
+	 * \param easing [optional] default = #NO_EASING; Easing applied to the time of the effect
+	 */
+	template<typename Effect>
+	void playSpatialEffect(const Effect& effect, uint32_t duration, BlendMode mode = BLEND_NORMAL, uint8_t opacity = 255, const EasingBase* easing = NO_EASING)
+	{
+		//one animation per effect type, so playing an effect never allocates
+		static SpatialAnimation<Effect> animation(effect, effectLeds, animationManager, clockLEDStrip);
+		RenderLock lock(this);
+		stopSpatialEffect();
+		animation.setEffect(effect);
+		animation.setAnimationDoneCallback(&spatialEffectDoneCallback);
+		animationManager->add(&animation);
+		spatialEffect = &animation;
+
+		//a solid overlay could have covered other LEDs than the effect, they have to be composed again without it
+		markLayerDirty(layers[OVERLAY_LAYER].targets | TARGET_DIGITS);
+		layers[OVERLAY_LAYER].source = effectLeds;
+		layers[OVERLAY_LAYER].rangeColors = nullptr;
+		layers[OVERLAY_LAYER].opacity = opacity;
+		layers[OVERLAY_LAYER].mode = mode;
+		layers[OVERLAY_LAYER].targets = TARGET_DIGITS;
+		animationManager->startAnimation(&animation, NO_ANIMATION, duration, easing);
+	}
+
+	/**
+	 * \brief Stop the spatial effect that is playing and hide the #OVERLAY_LAYER
+	 */
+	void stopSpatialEffect();
+
 	/**
 	 * \brief Calling the Flash dot animation for the appropriate segments in the middle of the clock face
 	 */
@@ -234,22 +619,28 @@ public:
     /**
      * \brief get the index of a segment in regards to it's position on the clock face.
      *  	  This makes writing animations a lot easier as it will act as an abstraction layer between the animation
-     *        config and the display config
+     *        config and the display config.
+     *        Evaluated at compile time when used in a constexpr animation table, a segment that is not part of the
+     *        display configuration then fails the build because #DisplayManager::segmentNotFound is not constexpr.
      *
      * \param segmentPosition Position of a segment in the seven segment display
      * \param Display Which display should be targeted
-     * \return int16_t index of the Segment in the #DisplayManager::SegmentPositions array
+     * \param startIndex Index of #DisplayConfiguration::SegmentPositions to start searching from, used for the recursion
+     * \return int16_t index of the Segment in the #DisplayConfiguration::SegmentPositions array
      */
-	static int16_t getGlobalSegmentIndex(SegmentPositions_t segmentPosition, DisplayIDs Display);
+	static constexpr int16_t getGlobalSegmentIndex(SegmentPositions_t segmentPosition, DisplayIDs Display, uint16_t startIndex = 0)
+	{
+		return startIndex >= NUM_SEGMENTS ? segmentNotFound(segmentPosition, Display) :
+			(DisplayConfiguration::displayIndex[startIndex] == Display && DisplayConfiguration::SegmentPositions[startIndex] == (1 << segmentPosition)) ? startIndex :
+			getGlobalSegmentIndex(segmentPosition, Display, startIndex + 1);
+	}
 
     /**
-     * \brief Debugging function which will print out any errors that occurred when using the
-     *        #DisplayManager::getGlobalSegmentIndex function.
-     *        Especially useful for debugging weirdly behaving animations as animations will be configured before the
-     *        Serial connection is up. If an error was detected by the #DisplayManager::getGlobalSegmentIndex function a
-     *        message will be added to a buffer which can then be printed out using this function.
+     * \brief Report a segment that #DisplayManager::getGlobalSegmentIndex could not find when it is evaluated at runtime
+     *
+     * \return int16_t always #NO_SEGMENTS
      */
-	static void printAnimationInitErrors();
+	static int16_t segmentNotFound(SegmentPositions_t segmentPosition, DisplayIDs Display);
 };
 
 
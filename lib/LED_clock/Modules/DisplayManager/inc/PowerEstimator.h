@@ -0,0 +1,76 @@
+/**
+ * \file PowerEstimator.h
+ * \author Florian Laschober
+ * \brief Running estimate of the current drawn by the LEDs
+ */
+
+#ifndef __POWER_ESTIMATOR_H_
+#define __POWER_ESTIMATOR_H_
+
+#include <Arduino.h>
+#define FASTLED_INTERNAL
+#include "FastLED.h"
+#include "Configuration.h"
+
+/**
+ * \brief Number of LED ranges the estimate is split into: one per segment and one for the downlights
+ */
+#define POWER_ESTIMATOR_RANGES	(NUM_SEGMENTS + 1)
+
+/**
+ * \brief Keeps the current draw of all LEDs up to date without scanning the whole output on every show.
+ * 		  The LEDs are split into ranges and only the ranges that were rendered again report their new load.
+ * 		  The model is the same as the one of FastLED's power management, see #LED_MILLIAMPS_RED and the following.
+ */
+class PowerEstimator
+{
+private:
+	/**
+	 * \brief Load of every range at full brightness, in mA * 255
+	 */
+	uint32_t rangeLoad[POWER_ESTIMATOR_RANGES];
+	uint32_t totalLoad;
+	uint32_t idleMilliamps;
+	uint32_t maxMilliamps;
+
+public:
+	/**
+	 * \param numLeds number of LEDs on all strips, each of them draws #LED_MILLIAMPS_IDLE even when it is off
+	 * \param budget maximum current the LEDs may draw in mA
+	 */
+	PowerEstimator(uint16_t numLeds, uint32_t budget);
+
+	/**
+	 * \brief Load of a single LED at full brightness in mA * 255
+	 */
+	static uint32_t load(CRGB color)
+	{
+		return color.r * LED_MILLIAMPS_RED + color.g * LED_MILLIAMPS_GREEN + color.b * LED_MILLIAMPS_BLUE;
+	}
+
+	/**
+	 * \brief Load of a run of LEDs at full brightness in mA * 255
+	 */
+	static uint32_t load(const CRGB* leds, uint16_t numLeds);
+
+	/**
+	 * \brief Replace the load of one range after it was rendered again
+	 *
+	 * \param range index of the range, less than #POWER_ESTIMATOR_RANGES
+	 * \param load new load of the range as returned by #PowerEstimator::load
+	 */
+	void setRangeLoad(uint8_t range, uint32_t load);
+
+	/**
+	 * \brief Estimated current of all LEDs in mA when they are shown at the given global brightness
+	 */
+	uint32_t getMilliamps(uint8_t brightness) const;
+
+	/**
+	 * \brief Highest brightness up to the requested one at which the LEDs stay within the budget.
+	 * 		  Returns the requested brightness unchanged as long as the budget is not exceeded.
+	 */
+	uint8_t limitBrightness(uint8_t brightness) const;
+};
+
+#endif
@@ -0,0 +1,195 @@
+/**
+ * \file SpatialEffects.h
+ * \author Florian Laschober
+ * \brief Effects that are evaluated over the physical position of every LED of the shelf instead of along a single segment
+ */
+
+#ifndef __SPATIAL_EFFECTS_H_
+#define __SPATIAL_EFFECTS_H_
+
+#include <Arduino.h>
+#define FASTLED_INTERNAL
+#include "FastLED.h"
+#include "AnimatableObject.h"
+#include "Animator.h"
+#include "Configuration.h"
+
+/**
+ * \brief Number of LEDs in the coordinate map, these are all LEDs that belong to a segment
+ */
+#define SPATIAL_NUM_LEDS	(NUM_SEGMENTS * NUM_LEDS_PER_SEGMENT)
+
+/**
+ * \brief Renders effects across the whole shelf, for example waves, gradients or sweeps.
+ * 		  An effect is a small struct which is passed as template parameter, so it gets inlined into the render loop and there is
+ * 		  no indirect call per LED. It has to provide:
+ * 			- void setTime(uint8_t time): called once per frame before the LEDs are evaluated, 0 is the start and 255 the end of the effect
+ * 			- CRGB operator()(uint8_t x, uint8_t y) const: color of the LED at the given position
+ */
+class SpatialEffects
+{
+public:
+	/**
+	 * \brief Physical position of one LED. Both axes are scaled to 0...255 over the whole shelf, x grows to the right and y downwards.
+	 */
+	struct LEDCoordinate {
+		uint8_t x;
+		uint8_t y;
+	};
+
+	/**
+	 * \brief Position of every LED in the order they are wired in. Generated at compile time from the #DisplayConfiguration
+	 * 		  and placed in flash, see SpatialEffects.cpp
+	 */
+	static const LEDCoordinate* const coordinates;
+
+	/**
+	 * \brief Evaluate an effect for all LEDs of the coordinate map in one pass
+	 *
+	 * \param leds buffer of #SPATIAL_NUM_LEDS LEDs to write
+	 * \param effect effect to evaluate, the copy keeps the per frame state
+	 * \param progress progress of the effect as Q16.16 fixed point number, clamped to 0...#ANIMATION_PROGRESS_ONE
+	 */
+	template<typename Effect>
+	static void render(CRGB* leds, Effect effect, AnimatableObject::AnimationProgress progress)
+	{
+		effect.setTime(progress <= 0 ? 0 : progress >= ANIMATION_PROGRESS_ONE ? 255 : progress >> 8);
+		const LEDCoordinate* coordinate = coordinates;
+		for (uint16_t i = 0; i < SPATIAL_NUM_LEDS; i++, coordinate++)
+		{
+			leds[i] = effect(coordinate->x, coordinate->y);
+		}
+	}
+
+	/**
+	 * \brief Triangle wave with a period of 256, rises from 0 to 254 and falls back to 0
+	 */
+	static uint8_t triangle(uint8_t phase)
+	{
+		return phase < 128 ? phase << 1 : (255 - phase) << 1;
+	}
+
+	/**
+	 * \brief Vertical bar with soft edges which sweeps from outside the left end of the shelf to outside the right end
+	 */
+	struct Sweep {
+		CRGB color;
+		uint8_t width;
+		uint16_t falloff;
+		int16_t center;
+
+		/**
+		 * \param sweepColor color in the center of the bar
+		 * \param sweepWidth distance from the center at which the bar fades to black, 255 is the width of the shelf
+		 */
+		Sweep(CRGB sweepColor, uint8_t sweepWidth = 48) : color(sweepColor), width(sweepWidth > 0 ? sweepWidth : 1), falloff((255 << 8) / width), center(0) {}
+
+		void setTime(uint8_t time)
+		{
+			center = -width + time * (255 + 2 * width) / 255;
+		}
+
+		CRGB operator()(uint8_t x, uint8_t y) const
+		{
+			uint16_t distance = abs(x - center);
+			if(distance >= width)
+			{
+				return CRGB::Black;
+			}
+			return CRGB(color).nscale8_video(255 - ((distance * falloff) >> 8));
+		}
+	};
+
+	/**
+	 * \brief Horizontal wave of the color that travels to the right
+	 */
+	struct Wave {
+		CRGB color;
+		uint8_t waves;
+		uint8_t cycles;
+		uint8_t phase;
+
+		/**
+		 * \param waveColor color of the crests
+		 * \param numWaves number of crests across the shelf
+		 * \param numCycles number of wavelengths the wave travels over the duration of the effect
+		 */
+		Wave(CRGB waveColor, uint8_t numWaves = 2, uint8_t numCycles = 1) : color(waveColor), waves(numWaves), cycles(numCycles), phase(0) {}
+
+		void setTime(uint8_t time)
+		{
+			phase = time * cycles;
+		}
+
+		CRGB operator()(uint8_t x, uint8_t y) const
+		{
+			return CRGB(color).nscale8_video(triangle(x * waves - phase));
+		}
+	};
+
+	/**
+	 * \brief Gradient from one color on the left to another one on the right that scrolls across the shelf and back,
+	 * 		  starts and ends at the same state so it can be repeated seamlessly
+	 */
+	struct Gradient {
+		CRGB left;
+		CRGB right;
+		uint8_t offset;
+
+		Gradient(CRGB leftColor, CRGB rightColor) : left(leftColor), right(rightColor), offset(0) {}
+
+		void setTime(uint8_t time)
+		{
+			offset = time;
+		}
+
+		CRGB operator()(uint8_t x, uint8_t y) const
+		{
+			return blend(left, right, triangle((x >> 1) + offset));
+		}
+	};
+};
+
+/**
+ * \brief Plays a spatial effect over the duration of an animation of the #Animator. Every tick renders the effect into the buffer
+ * 		  and flags the LED strip as changed.
+ *
+ * \tparam Effect effect to render, see #SpatialEffects
+ */
+template<typename Effect>
+class SpatialAnimation : public AnimatableObject
+{
+private:
+	Effect effect;
+	CRGB* leds;
+	Animator* animator;
+	uint8_t LEDStrip;
+
+	void tick(AnimationProgress progress)
+	{
+		SpatialEffects::render(leds, effect, progress);
+		animator->markStripDirty(LEDStrip);
+	}
+
+public:
+	/**
+	 * \param spatialEffect effect to play
+	 * \param buffer buffer of #SPATIAL_NUM_LEDS LEDs the effect is rendered into
+	 * \param scheduler #Animator the animation is added to
+	 * \param stripID ID of the LED strip that shows the buffer, as returned by #Animator::addLEDStrip
+	 */
+	SpatialAnimation(const Effect& spatialEffect, CRGB* buffer, Animator* scheduler, uint8_t stripID) :
+		AnimatableObject(0, 0), effect(spatialEffect), leds(buffer), animator(scheduler), LEDStrip(stripID)
+	{
+	}
+
+	/**
+	 * \brief Change the parameters of the effect, also possible while it is playing
+	 */
+	void setEffect(const Effect& spatialEffect)
+	{
+		effect = spatialEffect;
+	}
+};
+
+#endif
@@ -0,0 +1,144 @@
+/**
+ * \file StreamingFilter.h
+ * \author Florian Laschober
+ * \brief Median and mean over a sliding window of samples without sorting on every sample
+ */
+
+#ifndef __STREAMING_FILTER_H_
+#define __STREAMING_FILTER_H_
+
+#include <Arduino.h>
+
+/**
+ * \brief Sliding window over the last samples, for example of the light sensor. Next to the samples in the order they arrived
+ * 		  the window is kept sorted. A new sample replaces the oldest one in place, so only the samples ranked between the two
+ * 		  have to move. For a slowly changing signal that is a few of them, never more than the window. The sum is kept running,
+ * 		  so the mean costs nothing. There are no allocations.
+ *
+ * \tparam WINDOW number of samples in the window
+ */
+template<uint16_t WINDOW>
+class StreamingFilter
+{
+private:
+	uint16_t samples[WINDOW];
+	uint16_t sorted[WINDOW];
+	uint16_t count;
+	uint16_t oldest;
+	uint32_t sum;
+
+	/**
+	 * \brief Position of the first sorted sample that is not smaller than the value
+	 */
+	uint16_t findSorted(uint16_t value) const
+	{
+		uint16_t low = 0;
+		uint16_t high = count;
+		while(low < high)
+		{
+			uint16_t middle = (low + high) / 2;
+			if(sorted[middle] < value)
+			{
+				low = middle + 1;
+			}
+			else
+			{
+				high = middle;
+			}
+		}
+		return low;
+	}
+
+public:
+	StreamingFilter()
+	{
+		reset();
+	}
+
+	/**
+	 * \brief Add a sample. Once the window is full the oldest sample is dropped.
+	 */
+	void add(uint16_t sample)
+	{
+		uint16_t position;
+		if(count < WINDOW)
+		{
+			samples[count] = sample;
+			position = count++;
+		}
+		else
+		{
+			uint16_t dropped = samples[oldest];
+			samples[oldest] = sample;
+			oldest = (oldest + 1) % WINDOW;
+			sum -= dropped;
+			position = findSorted(dropped);
+		}
+		sum += sample;
+		//move the samples ranked between the dropped and the new one by one position to close the gap
+		while(position + 1 < count && sorted[position + 1] < sample)
+		{
+			sorted[position] = sorted[position + 1];
+			position++;
+		}
+		while(position > 0 && sorted[position - 1] > sample)
+		{
+			sorted[position] = sorted[position - 1];
+			position--;
+		}
+		sorted[position] = sample;
+	}
+
+	/**
+	 * \brief Drop all samples
+	 */
+	void reset()
+	{
+		count = 0;
+		oldest = 0;
+		sum = 0;
+	}
+
+	uint16_t size() const { return count; }
+
+	bool isFull() const { return count == WINDOW; }
+
+	/**
+	 * \brief Mean of all samples in the window, 0 while it is empty
+	 */
+	uint16_t getMean() const
+	{
+		return count > 0 ? sum / count : 0;
+	}
+
+	/**
+	 * \brief Median of the samples in the window, the upper one of the two middle samples if the number of samples is even
+	 */
+	uint16_t getMedian() const
+	{
+		return count > 0 ? sorted[count / 2] : 0;
+	}
+
+	/**
+	 * \brief Mean of the samples around the median, outliers on both ends don't count.
+	 * 		  Falls back to the mean of all samples while there are not enough of them.
+	 *
+	 * \param width number of samples around the median to average
+	 */
+	uint16_t getMedianMean(uint16_t width) const
+	{
+		if(width == 0 || count < width)
+		{
+			return getMean();
+		}
+		uint16_t first = (count - width) / 2;
+		uint32_t medianSum = 0;
+		for (uint16_t i = first; i < first + width; i++)
+		{
+			medianSum += sorted[i];
+		}
+		return medianSum / width;
+	}
+};
+
+#endif
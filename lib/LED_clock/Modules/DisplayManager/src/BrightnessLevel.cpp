@@ -0,0 +1,29 @@
+/**
+ * \file BrightnessLevel.cpp
+ * \author Florian Laschober
+ * \brief Implementation of the member functions of the BrightnessLevel class
+ */
+
+#include "BrightnessLevel.h"
+
+uint8_t BrightnessLevel::scaleTable[256];
+
+BrightnessLevel::BrightnessLevel(uint8_t initialLevel) : EasedTransition(initialLevel)
+{
+}
+
+void BrightnessLevel::buildScaleTable(double gamma)
+{
+	for (uint16_t level = 0; level < 256; level++)
+	{
+		uint8_t scale = round(255.0 * pow(level / 255.0, gamma));
+		scaleTable[level] = level > 0 && scale == 0 ? 1 : scale;
+	}
+}
+
+uint8_t BrightnessLevel::interpolate(uint8_t from, uint8_t to, AnimatableObject::AnimationProgress progress)
+{
+	int32_t level = from + ((int64_t)((int32_t)to - from) * progress >> EASING_FIXED_SHIFT);
+	return level < 0 ? 0 : level > 255 ? 255 : level;
+}
+
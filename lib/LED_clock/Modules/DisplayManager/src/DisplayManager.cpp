@@ -8,55 +8,101 @@
 #include "DisplayManager.h"
 
 DisplayManager* DisplayManager::instance = nullptr;
-LinkedList<DisplayManager::SegmentInstanceError>* DisplayManager::SegmentIndexErrorList = nullptr;
 
-DisplayManager::DisplayManager()
+DisplayManager::DisplayManager() : powerEstimator(NUM_LEDS + (APPEND_DOWN_LIGHTERS == true ? 0 : ADDITIONAL_LEDS), MAX_MILLIAMPS)
 {
-	FastLED.addLeds<WS2812B, LED_DATA_PIN, GRB>(leds, NUM_LEDS);  // GRB ordering is typical
-	FastLED.setMaxPowerInVoltsAndMilliamps(5, MAX_MILLIAMPS);
+	animationManager = Animator::getInstance();
+	animationManager->setRenderStage(&AnimationEffects::renderBatch);
+	AnimationEffects::prepareIntensityTable(NUM_LEDS_PER_SEGMENT);
 
+	#if USE_RENDER_TASK == true
+		renderMutex = nullptr;
+		renderTaskHandle = nullptr;
+		renderEvents = nullptr;
+	#endif
+	//FastLED only ever gets to see the output of the compositor
+	clockLEDStrip = animationManager->addLEDStrip(&FastLED.addLeds<WS2812B, LED_DATA_PIN, GRB>(frontLeds, NUM_LEDS));  // GRB ordering is typical
 	#if APPEND_DOWN_LIGHTERS == false
-		FastLED.addLeds<WS2812B, DOWNLIGHT_LED_DATA_PIN, GRB>(DownlightLeds, ADDITIONAL_LEDS);
+		downlightLEDStrip = animationManager->addLEDStrip(&FastLED.addLeds<WS2812B, DOWNLIGHT_LED_DATA_PIN, GRB>(frontDownlightLeds, ADDITIONAL_LEDS));
+	#endif
+	#if APPEND_DOWN_LIGHTERS == true
+		downlightLEDStrip = clockLEDStrip;
+		downlightBuffer = &leds[NUM_LEDS - ADDITIONAL_LEDS];
+	#else
+		downlightBuffer = DownlightLeds;
 	#endif
 
 	for (uint16_t i = 0; i < NUM_LEDS; i++)
 	{
 		leds[i] = CRGB::Black;
+		frontLeds[i] = CRGB::Black;
 	}
 
 	#if APPEND_DOWN_LIGHTERS == false
 		for (uint16_t i = 0; i < ADDITIONAL_LEDS; i++)
 		{
 			DownlightLeds[i] = CRGB::Black;
+			frontDownlightLeds[i] = CRGB::Black;
 		}
 	#endif
 
+	//the base layers are fully visible, all overlays hidden
+	for (uint8_t i = 0; i < NUM_COMPOSITOR_LAYERS; i++)
+	{
+		layers[i].source = nullptr;
+		layers[i].rangeColors = nullptr;
+		layers[i].color = CRGB::Black;
+		layers[i].opacity = i < OVERLAY_LAYER ? 255 : 0;
+		layers[i].mode = BLEND_NORMAL;
+		layers[i].targets = i == DOWNLIGHT_LAYER ? TARGET_DOWNLIGHTS : TARGET_DIGITS;
+	}
+	lastFrameTime = 0;
+	colorFadesRunning = false;
+	spatialEffect = nullptr;
+
+	BrightnessLevel::buildScaleTable(BRIGHTNESS_GAMMA);
+	for (uint8_t channel = 0; channel < NUM_BRIGHTNESS_CHANNELS; channel++)
+	{
+		channelScales[channel] = channels[channel].getScale();
+	}
+	for (uint16_t i = 0; i < NUM_SEGMENTS; i++)
+	{
+		segmentScales[i] = 255;
+		allSegments[i] = nullptr;
+	}
+	for (uint8_t i = 0; i < POWER_ESTIMATOR_RANGES; i++)
+	{
+		rangeDirty[i] = true;
+	}
+	channelTransitionsRunning = false;
+
 	for (uint8_t i = 0; i < NUM_DISPLAYS; i++)
 	{
 		Displays[i] = nullptr;
 	}
 
-	animationManager = Animator::getInstance();
-
 	LEDBrightnessCurrent = 128;
 	LEDBrightnessSmoothingStartPoint = 128;
 	setGlobalBrightness(128, false);
 
 	#if ENABLE_LIGHT_SENSOR == true
 		lastSensorMeasurement = 0;
-		takeBrightnessMeasurement();
+		lightSensorTarget = 0;
+		lightSensorBrightness = 0;
+		#if !defined(NATIVE_BUILD)
+			lightSensorTaskHandle = nullptr;
+		#endif
 	#endif
 
-    lightSensorEasing = new CubicEase();
-    lightSensorEasing->setDuration(BRIGHTNESS_INTERPOLATION);
 	progressTotal = 0;
 	currentProgressOffset = 0;
 	currentProgressStep = 0;
+	loadingAnimationID = INVALID_COMPLEX_ANIMATION_ID;
+	loadingAnimationInst = INVALID_COMPLEX_ANIMATION_ID;
 }
 
 DisplayManager::~DisplayManager()
 {
-	delete lightSensorEasing;
 	instance = nullptr;
 }
 
@@ -69,89 +115,399 @@ DisplayManager* DisplayManager::getInstance()
 	return instance;
 }
 
-void DisplayManager::setAllSegmentColors(CRGB color)
+DisplayManager::RenderLock::RenderLock(DisplayManager* displayManager) : owner(displayManager)
 {
-	for (uint16_t i = 0; i < NUM_SEGMENTS; i++)
+	#if USE_RENDER_TASK == true
+		if(owner->renderMutex != nullptr)
+		{
+			xSemaphoreTakeRecursive(owner->renderMutex, portMAX_DELAY);
+		}
+	#endif
+}
+
+DisplayManager::RenderLock::~RenderLock()
+{
+	#if USE_RENDER_TASK == true
+		if(owner->renderMutex != nullptr)
+		{
+			xSemaphoreGiveRecursive(owner->renderMutex);
+		}
+	#endif
+}
+
+bool DisplayManager::isRenderTaskRunning()
+{
+	#if USE_RENDER_TASK == true
+		return renderTaskHandle != nullptr;
+	#else
+		return false;
+	#endif
+}
+
+#if USE_RENDER_TASK == true
+void DisplayManager::startRenderTask()
+{
+	if(renderTaskHandle != nullptr)
 	{
-		allSegments[i]->updateColor(color);
+		return;
+	}
+	renderMutex = xSemaphoreCreateRecursiveMutex();
+	renderEvents = xEventGroupCreate();
+	if(renderMutex == nullptr || renderEvents == nullptr)
+	{
+		Serial.println("[E] Render mutex could not be created. Falling back to rendering from loop()");
+		return;
+	}
+	if(xTaskCreatePinnedToCore(renderTask, "render", RENDER_TASK_STACK_SIZE, this, RENDER_TASK_PRIORITY, &renderTaskHandle, RENDER_TASK_CORE) != pdPASS)
+	{
+		Serial.println("[E] Render task could not be created. Falling back to rendering from loop()");
+		renderTaskHandle = nullptr;
 	}
 }
 
-#if ENABLE_LIGHT_SENSOR == true
+void DisplayManager::renderTask(void* parameter)
+{
+	DisplayManager* displayManager = (DisplayManager*)parameter;
+	Animator* animationManager = displayManager->animationManager;
+	while(true)
+	{
+		if(animationManager->frameDue() == true)
+		{
+			{
+				RenderLock lock(displayManager);
+				animationManager->update();
+				displayManager->updateBrightness();
+				displayManager->updateChannelBrightness();
+				displayManager->updateColorFades();
+			}
+			displayManager->presentFrame();
+		}
+		vTaskDelay(pdMS_TO_TICKS(animationManager->getTimeUntilNextFrame()));
+	}
+}
 
-int SortFunction_SmallerThan(uint16_t &a, uint16_t &b)
+void DisplayManager::loadingAnimationDoneCallback(void* context)
 {
-	return a < b;
+	xEventGroupSetBits(((DisplayManager*)context)->renderEvents, RENDER_EVENT_LOADING_ANIMATION_DONE);
 }
 
-void DisplayManager::takeBrightnessMeasurement()
+void DisplayManager::allAnimationsDoneCallback(void* context)
+{
+	xEventGroupSetBits(((DisplayManager*)context)->renderEvents, RENDER_EVENT_ALL_ANIMATIONS_DONE);
+}
+#endif
+
+void DisplayManager::presentFrame()
 {
-	if(lastSensorMeasurement + LIGHT_SENSOR_READ_DELAY < millis())
+	lastFrameTime = millis();
+	uint8_t stripsToShow;
 	{
-		uint8_t lightSensorBrightnessNew = 0;
-		lastSensorMeasurement = millis();
-		lightSensorMeasurements.add(analogRead(LIGHT_SENSOR_PIN));
-		if(lightSensorMeasurements.size() >= LIGHT_SENSOR_AVERAGE)
+		RenderLock lock(this);
+		stripsToShow = animationManager->takeDirtyStrips();
+		#if APPEND_DOWN_LIGHTERS == true
+			if(stripsToShow & (1 << clockLEDStrip))
+			{
+				composeLayers(frontLeds, leds, NUM_LEDS - ADDITIONAL_LEDS, DIGIT_LAYER, segmentScales, NUM_LEDS_PER_SEGMENT, 0);
+				composeLayers(frontLeds + NUM_LEDS - ADDITIONAL_LEDS, leds + NUM_LEDS - ADDITIONAL_LEDS, ADDITIONAL_LEDS, DOWNLIGHT_LAYER, &channelScales[DOWNLIGHT_BRIGHTNESS], ADDITIONAL_LEDS, NUM_SEGMENTS);
+			}
+		#else
+			if(stripsToShow & (1 << clockLEDStrip))
+			{
+				composeLayers(frontLeds, leds, NUM_LEDS, DIGIT_LAYER, segmentScales, NUM_LEDS_PER_SEGMENT, 0);
+			}
+			if(stripsToShow & (1 << downlightLEDStrip))
+			{
+				composeLayers(frontDownlightLeds, DownlightLeds, ADDITIONAL_LEDS, DOWNLIGHT_LAYER, &channelScales[DOWNLIGHT_BRIGHTNESS], ADDITIONAL_LEDS, NUM_SEGMENTS);
+			}
+		#endif
+		//the estimate only changes with the strips that were composed again, the global brightness is lowered only while it is over budget
+		uint8_t outputBrightness = powerEstimator.limitBrightness(LEDBrightnessCurrent);
+		if(outputBrightness != FastLED.getBrightness())
 		{
-			lightSensorMeasurements.shift();
+			FastLED.setBrightness(outputBrightness);
+			stripsToShow = UINT8_MAX;
 		}
-		if(lightSensorMeasurements.size() < LIGHT_SENSOR_MEDIAN_WIDTH)
+	}
+	//clocking out the data takes a few ms, the back buffers can already be written again in the meantime
+	animationManager->showStrips(stripsToShow);
+}
+
+void DisplayManager::composeLayers(CRGB* output, const CRGB* input, uint16_t numLeds, CompositorLayerID baseLayer, const uint8_t* scales, uint16_t ledsPerScale, uint8_t firstPowerRange)
+{
+	const CompositorLayer& base = layers[baseLayer];
+	uint8_t target = base.targets;
+
+	//collect the visible overlays once instead of checking them for every LED
+	const CompositorLayer* overlays[NUM_COMPOSITOR_LAYERS - OVERLAY_LAYER];
+	uint8_t numOverlays = 0;
+	bool composeAll = false;
+	for (uint8_t i = OVERLAY_LAYER; i < NUM_COMPOSITOR_LAYERS; i++)
+	{
+		//overlays with their own buffer only cover the digits
+		if(layers[i].opacity > 0 && (layers[i].targets & target) && (layers[i].source == nullptr || baseLayer == DIGIT_LAYER))
 		{
-			//Calculate a normal average as long as the median width is not reached yet
-			uint64_t BrightnessListSum = 0;
-			for (uint16_t i = 0; i < lightSensorMeasurements.size(); i++)
-			{
-				BrightnessListSum += lightSensorMeasurements.get(i);
-			}
-			lightSensorBrightnessNew = map(BrightnessListSum / lightSensorMeasurements.size(), 0, 4095, 0, 255);
+			overlays[numOverlays++] = &layers[i];
+			composeAll |= layers[i].source != nullptr;
 		}
-		else
+	}
+
+	bool plainCopy = numOverlays == 0 && base.opacity == 255 && base.mode != BLEND_MULTIPLY && base.mode != BLEND_TINT;
+	CRGB runColors[NUM_COMPOSITOR_LAYERS - OVERLAY_LAYER];
+	uint8_t powerRange = firstPowerRange;
+	for (uint16_t first = 0; first < numLeds; first += ledsPerScale, scales++, powerRange++)
+	{
+		//take the flag of the segment in any case, otherwise it would still be set the next time
+		bool changed = powerRange < NUM_SEGMENTS && allSegments[powerRange] != nullptr && allSegments[powerRange]->takeChanged();
+		changed |= rangeDirty[powerRange];
+		rangeDirty[powerRange] = false;
+		if(changed == false && composeAll == false)
+		{
+			continue;
+		}
+		uint16_t last = first + ledsPerScale < numLeds ? first + ledsPerScale : numLeds;
+		uint8_t scale = *scales;
+		uint32_t load = 0;
+		if(plainCopy == true && scale == 255)
 		{
-			LinkedList<uint16_t> sortedMeasurements;
-			//copy all the values to a new temporary list in order to sort them
-			for (uint16_t i = 0; i < lightSensorMeasurements.size(); i++)
+			for (uint16_t i = first; i < last; i++)
 			{
-				sortedMeasurements.add(lightSensorMeasurements.get(i));
+				output[i] = input[i];
+				load += PowerEstimator::load(input[i]);
 			}
-			sortedMeasurements.sort(SortFunction_SmallerThan);
-			//calculate the average of the median window
-			uint64_t BrightnessListSum = 0;
-			uint16_t medianOffset = floor((sortedMeasurements.size() - LIGHT_SENSOR_MEDIAN_WIDTH) / 2);
-			for (uint16_t i = 0; i < LIGHT_SENSOR_MEDIAN_WIDTH; i++)
+			powerEstimator.setRangeLoad(powerRange, load);
+			continue;
+		}
+		//solid overlays have one color for the whole run
+		for (uint8_t j = 0; j < numOverlays; j++)
+		{
+			runColors[j] = overlays[j]->rangeColors != nullptr ? overlays[j]->rangeColors[powerRange] : overlays[j]->color;
+		}
+		for (uint16_t i = first; i < last; i++)
+		{
+			CRGB pixel = blendLayer(CRGB::Black, BrightnessLevel::apply(input[i], scale), base.mode, base.opacity);
+			for (uint8_t j = 0; j < numOverlays; j++)
 			{
-				BrightnessListSum += sortedMeasurements.get(i + medianOffset);
+				pixel = blendLayer(pixel, overlays[j]->source != nullptr ? overlays[j]->source[i] : runColors[j], overlays[j]->mode, overlays[j]->opacity);
 			}
-			lightSensorBrightnessNew = map(BrightnessListSum / LIGHT_SENSOR_MEDIAN_WIDTH, LIGHT_SENSOR_MIN, LIGHT_SENSOR_MAX, LIGHT_SENSOR_SENSITIVITY, 0);
+			output[i] = pixel;
+			load += PowerEstimator::load(pixel);
 		}
-		if(lightSensorBrightnessNew != lightSensorBrightness)
+		powerEstimator.setRangeLoad(powerRange, load);
+	}
+}
+
+CRGB DisplayManager::blendLayer(CRGB below, CRGB layer, BlendMode mode, uint8_t opacity)
+{
+	switch (mode)
+	{
+	case BLEND_ADD:
+		below += layer.nscale8(opacity);
+		return below;
+	case BLEND_MULTIPLY:
+		return blend(below, CRGB(scale8(below.r, layer.r), scale8(below.g, layer.g), scale8(below.b, layer.b)), opacity);
+	case BLEND_TINT:
+	{
+		uint8_t level = below.r > below.g ? below.r : below.g;
+		level = below.b > level ? below.b : level;
+		return blend(below, CRGB(scale8(layer.r, level), scale8(layer.g, level), scale8(layer.b, level)), opacity);
+	}
+	default:
+		return blend(below, layer, opacity);
+	}
+}
+
+void DisplayManager::markLayerDirty(uint8_t targets)
+{
+	if(targets & TARGET_DIGITS)
+	{
+		for (uint8_t i = 0; i < NUM_SEGMENTS; i++)
 		{
-			lightSensorBrightness = lightSensorBrightnessNew;
-			setGlobalBrightness(currentLEDBrightness);
+			rangeDirty[i] = true;
 		}
-		Serial.printf("Sensor brightness: %d\n\r", lightSensorBrightness);
+		animationManager->markStripDirty(clockLEDStrip);
+	}
+	if(targets & TARGET_DOWNLIGHTS)
+	{
+		rangeDirty[NUM_SEGMENTS] = true;
+		animationManager->markStripDirty(downlightLEDStrip);
+	}
+}
+
+void DisplayManager::setLayer(CompositorLayerID layer, uint8_t opacity, BlendMode mode)
+{
+	if(layer >= NUM_COMPOSITOR_LAYERS)
+	{
+		Serial.printf("[E] DisplayManager::setLayer: Layer %d does not exist\n\r", layer);
+		return;
+	}
+	RenderLock lock(this);
+	layers[layer].opacity = opacity;
+	layers[layer].mode = mode;
+	markLayerDirty(layers[layer].targets);
+}
+
+void DisplayManager::setOverlay(CompositorLayerID layer, CRGB color, uint8_t opacity, BlendMode mode, uint8_t targets)
+{
+	if(layer < OVERLAY_LAYER || layer >= NUM_COMPOSITOR_LAYERS)
+	{
+		Serial.printf("[E] DisplayManager::setOverlay: Layer %d is not an overlay\n\r", layer);
+		return;
+	}
+	RenderLock lock(this);
+	//the LEDs the overlay covered before have to be composed again as well
+	markLayerDirty(layers[layer].targets | targets);
+	layers[layer].source = nullptr;
+	layers[layer].rangeColors = nullptr;
+	layers[layer].color = color;
+	layers[layer].opacity = opacity;
+	layers[layer].mode = mode;
+	layers[layer].targets = targets;
+}
+
+void DisplayManager::setDisplayOverlay(CompositorLayerID layer, const CRGB displayColors[NUM_DISPLAYS], uint8_t opacity, BlendMode mode)
+{
+	if(layer < OVERLAY_LAYER || layer >= NUM_COMPOSITOR_LAYERS)
+	{
+		Serial.printf("[E] DisplayManager::setDisplayOverlay: Layer %d is not an overlay\n\r", layer);
+		return;
+	}
+	RenderLock lock(this);
+	CRGB* colors = overlayRangeColors[layer - OVERLAY_LAYER];
+	bool unchanged = layers[layer].rangeColors == colors && layers[layer].source == nullptr && layers[layer].opacity == opacity && layers[layer].mode == mode
+		&& layers[layer].targets == TARGET_DIGITS;
+	for (uint8_t i = 0; i < NUM_SEGMENTS; i++)
+	{
+		unchanged &= colors[i] == displayColors[DisplayConfiguration::displayIndex[i]];
+		colors[i] = displayColors[DisplayConfiguration::displayIndex[i]];
+	}
+	if(unchanged == true)
+	{
+		return;
+	}
+	markLayerDirty(layers[layer].targets | TARGET_DIGITS);
+	colors[NUM_SEGMENTS] = CRGB::Black;
+	layers[layer].source = nullptr;
+	layers[layer].rangeColors = colors;
+	layers[layer].opacity = opacity;
+	layers[layer].mode = mode;
+	layers[layer].targets = TARGET_DIGITS;
+}
+
+void DisplayManager::stopSpatialEffect()
+{
+	RenderLock lock(this);
+	if(spatialEffect != nullptr)
+	{
+		animationManager->stopAnimation(spatialEffect);
+		spatialEffect = nullptr;
+	}
+	if(layers[OVERLAY_LAYER].source != nullptr)
+	{
+		layers[OVERLAY_LAYER].source = nullptr;
+		layers[OVERLAY_LAYER].opacity = 0;
+		markLayerDirty(layers[OVERLAY_LAYER].targets);
+	}
+}
+
+void DisplayManager::spatialEffectDoneCallback()
+{
+	if(instance != nullptr)
+	{
+		instance->stopSpatialEffect();
+	}
+}
+
+void DisplayManager::presentFrameIfDue()
+{
+	if(isRenderTaskRunning() == false && lastFrameTime + (animationManager->getFramePeriod() + 999) / 1000 <= millis())
+	{
+		presentFrame();
+	}
+}
+
+void DisplayManager::setAllSegmentColors(CRGB color, bool enableSmoothTransition)
+{
+	RenderLock lock(this);
+	for (uint16_t i = 0; i < NUM_SEGMENTS; i++)
+	{
+		allSegments[i]->updateColor(color, enableSmoothTransition ? COLOR_FADE_DURATION : 0, ColorFadeEasing);
+	}
+	colorFadesRunning = true;
+}
+
+#if ENABLE_LIGHT_SENSOR == true
+
+void DisplayManager::startLightSensorSampler()
+{
+	#if !defined(NATIVE_BUILD)
+		if(lightSensorTaskHandle != nullptr)
+		{
+			return;
+		}
+		if(xTaskCreatePinnedToCore(lightSensorTask, "lightSensor", LIGHT_SENSOR_TASK_STACK_SIZE, this, LIGHT_SENSOR_TASK_PRIORITY, &lightSensorTaskHandle, LIGHT_SENSOR_TASK_CORE) != pdPASS)
+		{
+			Serial.println("[E] Light sensor task could not be created. Falling back to reading the sensor from the render loop");
+			lightSensorTaskHandle = nullptr;
+		}
+	#endif
+}
+
+bool DisplayManager::isLightSensorSamplerRunning()
+{
+	#if !defined(NATIVE_BUILD)
+		return lightSensorTaskHandle != nullptr;
+	#else
+		return false;
+	#endif
+}
+
+#if !defined(NATIVE_BUILD)
+void DisplayManager::lightSensorTask(void* parameter)
+{
+	DisplayManager* displayManager = (DisplayManager*)parameter;
+	while(true)
+	{
+		displayManager->takeBrightnessMeasurement();
+		vTaskDelay(pdMS_TO_TICKS(LIGHT_SENSOR_READ_DELAY));
 	}
 }
 #endif
 
-void DisplayManager::setHourSegmentColors(CRGB color)
+void DisplayManager::takeBrightnessMeasurement()
 {
-	Displays[LOWER_DIGIT_HOUR_DISPLAY]->updateColor(color);
-	Displays[HIGHER_DIGIT_HOUR_DISPLAY]->updateColor(color);
+	lightSensorFilter.add(analogRead(LIGHT_SENSOR_PIN));
+	//the mean of the readings around the median ignores single spikes, like a lamp being switched or a shadow passing by
+	uint16_t reading = constrain(lightSensorFilter.getMedianMean(LIGHT_SENSOR_MEDIAN_WIDTH), LIGHT_SENSOR_MIN, LIGHT_SENSOR_MAX);
+	lightSensorTarget = map(reading, LIGHT_SENSOR_MIN, LIGHT_SENSOR_MAX, LIGHT_SENSOR_SENSITIVITY, 0);
 }
+#endif
 
-void DisplayManager::setMinuteSegmentColors(CRGB color)
+void DisplayManager::setHourSegmentColors(CRGB color, bool enableSmoothTransition)
 {
-	Displays[LOWER_DIGIT_MINUTE_DISPLAY]->updateColor(color);
-	Displays[HIGHER_DIGIT_MINUTE_DISPLAY]->updateColor(color);
+	RenderLock lock(this);
+	Displays[LOWER_DIGIT_HOUR_DISPLAY]->updateColor(color, enableSmoothTransition ? COLOR_FADE_DURATION : 0, ColorFadeEasing);
+	Displays[HIGHER_DIGIT_HOUR_DISPLAY]->updateColor(color, enableSmoothTransition ? COLOR_FADE_DURATION : 0, ColorFadeEasing);
+	colorFadesRunning = true;
 }
 
-void DisplayManager::setSegmentColor(int segment, CRGB color)
+void DisplayManager::setMinuteSegmentColors(CRGB color, bool enableSmoothTransition)
 {
-	Displays[segment]->updateColor(color);
+	RenderLock lock(this);
+	Displays[LOWER_DIGIT_MINUTE_DISPLAY]->updateColor(color, enableSmoothTransition ? COLOR_FADE_DURATION : 0, ColorFadeEasing);
+	Displays[HIGHER_DIGIT_MINUTE_DISPLAY]->updateColor(color, enableSmoothTransition ? COLOR_FADE_DURATION : 0, ColorFadeEasing);
+	colorFadesRunning = true;
+}
+
+void DisplayManager::setSegmentColor(int segment, CRGB color, bool enableSmoothTransition)
+{
+	RenderLock lock(this);
+	Displays[segment]->updateColor(color, enableSmoothTransition ? COLOR_FADE_DURATION : 0, ColorFadeEasing);
+	colorFadesRunning = true;
 }
 
 void DisplayManager::InitSegments(uint16_t indexOfFirstLed, uint8_t ledsPerSegment, CRGB initialColor, uint8_t initBrightness)
 {
+	RenderLock lock(this);
 	for (uint8_t i = 0; i < NUM_DISPLAYS; i++)
 	{
 		if(Displays[i] != nullptr)
@@ -163,24 +519,30 @@ void DisplayManager::InitSegments(uint16_t indexOfFirstLed, uint8_t ledsPerSegme
 	uint16_t currentLEDIndex = indexOfFirstLed;
 	for (uint16_t i = 0; i < NUM_SEGMENTS; i++)
 	{
-		allSegments[i] = new Segment(leds, currentLEDIndex, ledsPerSegment, SegmentDirections[i], initialColor);
-		if(Displays[displayIndex[i]] == nullptr)
+		allSegments[i] = new Segment(leds, currentLEDIndex, ledsPerSegment, DisplayConfiguration::SegmentDirections[i], initialColor, clockLEDStrip);
+		if(Displays[DisplayConfiguration::displayIndex[i]] == nullptr)
 		{
-			Displays[displayIndex[i]] = new SevenSegment(SegmentDisplayModes[displayIndex[i]], animationManager);
+			Displays[DisplayConfiguration::displayIndex[i]] = new SevenSegment(DisplayConfiguration::SegmentDisplayModes[DisplayConfiguration::displayIndex[i]], animationManager);
 		}
-		Displays[displayIndex[i]]->add(allSegments[i], SegmentPositions[i]);
+		Displays[DisplayConfiguration::displayIndex[i]]->add(allSegments[i], DisplayConfiguration::SegmentPositions[i]);
 		currentLEDIndex += ledsPerSegment;
 	}
 	//set the initial brightness to avoid jumps
 	LEDBrightnessCurrent = initBrightness;
 	LEDBrightnessSmoothingStartPoint = initBrightness;
 	setGlobalBrightness(initBrightness, false);
-	//All animations should be initialized by now. So now print the backlog of errors to not forget about it
-	printAnimationInitErrors();
+
+	#if USE_RENDER_TASK == true
+		startRenderTask();
+	#endif
+	#if ENABLE_LIGHT_SENSOR == true
+		startLightSensorSampler();
+	#endif
 }
 
 void DisplayManager::displayRaw(uint8_t Hour, uint8_t Minute)
 {
+	RenderLock lock(this);
 	uint8_t firstHourDigit = Hour / 10;
 	if(firstHourDigit == 0 && DISPLAY_SWITCH_OFF_AT_0 == true)
 	{
@@ -226,7 +588,7 @@ void DisplayManager::displayTimer(uint8_t hours, uint8_t minutes, uint8_t second
 	}
 	else
 	{
-		if(SegmentDisplayModes[HIGHER_DIGIT_HOUR_DISPLAY] == SevenSegment::ONLY_ONE)
+		if(DisplayConfiguration::SegmentDisplayModes[HIGHER_DIGIT_HOUR_DISPLAY] == SevenSegment::ONLY_ONE)
 		{
 			if(minutes < 20)
 			{
@@ -246,44 +608,167 @@ void DisplayManager::displayTimer(uint8_t hours, uint8_t minutes, uint8_t second
 
 void DisplayManager::handle()
 {
-	animationManager->handle();
+	if(isRenderTaskRunning() == true || animationManager->frameDue() == false)
+	{
+		return;
+	}
+	animationManager->update();
+	updateBrightness();
+	updateChannelBrightness();
+	updateColorFades();
+	presentFrame();
+}
+
+void DisplayManager::waitForNextFrame()
+{
+	//the render task keeps its own frame timing, the loop must not be slowed down by it
+	if(isRenderTaskRunning() == true)
+	{
+		return;
+	}
+	::delay(animationManager->getTimeUntilNextFrame());
+}
 
+void DisplayManager::updateBrightness()
+{
 	#if ENABLE_LIGHT_SENSOR == true
-		takeBrightnessMeasurement();
+		if(isLightSensorSamplerRunning() == false && lastSensorMeasurement + LIGHT_SENSOR_READ_DELAY <= millis())
+		{
+			lastSensorMeasurement = millis();
+			takeBrightnessMeasurement();
+		}
+		if(lightSensorTarget != lightSensorBrightness)
+		{
+			lightSensorBrightness = lightSensorTarget;
+			setGlobalBrightness(currentLEDBrightness);
+			Serial.printf("Sensor brightness: %d\n\r", lightSensorBrightness);
+		}
 	#endif
 	uint64_t currentMillis = millis();
 	if(LEDBrightnessCurrent != LEDBrightnessSetPoint && lastBrightnessChange + BRIGHTNESS_INTERPOLATION >= currentMillis)
 	{
 		if(LEDBrightnessSetPoint > LEDBrightnessSmoothingStartPoint)
 		{
-			lightSensorEasing->setTotalChangeInPosition(LEDBrightnessSmoothingStartPoint - LEDBrightnessSetPoint);
-			LEDBrightnessCurrent = LEDBrightnessSmoothingStartPoint - lightSensorEasing->easeInOut(currentMillis - lastBrightnessChange);
+			LEDBrightnessCurrent = LEDBrightnessSmoothingStartPoint - ease<CubicEase>(EASE_IN_OUT, currentMillis - lastBrightnessChange, BRIGHTNESS_INTERPOLATION, LEDBrightnessSmoothingStartPoint - LEDBrightnessSetPoint);
 		}
         else
 		{
-			lightSensorEasing->setTotalChangeInPosition(LEDBrightnessSetPoint - LEDBrightnessSmoothingStartPoint);
-			LEDBrightnessCurrent = LEDBrightnessSmoothingStartPoint + lightSensorEasing->easeInOut(currentMillis - lastBrightnessChange);
+			LEDBrightnessCurrent = LEDBrightnessSmoothingStartPoint + ease<CubicEase>(EASE_IN_OUT, currentMillis - lastBrightnessChange, BRIGHTNESS_INTERPOLATION, LEDBrightnessSetPoint - LEDBrightnessSmoothingStartPoint);
 		}
-		FastLED.setBrightness(LEDBrightnessCurrent);
+		animationManager->markAllStripsDirty();
 		//Serial.print("DisplayManager::handle(): Just set brightness to: "); Serial.println(LEDBrightnessCurrent);
 	}
 }
 
-void DisplayManager::setInternalLEDColor(CRGB color)
+void DisplayManager::updateChannelBrightness()
 {
-	for (uint16_t i = 0; i < ADDITIONAL_LEDS; i++)
+	if(channelTransitionsRunning == false)
 	{
-		#if APPEND_DOWN_LIGHTERS == true
-			leds[NUM_LEDS - ADDITIONAL_LEDS + i] = color;
-		#else
-			DownlightLeds[i] = color;
-		#endif
+		return;
+	}
+	uint32_t now = millis();
+	bool running = false;
+	for (uint8_t channel = 0; channel < NUM_BRIGHTNESS_CHANNELS; channel++)
+	{
+		if(channels[channel].update(now) == true)
+		{
+			applyChannelBrightness((BrightnessChannel)channel);
+		}
+		running |= channels[channel].isRunning();
+	}
+	channelTransitionsRunning = running;
+}
+
+void DisplayManager::applyChannelBrightness(BrightnessChannel channel)
+{
+	if(channels[channel].getScale() == channelScales[channel])
+	{
+		return;
+	}
+	channelScales[channel] = channels[channel].getScale();
+	if(channel == DOWNLIGHT_BRIGHTNESS)
+	{
+		markLayerDirty(TARGET_DOWNLIGHTS);
+		return;
+	}
+	for (uint16_t i = 0; i < NUM_SEGMENTS; i++)
+	{
+		if(getBrightnessChannel(i) == channel)
+		{
+			segmentScales[i] = channelScales[channel];
+			rangeDirty[i] = true;
+		}
+	}
+	animationManager->markStripDirty(clockLEDStrip);
+}
+
+void DisplayManager::setChannelBrightness(BrightnessChannel channel, uint8_t level, bool enableSmoothTransition)
+{
+	if(channel >= NUM_BRIGHTNESS_CHANNELS)
+	{
+		Serial.printf("[E] DisplayManager::setChannelBrightness: Channel %d does not exist\n\r", channel);
+		return;
+	}
+	RenderLock lock(this);
+	channels[channel].start(level, enableSmoothTransition == true ? CHANNEL_BRIGHTNESS_INTERPOLATION : 0, millis(), BrightnessEasing);
+	if(channels[channel].isRunning() == true)
+	{
+		channelTransitionsRunning = true;
+		return;
+	}
+	applyChannelBrightness(channel);
+}
+
+uint8_t DisplayManager::getChannelBrightness(BrightnessChannel channel)
+{
+	return channel < NUM_BRIGHTNESS_CHANNELS ? channels[channel].getTarget() : 0;
+}
+
+uint32_t DisplayManager::getEstimatedMilliamps()
+{
+	RenderLock lock(this);
+	return powerEstimator.getMilliamps(FastLED.getBrightness());
+}
+
+void DisplayManager::setInternalLEDColor(CRGB color, bool enableSmoothTransition)
+{
+	RenderLock lock(this);
+	if(enableSmoothTransition == true)
+	{
+		downlightColor.start(color, COLOR_FADE_DURATION, millis(), ColorFadeEasing);
+		colorFadesRunning = true;
+		return;
+	}
+	downlightColor.jumpTo(color);
+	fill_solid(downlightBuffer, ADDITIONAL_LEDS, color);
+	markLayerDirty(TARGET_DOWNLIGHTS);
+}
+
+void DisplayManager::updateColorFades()
+{
+	if(colorFadesRunning == false)
+	{
+		return;
+	}
+	uint32_t now = millis();
+	bool running = false;
+	for (uint16_t i = 0; i < NUM_SEGMENTS; i++)
+	{
+		running |= allSegments[i]->updateColorFade(now);
 	}
+	if(downlightColor.update(now) == true)
+	{
+		fill_solid(downlightBuffer, ADDITIONAL_LEDS, downlightColor.getColor());
+		markLayerDirty(TARGET_DOWNLIGHTS);
+	}
+	running |= downlightColor.isRunning();
+	colorFadesRunning = running;
 }
 
 
 void DisplayManager::setDotLEDColor(CRGB color)
 {
+	RenderLock lock(this);
 	#if DISPLAY_FOR_SEPARATION_DOT > -1
 		Displays[DISPLAY_FOR_SEPARATION_DOT]->setColor(color);
 	#endif
@@ -291,21 +776,87 @@ void DisplayManager::setDotLEDColor(CRGB color)
 
 void DisplayManager::showLoadingAnimation()
 {
-	loadingAnimationID = animationManager->PlayComplexAnimation(IndefiniteLoadingAnimation, (AnimatableObject**)allSegments, true);
+	RenderLock lock(this);
+	loadingAnimationID = animationManager->PlayComplexAnimation(&IndefiniteLoadingAnimation, (AnimatableObject**)allSegments, true);
 }
 
 void DisplayManager::stopLoadingAnimation()
 {
+	RenderLock lock(this);
 	animationManager->ComplexAnimationStopLooping(loadingAnimationID);
 }
 
 void DisplayManager::waitForLoadingAnimationFinish()
 {
-	animationManager->WaitForComplexAnimationCompletion(loadingAnimationID);
+	stopLoadingAnimation();
+	#if USE_RENDER_TASK == true
+		if(isRenderTaskRunning() == true)
+		{
+			{
+				RenderLock lock(this);
+				xEventGroupClearBits(renderEvents, RENDER_EVENT_LOADING_ANIMATION_DONE);
+				if(animationManager->onComplexAnimationComplete(loadingAnimationID, &loadingAnimationDoneCallback, this) == false)
+				{
+					return; //already done
+				}
+			}
+			if((xEventGroupWaitBits(renderEvents, RENDER_EVENT_LOADING_ANIMATION_DONE, pdTRUE, pdTRUE, pdMS_TO_TICKS(ANIMATION_WAIT_TIMEOUT_MS)) & RENDER_EVENT_LOADING_ANIMATION_DONE) == 0)
+			{
+				Serial.println("[E] Loading animation did not finish in time");
+			}
+			return;
+		}
+	#endif
+	uint32_t startTime = millis();
+	while(animationManager->isComplexAnimationRunning(loadingAnimationID) == true)
+	{
+		if(millis() - startTime >= ANIMATION_WAIT_TIMEOUT_MS)
+		{
+			Serial.println("[E] Loading animation did not finish in time");
+			return;
+		}
+		delay((animationManager->getFramePeriod() + 999) / 1000);
+	}
+}
+
+void DisplayManager::waitForAnimations()
+{
+	#if USE_RENDER_TASK == true
+		if(isRenderTaskRunning() == true)
+		{
+			{
+				RenderLock lock(this);
+				//a looping animation never finishes on its own, let all of them run out their current cycle
+				animationManager->AllComplexAnimationsStopLooping();
+				xEventGroupClearBits(renderEvents, RENDER_EVENT_ALL_ANIMATIONS_DONE);
+				if(animationManager->onAllComplexAnimationsComplete(&allAnimationsDoneCallback, this) == false)
+				{
+					return; //nothing playing
+				}
+			}
+			if((xEventGroupWaitBits(renderEvents, RENDER_EVENT_ALL_ANIMATIONS_DONE, pdTRUE, pdTRUE, pdMS_TO_TICKS(ANIMATION_WAIT_TIMEOUT_MS)) & RENDER_EVENT_ALL_ANIMATIONS_DONE) == 0)
+			{
+				Serial.println("[E] Animations did not finish in time");
+			}
+			return;
+		}
+	#endif
+	animationManager->AllComplexAnimationsStopLooping();
+	uint32_t startTime = millis();
+	while(animationManager->getNumRunningComplexAnimations() > 0)
+	{
+		if(millis() - startTime >= ANIMATION_WAIT_TIMEOUT_MS)
+		{
+			Serial.println("[E] Animations did not finish in time");
+			return;
+		}
+		delay((animationManager->getFramePeriod() + 999) / 1000);
+	}
 }
 
 void DisplayManager::turnAllSegmentsOff()
 {
+	RenderLock lock(this);
 	for (uint16_t i = 0; i < NUM_SEGMENTS; i++)
 	{
 		allSegments[i]->off();
@@ -314,41 +865,75 @@ void DisplayManager::turnAllSegmentsOff()
 
 void DisplayManager::turnAllLEDsOff()
 {
+	RenderLock lock(this);
 	for (uint16_t i = 0; i < NUM_SEGMENTS; i++)
 	{
 		animationManager->stopAnimation(allSegments[i]);
 	}
 	turnAllSegmentsOff();
-	setInternalLEDColor(CRGB::Black);
+	setInternalLEDColor(CRGB::Black, false);
 }
 
 void DisplayManager::displayProgress(uint32_t total)
 {
-	loadingAnimationInst = animationManager->BuildComplexAnimation(LoadingProgressAnimation, (AnimatableObject**)allSegments);
+	RenderLock lock(this);
+	animationManager->releaseComplexAnimation(loadingAnimationInst);
+	loadingAnimationInst = animationManager->BuildComplexAnimation(&LoadingProgressAnimation, (AnimatableObject**)allSegments);
 	progressTotal = total;
 	currentProgressOffset = 0;
 	currentProgressStep = 0;
 	turnAllSegmentsOff();
-	animationManager->handle(0);
+	animationManager->update(0);
+	presentFrameIfDue();
 }
 
 void DisplayManager::updateProgress(uint32_t progress)
 {
+	RenderLock lock(this);
 	if(progress - currentProgressOffset > (progressTotal / NUM_SEGMENTS_PROGRESS))
 	{
 		currentProgressOffset += (progressTotal / NUM_SEGMENTS_PROGRESS);
 		currentProgressStep++;
 	}
-	animationManager->setComplexAnimationStep(loadingAnimationInst, currentProgressStep, map(progress - currentProgressOffset, 0, progressTotal / NUM_SEGMENTS_PROGRESS, 0, LoadingProgressAnimation->LengthPerAnimation));
+	animationManager->setComplexAnimationStep(loadingAnimationInst, currentProgressStep, map(progress - currentProgressOffset, 0, progressTotal / NUM_SEGMENTS_PROGRESS, 0, animationManager->getScaledDuration(LoadingProgressAnimation.LengthPerAnimation)));
+	presentFrameIfDue();
 }
 
 void DisplayManager::delay(uint32_t timeInMs)
 {
-	animationManager->delay(timeInMs);
+	if(isRenderTaskRunning() == true)
+	{
+		::delay(timeInMs);
+		return;
+	}
+	unsigned long startMillis = millis();
+	uint32_t elapsed;
+	do
+	{
+		handle();
+		elapsed = millis() - startMillis;
+		if(elapsed < timeInMs)
+		{
+			uint32_t timeUntilNextFrame = animationManager->getTimeUntilNextFrame();
+			::delay(timeUntilNextFrame < timeInMs - elapsed ? timeUntilNextFrame : timeInMs - elapsed);
+		}
+	} while(millis() - startMillis < timeInMs);
+}
+
+void DisplayManager::setAnimationSpeed(uint16_t percent)
+{
+	RenderLock lock(this);
+	animationManager->setAnimationSpeed(percent);
+}
+
+uint16_t DisplayManager::getAnimationSpeed()
+{
+	return animationManager->getAnimationSpeed();
 }
 
 void DisplayManager::setGlobalBrightness(uint8_t brightness, bool enableSmoothTransition)
 {
+	RenderLock lock(this);
 	currentLEDBrightness = brightness;
 
 	#if ENABLE_LIGHT_SENSOR == true
@@ -364,13 +949,14 @@ void DisplayManager::setGlobalBrightness(uint8_t brightness, bool enableSmoothTr
 	else
 	{
 		LEDBrightnessSmoothingStartPoint = LEDBrightnessCurrent = LEDBrightnessSetPoint;
-		FastLED.setBrightness(LEDBrightnessCurrent);
+		animationManager->markAllStripsDirty();
 		Serial.print("DisplayManager::setGlobalBrightness: Just set brightness to: "); Serial.println(LEDBrightnessCurrent);
 	}
 }
 
 void DisplayManager::flashSeparationDot(uint8_t numDots)
 {
+	RenderLock lock(this);
 	#if DISPLAY_FOR_SEPARATION_DOT > -1
 		Displays[DISPLAY_FOR_SEPARATION_DOT]->FlashMiddleDot(numDots);
 	#endif
@@ -380,6 +966,7 @@ void DisplayManager::test()
 {
 	static uint8_t count = 0;
 	static int8_t direction = 1;
+	RenderLock lock(this);
 
 	Displays[0]->DisplayNumber(count);
 	Displays[1]->DisplayNumber(count);
@@ -398,45 +985,15 @@ void DisplayManager::test()
 
 void DisplayManager::testOnStartup(uint8_t numDisplay)
 {
+	RenderLock lock(this);
 	Displays[0]->DisplayNumber(numDisplay);
 	Displays[1]->DisplayNumber(numDisplay);
 	Displays[2]->DisplayNumber(numDisplay);
 	Displays[3]->DisplayNumber(1);
 }
 
-int16_t DisplayManager::getGlobalSegmentIndex(SegmentPositions_t segmentPosition, DisplayIDs Display)
+int16_t DisplayManager::segmentNotFound(SegmentPositions_t segmentPosition, DisplayIDs Display)
 {
-	for (uint16_t i = 0; i < NUM_SEGMENTS; i++)
-	{
-		if(displayIndex[i] == Display && SegmentPositions[i] == (1 << segmentPosition))
-		{
-			return i;
-		}
-	}
-	if(!Serial.availableForWrite()) // during startup Serial is not availiable yet so put the errors to a list
-	{
-		if(SegmentIndexErrorList == nullptr)
-		{
-			SegmentIndexErrorList = new LinkedList<SegmentInstanceError>();
-		}
-		SegmentInstanceError newError = {.segmentPosition = segmentPosition, .Display = Display};
-		SegmentIndexErrorList->add(newError);
-	}
-	else // once Serial was initialized print errors right away to not forget about them
-	{
-		Serial.printf("[DisplayManager::getGlobalSegmentIndex()] Segment not valid; Position: %d; Display: %d\n\r", segmentPosition, Display);
-	}
+	Serial.printf("[DisplayManager::getGlobalSegmentIndex()] Segment not valid; Position: %d; Display: %d\n\r", segmentPosition, Display);
 	return NO_SEGMENTS;
 }
-
-void DisplayManager::printAnimationInitErrors()
-{
-	if(SegmentIndexErrorList != nullptr)
-	{
-		while(SegmentIndexErrorList->size() > 0)
-		{
-			SegmentInstanceError currentError =	SegmentIndexErrorList->pop();
-			Serial.printf("[DisplayManager::printAnimationInitErrors()] Segment not valid; Position: %d; Display: %d\n\r", currentError.segmentPosition, currentError.Display);
-		}
-	}
-}
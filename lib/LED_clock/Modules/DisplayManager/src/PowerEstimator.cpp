@@ -0,0 +1,58 @@
+/**
+ * \file PowerEstimator.cpp
+ * \author Florian Laschober
+ * \brief Implementation of the member functions of the PowerEstimator class
+ */
+
+#include "PowerEstimator.h"
+
+PowerEstimator::PowerEstimator(uint16_t numLeds, uint32_t budget)
+{
+	for (uint8_t i = 0; i < POWER_ESTIMATOR_RANGES; i++)
+	{
+		rangeLoad[i] = 0;
+	}
+	totalLoad = 0;
+	idleMilliamps = (uint32_t)numLeds * LED_MILLIAMPS_IDLE;
+	maxMilliamps = budget;
+}
+
+uint32_t PowerEstimator::load(const CRGB* leds, uint16_t numLeds)
+{
+	uint32_t sum = 0;
+	for (uint16_t i = 0; i < numLeds; i++)
+	{
+		sum += load(leds[i]);
+	}
+	return sum;
+}
+
+void PowerEstimator::setRangeLoad(uint8_t range, uint32_t load)
+{
+	if(range >= POWER_ESTIMATOR_RANGES)
+	{
+		Serial.printf("[E] PowerEstimator::setRangeLoad: Range %d does not exist\n\r", range);
+		return;
+	}
+	totalLoad = totalLoad - rangeLoad[range] + load;
+	rangeLoad[range] = load;
+}
+
+uint32_t PowerEstimator::getMilliamps(uint8_t brightness) const
+{
+	return idleMilliamps + (uint64_t)totalLoad * brightness / (255 * 255);
+}
+
+uint8_t PowerEstimator::limitBrightness(uint8_t brightness) const
+{
+	if(getMilliamps(brightness) <= maxMilliamps)
+	{
+		return brightness;
+	}
+	if(idleMilliamps >= maxMilliamps)
+	{
+		return 0;
+	}
+	//totalLoad can't be 0 here, otherwise the idle current alone would already exceed the budget
+	return (uint64_t)(maxMilliamps - idleMilliamps) * 255 * 255 / totalLoad;
+}
@@ -0,0 +1,67 @@
+/**
+ * \file SpatialEffects.cpp
+ * \author Florian Laschober
+ * \brief Compile time coordinate map of all LEDs for the spatial effects
+ */
+
+#include "SpatialEffects.h"
+#include "DisplayConfiguration.h"
+#include "TransitionSynthesizer.h"
+
+/**
+ * \brief Layout of the LEDs in LED pitches. A segment spans from one corner of the digit to the next one,
+ * 		  the corners themselves have no LED.
+ */
+namespace LEDLayout
+{
+	constexpr uint16_t SEGMENT_SPAN = NUM_LEDS_PER_SEGMENT + 1;
+	constexpr uint16_t DISPLAY_PITCH = SEGMENT_SPAN + SPATIAL_DISPLAY_GAP;
+	constexpr uint16_t WIDTH = (NUM_DISPLAYS - 1) * DISPLAY_PITCH + SEGMENT_SPAN;
+	constexpr uint16_t HEIGHT = 2 * SEGMENT_SPAN;
+
+	constexpr SevenSegment::SegmentPosition position(size_t led)
+	{
+		return DisplayConfiguration::SegmentPositions[led / NUM_LEDS_PER_SEGMENT];
+	}
+
+	constexpr bool isHorizontal(size_t led)
+	{
+		return position(led) == SevenSegment::MiddleTopSegment || position(led) == SevenSegment::CenterSegment || position(led) == SevenSegment::MiddleBottomSegment;
+	}
+
+	/**
+	 * \brief Distance of the LED from the left or upper end of its segment, taking the wiring direction into account
+	 */
+	constexpr uint16_t offsetInSegment(size_t led)
+	{
+		return DisplayConfiguration::SegmentDirections[led / NUM_LEDS_PER_SEGMENT] == true ? SEGMENT_SPAN - 1 - led % NUM_LEDS_PER_SEGMENT : 1 + led % NUM_LEDS_PER_SEGMENT;
+	}
+
+	constexpr uint16_t x(size_t led)
+	{
+		return DisplayConfiguration::DisplayColumns[DisplayConfiguration::displayIndex[led / NUM_LEDS_PER_SEGMENT]] * DISPLAY_PITCH +
+			(isHorizontal(led) ? offsetInSegment(led) : position(led) == SevenSegment::RightTopSegment || position(led) == SevenSegment::RightBottomSegment ? SEGMENT_SPAN : 0);
+	}
+
+	constexpr uint16_t y(size_t led)
+	{
+		return position(led) == SevenSegment::MiddleTopSegment ? 0 :
+			   position(led) == SevenSegment::CenterSegment ? SEGMENT_SPAN :
+			   position(led) == SevenSegment::MiddleBottomSegment ? HEIGHT :
+			   (position(led) == SevenSegment::LeftTopSegment || position(led) == SevenSegment::RightTopSegment ? 0 : SEGMENT_SPAN) + offsetInSegment(led);
+	}
+}
+
+template<typename LEDs = typename MakeIndexSequence<SPATIAL_NUM_LEDS>::type>
+struct CoordinateTable;
+
+template<size_t... I>
+struct CoordinateTable<IndexSequence<I...>>
+{
+	static constexpr SpatialEffects::LEDCoordinate coordinates[] = {{(uint8_t)(LEDLayout::x(I) * 255 / LEDLayout::WIDTH), (uint8_t)(LEDLayout::y(I) * 255 / LEDLayout::HEIGHT)}...};
+};
+
+template<size_t... I>
+constexpr SpatialEffects::LEDCoordinate CoordinateTable<IndexSequence<I...>>::coordinates[];
+
+const SpatialEffects::LEDCoordinate* const SpatialEffects::coordinates = CoordinateTable<>::coordinates;
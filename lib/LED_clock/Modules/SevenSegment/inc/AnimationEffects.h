@@ -12,35 +12,130 @@
 #include "Segment.h"
 #include "Configuration.h"
 
+#if USE_INTENSITY_CACHE == true
+	/**
+	 * \brief Rows of one intensity table, the wipe covers the progress from -#ANIMATION_PROGRESS_ONE to #ANIMATION_PROGRESS_ONE
+	 */
+	#define INTENSITY_CACHE_ROWS	(2 * ANIMATION_INTENSITY_STEPS + 1)
+#endif
+
 class AnimationEffects
 {
 private:
-    static void OutToRight(CRGB* leds, uint16_t length, CRGB animationColor, uint16_t totalSteps, int32_t currentStep, bool invert);
-    static void OutToLeft(CRGB* leds, uint16_t length, CRGB animationColor, uint16_t totalSteps, int32_t currentStep, bool invert);
-    static void InToRight(CRGB* leds, uint16_t length, CRGB animationColor, uint16_t totalSteps, int32_t currentStep, bool invert);
-    static void InToLeft(CRGB* leds, uint16_t length, CRGB animationColor, uint16_t totalSteps, int32_t currentStep, bool invert);
-	static void InToMiddle(CRGB* leds, uint16_t length, CRGB animationColor, uint16_t totalSteps, int32_t currentStep, bool invert);
-	static void OutToMiddle(CRGB* leds, uint16_t length, CRGB animationColor, uint16_t totalSteps, int32_t currentStep, bool invert);
-	static void OutFromMiddle(CRGB* leds, uint16_t length, CRGB animationColor, uint16_t totalSteps, int32_t currentStep, bool invert);
-	static void InFromMiddle(CRGB* leds, uint16_t length, CRGB animationColor, uint16_t totalSteps, int32_t currentStep, bool invert);
-    static void MiddleDotFlash(CRGB* leds, uint16_t length, CRGB animationColor, uint16_t totalSteps, int32_t currentStep, bool invert);
+	/**
+	 * \brief Effect of one segment queued for the current frame, see #AnimationEffects::queue
+	 */
+	struct EffectJob {
+		CRGB* leds;
+		uint16_t length;
+		CRGB color;
+		AnimatableObject::AnimationProgress progress;
+		AnimatableObject::AnimationFunction effect;
+		bool invert;
+	};
+
+	/**
+	 * \brief Parameters of the wipe which only depend on the length of the segment
+	 */
+	struct WipeParameters {
+		uint16_t tailLength;
+		int32_t microsteps;
+		int32_t dimmingSteps;
+	};
+
+	static EffectJob batch[ANIMATOR_MAX_OBJECTS];
+	static uint8_t batchSize;
+
+	static WipeParameters getWipeParameters(uint16_t length);
+
+	/**
+	 * \brief Brightness of one LED of the wipe, 255 is fully lit
+	 */
+	static uint8_t getWipeIntensity(int32_t led, uint16_t length, AnimatableObject::AnimationProgress progress, const WipeParameters& parameters);
+
+#if USE_INTENSITY_CACHE == true
+	/**
+	 * \brief Intensity of every LED of the wipe for a segment length, one row per #ANIMATION_INTENSITY_STEPS of the progress
+	 */
+	struct IntensityTable {
+		uint16_t length;
+		uint8_t intensities[INTENSITY_CACHE_ROWS][NUM_LEDS_PER_SEGMENT];
+	};
+
+	static IntensityTable intensityCache[ANIMATION_INTENSITY_CACHE_SLOTS];
+	static uint8_t intensityCacheSize;
+
+	/**
+	 * \brief Find the intensity table of a segment length, builds it if there is still a free slot
+	 *
+	 * \return const IntensityTable* the table or nullptr if the length can't be cached
+	 */
+	static const IntensityTable* getIntensityTable(uint16_t length);
+
+	/**
+	 * \brief Render the wipe from the intensity table, interpolates between the two rows around the progress
+	 */
+	static void renderWipe(CRGB* leds, uint16_t length, CRGB animationColor, AnimatableObject::AnimationProgress progress, const IntensityTable* table);
+#endif
+
+	/**
+	 * \brief The wipe all directional effects are based on: a fully lit block with a fading tail moves from left to right.
+	 * 		  At progress 0 the segment is fully lit, at #ANIMATION_PROGRESS_ONE it is off and at -#ANIMATION_PROGRESS_ONE it is off again.
+	 * 		  Only integer math, the fully lit part is written with one fill_solid.
+	 */
+	static void renderWipe(CRGB* leds, uint16_t length, CRGB animationColor, AnimatableObject::AnimationProgress progress, const WipeParameters& parameters);
+
+	/**
+	 * \brief Render the wipe from the cached intensity table of the length if there is one, otherwise calculate it
+	 */
+	static void renderWipe(CRGB* leds, uint16_t length, CRGB animationColor, AnimatableObject::AnimationProgress progress);
+
+    static void OutToRight(CRGB* leds, uint16_t length, CRGB animationColor, AnimatableObject::AnimationProgress progress, bool invert);
+    static void OutToLeft(CRGB* leds, uint16_t length, CRGB animationColor, AnimatableObject::AnimationProgress progress, bool invert);
+    static void InToRight(CRGB* leds, uint16_t length, CRGB animationColor, AnimatableObject::AnimationProgress progress, bool invert);
+    static void InToLeft(CRGB* leds, uint16_t length, CRGB animationColor, AnimatableObject::AnimationProgress progress, bool invert);
+	static void InToMiddle(CRGB* leds, uint16_t length, CRGB animationColor, AnimatableObject::AnimationProgress progress, bool invert);
+	static void OutToMiddle(CRGB* leds, uint16_t length, CRGB animationColor, AnimatableObject::AnimationProgress progress, bool invert);
+	static void OutFromMiddle(CRGB* leds, uint16_t length, CRGB animationColor, AnimatableObject::AnimationProgress progress, bool invert);
+	static void InFromMiddle(CRGB* leds, uint16_t length, CRGB animationColor, AnimatableObject::AnimationProgress progress, bool invert);
+    static void MiddleDotFlash(CRGB* leds, uint16_t length, CRGB animationColor, AnimatableObject::AnimationProgress progress, bool invert);
     AnimationEffects();
 public:
     ~AnimationEffects();
 
-    static AnimatableObject::AnimationFunction AnimateOutToRight;
-    static AnimatableObject::AnimationFunction AnimateOutToBottom;
-    static AnimatableObject::AnimationFunction AnimateOutToLeft;
-    static AnimatableObject::AnimationFunction AnimateOutToTop;
-    static AnimatableObject::AnimationFunction AnimateInToRight;
-    static AnimatableObject::AnimationFunction AnimateInToBottom;
-    static AnimatableObject::AnimationFunction AnimateInToLeft;
-    static AnimatableObject::AnimationFunction AnimateInToTop;
-	static AnimatableObject::AnimationFunction AnimateInToMiddle;
-	static AnimatableObject::AnimationFunction AnimateOutToMiddle;
-	static AnimatableObject::AnimationFunction AnimateOutFromMiddle;
-	static AnimatableObject::AnimationFunction AnimateInFromMiddle;
-    static AnimatableObject::AnimationFunction AnimateMiddleDotFlash;
+	/**
+	 * \brief Queue the effect of a segment for the current frame instead of rendering it right away.
+	 * 		  Rendered right away if the batch is full.
+	 */
+	static void queue(CRGB* leds, uint16_t length, CRGB animationColor, AnimatableObject::AnimationProgress progress, AnimatableObject::AnimationFunction effect, bool invert);
+
+	/**
+	 * \brief Render all effects queued during the frame in one pass over the LED buffers.
+	 * 		  Registered as render stage of the #Animator, see #Animator::setRenderStage
+	 *
+	 * \param context unused
+	 */
+	static void renderBatch(void* context);
+
+	/**
+	 * \brief Build the intensity table of a segment length ahead of time so the first animation does not have to.
+	 * 		  Does nothing if the intensity cache is disabled or full.
+	 */
+	static void prepareIntensityTable(uint16_t length);
+
+    static constexpr AnimatableObject::AnimationFunction AnimateOutToRight = &OutToRight;
+    static constexpr AnimatableObject::AnimationFunction AnimateOutToBottom = &OutToRight;
+    static constexpr AnimatableObject::AnimationFunction AnimateOutToLeft = &OutToLeft;
+    static constexpr AnimatableObject::AnimationFunction AnimateOutToTop = &OutToLeft;
+    static constexpr AnimatableObject::AnimationFunction AnimateInToRight = &InToRight;
+    static constexpr AnimatableObject::AnimationFunction AnimateInToBottom = &InToRight;
+    static constexpr AnimatableObject::AnimationFunction AnimateInToLeft = &InToLeft;
+    static constexpr AnimatableObject::AnimationFunction AnimateInToTop = &InToLeft;
+	static constexpr AnimatableObject::AnimationFunction AnimateInToMiddle = &InToMiddle;
+	static constexpr AnimatableObject::AnimationFunction AnimateOutToMiddle = &OutToMiddle;
+	static constexpr AnimatableObject::AnimationFunction AnimateOutFromMiddle = &OutFromMiddle;
+	static constexpr AnimatableObject::AnimationFunction AnimateInFromMiddle = &InFromMiddle;
+    static constexpr AnimatableObject::AnimationFunction AnimateMiddleDotFlash = &MiddleDotFlash;
 };
 
 
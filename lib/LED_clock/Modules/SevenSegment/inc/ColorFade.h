@@ -0,0 +1,42 @@
+/**
+ * \file ColorFade.h
+ * \author Florian Laschober
+ * \brief Crossfade between two colors over time
+ */
+
+#ifndef __COLOR_FADE_H_
+#define __COLOR_FADE_H_
+
+#include <Arduino.h>
+#include "EasedTransition.h"
+
+/**
+ * \brief Crossfades from the color that is shown right now to a target color. Changing the target while a fade is running
+ * 		  continues smoothly from the intermediate color. Only holds the color, writing it to the LEDs is up to the owner.
+ * 		  Starting, stopping and advancing the fade is done by #EasedTransition.
+ */
+class ColorFade : public EasedTransition<ColorFade, CRGB>
+{
+private:
+	friend class EasedTransition<ColorFade, CRGB>;
+
+	/**
+	 * \brief Blend of the two colors at the eased progress, overshooting easings are clamped to the two colors
+	 */
+	static CRGB interpolate(CRGB from, CRGB to, AnimatableObject::AnimationProgress progress);
+
+public:
+	/**
+	 * \brief Construct a new ColorFade object which is not running
+	 *
+	 * \param initialColor color that is shown before the first fade
+	 */
+	ColorFade(CRGB initialColor = CRGB::Black);
+
+	/**
+	 * \brief Color that is shown at the moment of the last update
+	 */
+	CRGB getColor() const { return current; }
+};
+
+#endif
@@ -9,6 +9,8 @@
 
 #include <Arduino.h>
 #include "AnimatableObject.h"
+#include "ColorFade.h"
+#include "Configuration.h"
 #define FASTLED_INTERNAL
 #include "FastLED.h"
 
@@ -35,11 +37,42 @@ private:
 	CRGB color;
 	CRGB AnimationColor;
 	CRGB* leds;
+	uint8_t LEDStrip;
+	CRGB retargetFrom[NUM_LEDS_PER_SEGMENT];
+	bool retargeting;
+	bool retargetOn;
+	ColorFade colorFade;
+
+	/**
+	 * \brief Cached result of #Segment::isOn, only valid if litValid is set. Effects write the LEDs later in the batched render pass,
+	 * 		  so ticking an effect invalidates it and the LEDs are only checked again the next time it is needed.
+	 */
+	bool lit;
+	bool litValid;
+
+	/**
+	 * \brief Set whenever the LEDs of the segment are written, see #Segment::takeChanged
+	 */
+	bool changed;
 
 	void writeToLEDs(CRGB colorToSet);
 
+	/**
+	 * \brief Tells the #Animator that the LED strip of this segment has to be pushed out with the next update
+	 * 		  and flags the segment as changed
+	 */
+	void markDirty();
+
 	bool isOn();
 
+protected:
+	/**
+	 * \brief Set the animation effect, this also ends a blend started by #Segment::retarget
+	 *
+	 * \param newEffect effect to execute the next time an animation is started on this segment
+	 */
+	void setAnimationEffect(AnimatableObject::AnimationFunction newEffect);
+
 public:
 	/**
 	 * \brief Construct a new Segment object
@@ -49,8 +82,9 @@ public:
 	 * \param segmentLength Number of LEDs which belong to this segment
 	 * \param Direction Defines which way the LED segment is wired in
 	 * \param segmentColor initial color of the segment
+	 * \param stripID ID of the LED strip which the segment is connected to, as returned by #Animator::addLEDStrip
 	 */
-	Segment(CRGB LEDBuffer[], uint16_t indexOfFirstLEDInSegment, uint8_t segmentLength, direction Direction, CRGB segmentColor = CRGB::Black);
+	Segment(CRGB LEDBuffer[], uint16_t indexOfFirstLEDInSegment, uint8_t segmentLength, direction Direction, CRGB segmentColor = CRGB::Black, uint8_t stripID = 0);
 
 	/**
 	 * \brief Destroy the Segment object
@@ -60,10 +94,10 @@ public:
 	/**
 	 * \brief Set the current animation state of the segment to a defined value
 	 *
-	 * \param currentState The current state of the animation starting at 0, relative to it's absolute animation length.
-	 * 					   Over and undershoot is also possible.
+	 * \param progress The current progress of the animation as Q16.16 fixed point number, 0 is the start and #ANIMATION_PROGRESS_ONE the end.
+	 * 				   Over and undershoot is also possible.
 	 */
-	void tick(int32_t currentState);
+	void tick(AnimationProgress progress);
 
 	/**
 	 * \brief sets the color of the segment without displaying the change
@@ -72,8 +106,28 @@ public:
 
 	/**
 	 * \brief sets the color of the segment and updates it automatically in case the segment is turned on
+	 *
+	 * \param SegmentColor new color of the segment
+	 * \param fadeDuration [optional] default = 0; Time in ms to crossfade from the current color, the fade has to be advanced
+	 * 		  with #Segment::updateColorFade once per frame. 0 changes the color right away.
+	 * \param fadeEasing [optional] default = #NO_EASING; Easing applied to the crossfade
+	 */
+	void updateColor(CRGB SegmentColor, uint32_t fadeDuration = 0, const EasingBase* fadeEasing = NO_EASING);
+
+	/**
+	 * \brief Advance a crossfade started by #Segment::updateColor. Running animations pick up the intermediate color,
+	 * 		  a segment that is turned on and not animated gets it written to its LEDs.
+	 *
+	 * \param now current time in ms
+	 * \return true as long as the fade is running
+	 */
+	bool updateColorFade(uint32_t now);
+
+	/**
+	 * \brief Check if the LEDs of the segment were written since the last call and clear the flag.
+	 * 		  Lets the owner of the LED buffer process only the segments that changed.
 	 */
-	void updateColor(CRGB SegmentColor);
+	bool takeChanged();
 
 
 	/**
@@ -93,6 +147,17 @@ public:
 	 * \param newColor new color to use in for the current segment and animation
 	 */
 	void updateAnimationColor(CRGB newColor);
+
+	/**
+	 * \brief Blend from whatever the segment shows right now to fully on or off. Used to redirect a transition that is still running,
+	 * 		  the current LED state is captured once and replaces the animation that is running on the segment.
+	 * 		  Segments which already show the target, a duration of 0 and segments longer than #NUM_LEDS_PER_SEGMENT jump to the target right away.
+	 *
+	 * \param on true to blend to the animation color, false to blend to black
+	 * \param duration length of the blend in ms
+	 * \param easing [optional] default = #NO_EASING; Easing applied to the blend
+	 */
+	void retarget(bool on, uint32_t duration, const EasingBase* easing = NO_EASING);
 };
 
 
@@ -64,17 +64,62 @@ public:
 	};
 
 private:
+	friend class TransitionSynthesizer;
+
 	Segment* Segments[7];
 	SevenSegmentMode DsiplayMode;
-	static uint8_t segmentMap[10];
+	/**
+	 * \brief defines the mapping of a number to the segments
+	 */
+	static constexpr uint8_t segmentMap[10] = {
+		LeftTopSegment | MiddleTopSegment | RightTopSegment | LeftBottomSegment | MiddleBottomSegment | RightBottomSegment, // 0
+		RightTopSegment | RightBottomSegment, // 1
+		MiddleTopSegment | RightTopSegment | CenterSegment | LeftBottomSegment | MiddleBottomSegment, // 2
+		MiddleTopSegment | RightTopSegment | CenterSegment | MiddleBottomSegment | RightBottomSegment, // 3
+		LeftTopSegment | RightTopSegment | CenterSegment | RightBottomSegment, // 4
+		LeftTopSegment | MiddleTopSegment | CenterSegment | MiddleBottomSegment | RightBottomSegment, // 5
+		LeftTopSegment | MiddleTopSegment | CenterSegment | LeftBottomSegment | MiddleBottomSegment | RightBottomSegment, // 6
+		MiddleTopSegment | RightTopSegment | RightBottomSegment, // 7
+		LeftTopSegment | MiddleTopSegment | RightTopSegment | CenterSegment | LeftBottomSegment | MiddleBottomSegment | RightBottomSegment, // 8
+		LeftTopSegment | MiddleTopSegment | RightTopSegment | CenterSegment | MiddleBottomSegment | RightBottomSegment // 9
+	};
 	uint8_t currentValue;
 	bool isAnimationInitialized;
 	Animator* AnimationHandler;
+	Animator::ComplexAnimationID transitionID;
+	uint32_t transitionStart;
+	uint32_t transitionDuration;
 
 	uint8_t getIndexOfSegment(SegmentPosition positionInDisplay);
 	bool isConfigComplete();
+	uint8_t getSegmentMask(uint8_t value);
 	void DisplayNumberWithoutAnim(uint8_t value);
-	Animator::ComplexAmination* getTransition(uint8_t from, uint8_t to);
+	const Animator::ComplexAmination* getTransition(uint8_t from, uint8_t to);
+
+	/**
+	 * \brief Check if the last transition (or retarget) of this display is still running
+	 */
+	bool isTransitionRunning();
+
+	/**
+	 * \brief Time left until the last transition (or retarget) of this display is done
+	 *
+	 * \return uint32_t time in ms rounded up, 0 if it is done already
+	 */
+	uint32_t getRemainingTransitionTime();
+
+	/**
+	 * \brief Stop the running transition and blend every segment from its current state to the segment mask of value.
+	 * 		  Uses the remaining time of the transition, but at least #DIGIT_RETARGET_MIN_DURATION scaled to the animation speed. Nothing is allocated.
+	 *
+	 * \param value Number to display \range 0 - 9
+	 */
+	void retarget(uint8_t value);
+
+	/**
+	 * \brief Cancel the running transition without firing any further steps of it
+	 */
+	void cancelTransition();
 
 public:
 
@@ -100,7 +145,9 @@ public:
 	void add(Segment* segmentToAdd, SegmentPosition positionInDisplay);
 
 	/**
-	 * \brief Display a number on the display. If the display is not able to display the passed number nothing will happen
+	 * \brief Display a number on the display. If the display is not able to display the passed number nothing will happen.
+	 * 		  If the transition to the previous number is still running the display is retargeted instead of starting a new transition,
+	 * 		  so it can be called faster than #DIGIT_ANIMATION_SPEED.
 	 *
 	 * \param value Number to display \range 0 - 9
 	 */
@@ -141,11 +188,13 @@ public:
 	 * \brief Sets the current and also the animation color which will be displayed on the LEDs the next time the LEDs are updated
 	 *
 	 * \param color Color to set
+	 * \param fadeDuration [optional] default = 0; Time in ms to crossfade from the current color, see #Segment::updateColor
+	 * \param fadeEasing [optional] default = #NO_EASING; Easing applied to the crossfade
 	 */
-	void updateColor(CRGB color);
+	void updateColor(CRGB color, uint32_t fadeDuration = 0, const EasingBase* fadeEasing = NO_EASING);
 
 	/**
-	 * \brief Turn all LEDs in this seven segment display off. will be pushed to the LEDs with the next call of FastLED.show()
+	 * \brief Turn all LEDs in this seven segment display off and stop a running transition. will be pushed to the LEDs with the next call of FastLED.show()
 	 */
 	void off();
 };
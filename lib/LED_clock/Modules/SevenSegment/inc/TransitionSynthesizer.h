@@ -0,0 +1,244 @@
+/**
+ * \file TransitionSynthesizer.h
+ * \brief Compile time generator for transitions between any two digits of a seven segment display.
+ * 		  The transition is derived from the difference of the two segment masks:
+ * 			- segments that turn off retract into a neighbour that stays lit, the ones furthest away go first
+ * 			- segments that turn on grow out of a neighbour that stays lit, the ones closest to it go first
+ * 			- if there is no segment that stays lit the segments that change on the other side are used as anchor instead
+ * 			- segments without any anchor (for example when the display turns on or off) all animate in the first step
+ * 		  All functions are constexpr so that the resulting animation tables can be placed in flash, see #SynthesizedTransition.
+ */
+
+#ifndef __TRANSITION_SYNTHESIZER_H_
+#define __TRANSITION_SYNTHESIZER_H_
+
+#include <Arduino.h>
+#include "SevenSegment.h"
+#include "AnimationEffects.h"
+
+/**
+ * \brief Returned by #TransitionSynthesizer::step for segments that don't change during the transition
+ */
+#define TRANSITION_NO_STEP	0xFF
+
+/**
+ * \brief Compile time list of indices, used to expand the tables of a #SynthesizedTransition
+ */
+template<size_t... I>
+struct IndexSequence {};
+
+template<size_t N, size_t... I>
+struct MakeIndexSequence : MakeIndexSequence<N - 1, N - 1, I...> {};
+
+template<size_t... I>
+struct MakeIndexSequence<0, I...>
+{
+	typedef IndexSequence<I...> type;
+};
+
+class TransitionSynthesizer
+{
+private:
+	TransitionSynthesizer();
+
+	static constexpr uint8_t bit(uint8_t segment)
+	{
+		return 1 << segment;
+	}
+
+	static constexpr bool isHorizontal(uint8_t segment)
+	{
+		return segment == TOP_MIDDLE_SEGMENT || segment == CENTER_SEGMENT || segment == BOTTOM_MIDDLE_SEGMENT;
+	}
+
+	/**
+	 * \brief Segments which touch one end of a segment. End 0 is the top of vertical and the left of horizontal segments, end 1 the other one.
+	 */
+	static constexpr uint8_t endNeighbours(uint8_t segment, uint8_t end)
+	{
+		return segment == TOP_LEFT_SEGMENT 		? (end == 0 ? SevenSegment::MiddleTopSegment : SevenSegment::CenterSegment | SevenSegment::LeftBottomSegment) :
+			   segment == TOP_MIDDLE_SEGMENT 	? (end == 0 ? SevenSegment::LeftTopSegment : SevenSegment::RightTopSegment) :
+			   segment == TOP_RIGHT_SEGMENT 	? (end == 0 ? SevenSegment::MiddleTopSegment : SevenSegment::CenterSegment | SevenSegment::RightBottomSegment) :
+			   segment == CENTER_SEGMENT 		? (end == 0 ? SevenSegment::LeftTopSegment | SevenSegment::LeftBottomSegment : SevenSegment::RightTopSegment | SevenSegment::RightBottomSegment) :
+			   segment == BOTTOM_LEFT_SEGMENT 	? (end == 0 ? SevenSegment::LeftTopSegment | SevenSegment::CenterSegment : SevenSegment::MiddleBottomSegment) :
+			   segment == BOTTOM_MIDDLE_SEGMENT ? (end == 0 ? SevenSegment::LeftBottomSegment : SevenSegment::RightBottomSegment) :
+			   									  (end == 0 ? SevenSegment::RightTopSegment | SevenSegment::CenterSegment : SevenSegment::MiddleBottomSegment);
+	}
+
+	/**
+	 * \brief All segments touching at least one of the segments in mask
+	 */
+	static constexpr uint8_t adjacent(uint8_t mask, uint8_t segment = 0)
+	{
+		return segment >= 7 ? 0 :
+			((mask & bit(segment)) ? endNeighbours(segment, 0) | endNeighbours(segment, 1) : 0) | adjacent(mask, segment + 1);
+	}
+
+	/**
+	 * \brief Grow the anchor mask by iterations steps, only adding segments that are in allowed
+	 */
+	static constexpr uint8_t grow(uint8_t anchor, uint8_t allowed, uint8_t iterations)
+	{
+		return iterations == 0 ? anchor : grow(anchor | (adjacent(anchor) & allowed), allowed, iterations - 1);
+	}
+
+	/**
+	 * \brief Number of segments between anchor and segment, only walking over allowed segments. 0 if it can't be reached.
+	 */
+	static constexpr uint8_t distance(uint8_t segment, uint8_t anchor, uint8_t allowed, uint8_t iterations = 1)
+	{
+		return iterations > 7 ? 0 :
+			(grow(anchor, allowed, iterations) & bit(segment)) ? iterations : distance(segment, anchor, allowed, iterations + 1);
+	}
+
+	static constexpr uint8_t digitMask(uint8_t digit)
+	{
+		return digit < 10 ? SevenSegment::segmentMap[digit] : 0;
+	}
+
+	static constexpr uint8_t stable(uint8_t from, uint8_t to)
+	{
+		return digitMask(from) & digitMask(to);
+	}
+
+	static constexpr uint8_t outgoing(uint8_t from, uint8_t to)
+	{
+		return digitMask(from) & ~digitMask(to);
+	}
+
+	static constexpr uint8_t incoming(uint8_t from, uint8_t to)
+	{
+		return digitMask(to) & ~digitMask(from);
+	}
+
+	static constexpr uint8_t anchor(uint8_t from, uint8_t to, bool isOutgoing)
+	{
+		return stable(from, to) != 0 ? stable(from, to) : isOutgoing ? incoming(from, to) : outgoing(from, to);
+	}
+
+	static constexpr uint8_t allowed(uint8_t from, uint8_t to, bool isOutgoing)
+	{
+		return isOutgoing ? outgoing(from, to) : incoming(from, to);
+	}
+
+	static constexpr uint8_t segmentDistance(uint8_t from, uint8_t to, uint8_t segment)
+	{
+		return distance(segment, anchor(from, to, isOutgoing(from, to, segment)), allowed(from, to, isOutgoing(from, to, segment)));
+	}
+
+	static constexpr uint8_t maxOutgoingDistance(uint8_t from, uint8_t to, uint8_t segment = 0)
+	{
+		return segment >= 7 ? 0 :
+			larger(isOutgoing(from, to, segment) ? segmentDistance(from, to, segment) : 0, maxOutgoingDistance(from, to, segment + 1));
+	}
+
+	static constexpr uint8_t larger(uint8_t a, uint8_t b)
+	{
+		return a > b ? a : b;
+	}
+
+	/**
+	 * \brief End of the segment the animation is attached to: the one touching the neighbour that is one step closer to the anchor
+	 */
+	static constexpr uint8_t anchoredEnd(uint8_t from, uint8_t to, uint8_t segment)
+	{
+		return segmentDistance(from, to, segment) == 0 ? (isOutgoing(from, to, segment) ? 1 : 0) :
+			(endNeighbours(segment, 0) & grow(anchor(from, to, isOutgoing(from, to, segment)), allowed(from, to, isOutgoing(from, to, segment)), segmentDistance(from, to, segment) - 1)) ? 0 : 1;
+	}
+
+	static constexpr uint8_t stepWidth(uint8_t from, uint8_t to, uint8_t stepIndex, uint8_t segment = 0)
+	{
+		return segment >= 7 ? 0 : (step(from, to, segment) == stepIndex ? 1 : 0) + stepWidth(from, to, stepIndex, segment + 1);
+	}
+
+	static constexpr AnimatableObject::AnimationFunction effect(uint8_t from, uint8_t to, uint8_t segment)
+	{
+		return isOutgoing(from, to, segment) ?
+				(isHorizontal(segment) ?
+					(anchoredEnd(from, to, segment) == 0 ? AnimationEffects::AnimateOutToLeft : AnimationEffects::AnimateOutToRight) :
+					(anchoredEnd(from, to, segment) == 0 ? AnimationEffects::AnimateOutToTop : AnimationEffects::AnimateOutToBottom)) :
+				(isHorizontal(segment) ?
+					(anchoredEnd(from, to, segment) == 0 ? AnimationEffects::AnimateInToRight : AnimationEffects::AnimateInToLeft) :
+					(anchoredEnd(from, to, segment) == 0 ? AnimationEffects::AnimateInToBottom : AnimationEffects::AnimateInToTop));
+	}
+
+	/**
+	 * \brief Segment that is animated in the given column of a step, #TRANSITION_NO_STEP if the step has less columns
+	 */
+	static constexpr uint8_t segmentAt(uint8_t from, uint8_t to, uint8_t stepIndex, uint8_t column, uint8_t segment = 0)
+	{
+		return segment >= 7 ? TRANSITION_NO_STEP :
+			step(from, to, segment) != stepIndex ? segmentAt(from, to, stepIndex, column, segment + 1) :
+			column == 0 ? segment : segmentAt(from, to, stepIndex, column - 1, segment + 1);
+	}
+
+public:
+	/**
+	 * \brief Check if a segment turns off during the transition
+	 */
+	static constexpr bool isOutgoing(uint8_t from, uint8_t to, uint8_t segment)
+	{
+		return (outgoing(from, to) & bit(segment)) != 0;
+	}
+
+	/**
+	 * \brief Step of the transition in which a segment is animated
+	 *
+	 * \param from digit to transition from, #SEGMENT_OFF for a display that is off
+	 * \param to digit to transition to, #SEGMENT_OFF for a display that is off
+	 * \param segment one of #SegmentPositions_t
+	 * \return uint8_t index of the step or #TRANSITION_NO_STEP if the segment does not change
+	 */
+	static constexpr uint8_t step(uint8_t from, uint8_t to, uint8_t segment)
+	{
+		return isOutgoing(from, to, segment) ?
+				(segmentDistance(from, to, segment) == 0 ? 0 : maxOutgoingDistance(from, to) - segmentDistance(from, to, segment)) :
+			(incoming(from, to) & bit(segment)) ?
+				(segmentDistance(from, to, segment) == 0 ? 0 : segmentDistance(from, to, segment) - 1) :
+			TRANSITION_NO_STEP;
+	}
+
+	/**
+	 * \brief Number of steps of the transition
+	 */
+	static constexpr uint8_t numSteps(uint8_t from, uint8_t to, uint8_t segment = 0)
+	{
+		return segment >= 7 ? 0 :
+			larger(step(from, to, segment) == TRANSITION_NO_STEP ? 0 : step(from, to, segment) + 1, numSteps(from, to, segment + 1));
+	}
+
+	/**
+	 * \brief Maximum number of segments that are animated during one step of the transition
+	 */
+	static constexpr uint8_t numColumns(uint8_t from, uint8_t to, uint8_t stepIndex = 0)
+	{
+		return stepIndex >= numSteps(from, to) ? 0 : larger(stepWidth(from, to, stepIndex), numColumns(from, to, stepIndex + 1));
+	}
+
+	/**
+	 * \brief Entry of the arrayIndex table of a #Animator::ComplexAmination, cells are ordered step by step
+	 */
+	static constexpr int16_t segmentCell(uint8_t from, uint8_t to, size_t cell)
+	{
+		return segmentAt(from, to, cell / numColumns(from, to), cell % numColumns(from, to)) == TRANSITION_NO_STEP ? NO_SEGMENTS :
+			segmentAt(from, to, cell / numColumns(from, to), cell % numColumns(from, to));
+	}
+
+	/**
+	 * \brief Entry of the animationEffects table of a #Animator::ComplexAmination, cells are ordered step by step
+	 */
+	static constexpr AnimatableObject::AnimationFunction effectCell(uint8_t from, uint8_t to, size_t cell)
+	{
+		return segmentCell(from, to, cell) == NO_SEGMENTS ? NO_ANIMATION : effect(from, to, segmentCell(from, to, cell));
+	}
+
+	/**
+	 * \brief Check if the segment of a cell turns off, used to select the easing of the cell
+	 */
+	static constexpr bool isOutgoingCell(uint8_t from, uint8_t to, size_t cell)
+	{
+		return segmentCell(from, to, cell) != NO_SEGMENTS && isOutgoing(from, to, segmentCell(from, to, cell));
+	}
+};
+
+#endif
@@ -6,130 +6,256 @@
  * 			- All animations have to have the same prototype
  * 			- An animation function always has to set the state of all LEDs that it is affecting for every step. This is required because an
  * 			   animation can also be played backwards or multiple directions during the lifetime of one animation (for example a bounce easing)
- * 			- The animation always starts when the current step is 0, but undershoot is also possible so it also has to be considered what
- * 			  happens if current step goes negative. This should also result in a logical animation being displayed
- * 			- The current step can go higher than totalSteps, this would then be an overshoot. Same considerations as above should be taken into account.
+ * 			- The animation always starts when the progress is 0, but undershoot is also possible so it also has to be considered what
+ * 			  happens if the progress goes negative. This should also result in a logical animation being displayed
+ * 			- The progress can go higher than #ANIMATION_PROGRESS_ONE, this would then be an overshoot. Same considerations as above should be taken into account.
+ * 			- The progress is a Q16.16 fixed point number, the effects only use integer math since they are evaluated for every LED in every frame
+ *
+ * 		  During a frame of the #Animator the segments only queue their effect, #AnimationEffects::renderBatch then renders all of them in one pass.
+ * 		  The directional effects are all the same wipe with a mirrored or shifted progress, so the batch renders them inline with
+ * 		  parameters that are shared by all segments of the same length instead of calling each effect through its function pointer.
+ * 		  With #USE_INTENSITY_CACHE the brightness of every LED of the wipe only depends on the segment length and the progress,
+ * 		  it is precomputed once per length and rendering becomes a table lookup and a scale of the animation color per LED.
  */
 
 #include "AnimationEffects.h"
 
-AnimatableObject::AnimationFunction AnimationEffects::AnimateOutToRight = &OutToRight;
-AnimatableObject::AnimationFunction AnimationEffects::AnimateOutToBottom = &OutToRight;
-AnimatableObject::AnimationFunction AnimationEffects::AnimateOutToLeft = &OutToLeft;
-AnimatableObject::AnimationFunction AnimationEffects::AnimateOutToTop = &OutToLeft;
-AnimatableObject::AnimationFunction AnimationEffects::AnimateInToRight = &InToRight;
-AnimatableObject::AnimationFunction AnimationEffects::AnimateInToBottom = &InToRight;
-AnimatableObject::AnimationFunction AnimationEffects::AnimateInToLeft = &InToLeft;
-AnimatableObject::AnimationFunction AnimationEffects::AnimateInToTop = &InToLeft;
-AnimatableObject::AnimationFunction AnimationEffects::AnimateInToMiddle = &InToMiddle;
-AnimatableObject::AnimationFunction AnimationEffects::AnimateOutToMiddle = &OutToMiddle;
-AnimatableObject::AnimationFunction AnimationEffects::AnimateOutFromMiddle = &OutFromMiddle;
-AnimatableObject::AnimationFunction AnimationEffects::AnimateInFromMiddle = &InFromMiddle;
-AnimatableObject::AnimationFunction AnimationEffects::AnimateMiddleDotFlash = &MiddleDotFlash;
-
-void AnimationEffects::OutToRight(CRGB* leds, uint16_t length, CRGB animationColor, uint16_t totalSteps, int32_t currentStep, bool invert)
-{
-    if(invert == true)
-    {
-        OutToLeft(leds, length, animationColor, totalSteps, currentStep, false);
-        return;
-    }
-	uint16_t tailLength = length * ANIMATION_AFTERGLOW;
-	int32_t lastFullyLitLED = map(currentStep, 0, totalSteps, 0, length + tailLength + 1);
-    for (uint16_t i = 0; i < length; i++)
-    {
-        if(lastFullyLitLED <= i && lastFullyLitLED + length > i)
-        {
-            leds[i] = animationColor;
-        }
-        else
+constexpr AnimatableObject::AnimationFunction AnimationEffects::AnimateOutToRight;
+constexpr AnimatableObject::AnimationFunction AnimationEffects::AnimateOutToBottom;
+constexpr AnimatableObject::AnimationFunction AnimationEffects::AnimateOutToLeft;
+constexpr AnimatableObject::AnimationFunction AnimationEffects::AnimateOutToTop;
+constexpr AnimatableObject::AnimationFunction AnimationEffects::AnimateInToRight;
+constexpr AnimatableObject::AnimationFunction AnimationEffects::AnimateInToBottom;
+constexpr AnimatableObject::AnimationFunction AnimationEffects::AnimateInToLeft;
+constexpr AnimatableObject::AnimationFunction AnimationEffects::AnimateInToTop;
+constexpr AnimatableObject::AnimationFunction AnimationEffects::AnimateInToMiddle;
+constexpr AnimatableObject::AnimationFunction AnimationEffects::AnimateOutToMiddle;
+constexpr AnimatableObject::AnimationFunction AnimationEffects::AnimateOutFromMiddle;
+constexpr AnimatableObject::AnimationFunction AnimationEffects::AnimateInFromMiddle;
+constexpr AnimatableObject::AnimationFunction AnimationEffects::AnimateMiddleDotFlash;
+
+AnimationEffects::EffectJob AnimationEffects::batch[ANIMATOR_MAX_OBJECTS];
+uint8_t AnimationEffects::batchSize = 0;
+#if USE_INTENSITY_CACHE == true
+AnimationEffects::IntensityTable AnimationEffects::intensityCache[ANIMATION_INTENSITY_CACHE_SLOTS];
+uint8_t AnimationEffects::intensityCacheSize = 0;
+#endif
+
+void AnimationEffects::queue(CRGB* leds, uint16_t length, CRGB animationColor, AnimatableObject::AnimationProgress progress, AnimatableObject::AnimationFunction effect, bool invert)
+{
+	if(batchSize >= ANIMATOR_MAX_OBJECTS)
+	{
+		effect(leds, length, animationColor, progress, invert);
+		return;
+	}
+	EffectJob& job = batch[batchSize++];
+	job.leds = leds;
+	job.length = length;
+	job.color = animationColor;
+	job.progress = progress;
+	job.effect = effect;
+	job.invert = invert;
+}
+
+void AnimationEffects::renderBatch(void* context)
+{
+	for (uint8_t i = 0; i < batchSize; i++)
+	{
+		EffectJob& job = batch[i];
+		AnimatableObject::AnimationProgress wipeProgress;
+		//all directional effects are the same wipe with a mirrored or shifted progress, render them inline
+		if(job.effect == AnimateOutToRight)
 		{
-			uint16_t microsteps = totalSteps / (length + tailLength);
-			int32_t dimmingSteps = microsteps * tailLength;
-			CRGB newColor = animationColor;
-			if (i < lastFullyLitLED + length)
-			{
-				uint16_t startToDim = microsteps * i;
-				if(currentStep < startToDim)
-				{
-					leds[i] = animationColor;
-				}
-				else
-				{
-					uint8_t dimDegree = constrain((((double)currentStep - startToDim) / ((double)dimmingSteps)) * 255.0, 0, 255);
-					leds[i] = newColor.fadeToBlackBy(dimDegree);
-				}
-			}
-			else
-			{
-				int32_t startToDim = microsteps * (i - length);
-				if(currentStep > startToDim)
-				{
-					leds[i] = animationColor;
-				}
-				else
-				{
-					uint8_t dimDegree = constrain(((double)(currentStep - startToDim) / ((double)dimmingSteps) * -255.0), 0, 255);
-					leds[i] = newColor.fadeToBlackBy(dimDegree);
-				}
-			}
+			wipeProgress = job.invert == true ? -job.progress : job.progress;
 		}
-    }
+		else if(job.effect == AnimateOutToLeft)
+		{
+			wipeProgress = job.invert == true ? job.progress : -job.progress;
+		}
+		else if(job.effect == AnimateInToRight)
+		{
+			wipeProgress = job.invert == true ? ANIMATION_PROGRESS_ONE - job.progress : job.progress - ANIMATION_PROGRESS_ONE;
+		}
+		else if(job.effect == AnimateInToLeft)
+		{
+			wipeProgress = job.invert == true ? job.progress - ANIMATION_PROGRESS_ONE : ANIMATION_PROGRESS_ONE - job.progress;
+		}
+		else
+		{
+			job.effect(job.leds, job.length, job.color, job.progress, job.invert);
+			continue;
+		}
+		renderWipe(job.leds, job.length, job.color, wipeProgress);
+	}
+	batchSize = 0;
+}
+
+void AnimationEffects::prepareIntensityTable(uint16_t length)
+{
+#if USE_INTENSITY_CACHE == true
+	getIntensityTable(length);
+#endif
+}
+
+AnimationEffects::WipeParameters AnimationEffects::getWipeParameters(uint16_t length)
+{
+	WipeParameters parameters;
+	parameters.tailLength = ((uint32_t)length * (uint16_t)(ANIMATION_AFTERGLOW * 256)) >> 8;
+	parameters.microsteps = length + parameters.tailLength > 0 ? ANIMATION_PROGRESS_ONE / (length + parameters.tailLength) : 0;
+	parameters.dimmingSteps = parameters.microsteps * parameters.tailLength;
+	return parameters;
+}
+
+uint8_t AnimationEffects::getWipeIntensity(int32_t led, uint16_t length, AnimatableObject::AnimationProgress progress, const WipeParameters& parameters)
+{
+	int32_t lastFullyLitLED = progress * (length + parameters.tailLength + 1) / ANIMATION_PROGRESS_ONE;
+	if(lastFullyLitLED <= led && lastFullyLitLED + length > led)
+	{
+		return 255;
+	}
+	if(led < lastFullyLitLED + length)
+	{
+		int32_t startToDim = parameters.microsteps * led;
+		if(progress < startToDim)
+		{
+			return 255;
+		}
+		return parameters.dimmingSteps > 0 ? 255 - constrain((progress - startToDim) * 255 / parameters.dimmingSteps, 0, 255) : 0;
+	}
+	int32_t startToDim = parameters.microsteps * (led - length);
+	if(progress > startToDim)
+	{
+		return 255;
+	}
+	return parameters.dimmingSteps > 0 ? 255 - constrain((startToDim - progress) * 255 / parameters.dimmingSteps, 0, 255) : 0;
+}
+
+void AnimationEffects::renderWipe(CRGB* leds, uint16_t length, CRGB animationColor, AnimatableObject::AnimationProgress progress)
+{
+#if USE_INTENSITY_CACHE == true
+	const IntensityTable* table = getIntensityTable(length);
+	if(table != nullptr)
+	{
+		renderWipe(leds, length, animationColor, progress, table);
+		return;
+	}
+#endif
+	renderWipe(leds, length, animationColor, progress, getWipeParameters(length));
+}
+
+void AnimationEffects::renderWipe(CRGB* leds, uint16_t length, CRGB animationColor, AnimatableObject::AnimationProgress progress, const WipeParameters& parameters)
+{
+	if(length == 0)
+	{
+		return;
+	}
+	int32_t lastFullyLitLED = progress * (length + parameters.tailLength + 1) / ANIMATION_PROGRESS_ONE;
+	//LEDs in [litStart, litEnd) are fully lit, only the ones around it have to be calculated one by one
+	int32_t litStart = constrain(lastFullyLitLED, 0, (int32_t)length);
+	int32_t litEnd = constrain(lastFullyLitLED + length, 0, (int32_t)length);
+	if(litEnd > litStart)
+	{
+		fill_solid(&leds[litStart], litEnd - litStart, animationColor);
+	}
+	for (int32_t i = 0; i < litStart; i++)
+	{
+		leds[i] = animationColor;
+		leds[i].nscale8(getWipeIntensity(i, length, progress, parameters));
+	}
+	for (int32_t i = litEnd; i < length; i++)
+	{
+		leds[i] = animationColor;
+		leds[i].nscale8(getWipeIntensity(i, length, progress, parameters));
+	}
+}
+
+#if USE_INTENSITY_CACHE == true
+const AnimationEffects::IntensityTable* AnimationEffects::getIntensityTable(uint16_t length)
+{
+	for (uint8_t i = 0; i < intensityCacheSize; i++)
+	{
+		if(intensityCache[i].length == length)
+		{
+			return &intensityCache[i];
+		}
+	}
+	if(length == 0 || length > NUM_LEDS_PER_SEGMENT || intensityCacheSize >= ANIMATION_INTENSITY_CACHE_SLOTS)
+	{
+		return nullptr;
+	}
+	IntensityTable& table = intensityCache[intensityCacheSize++];
+	table.length = length;
+	WipeParameters parameters = getWipeParameters(length);
+	for (uint16_t row = 0; row < INTENSITY_CACHE_ROWS; row++)
+	{
+		AnimatableObject::AnimationProgress progress = ((int32_t)row - ANIMATION_INTENSITY_STEPS) * ANIMATION_PROGRESS_ONE / ANIMATION_INTENSITY_STEPS;
+		for (uint16_t led = 0; led < length; led++)
+		{
+			table.intensities[row][led] = getWipeIntensity(led, length, progress, parameters);
+		}
+	}
+	return &table;
+}
+
+void AnimationEffects::renderWipe(CRGB* leds, uint16_t length, CRGB animationColor, AnimatableObject::AnimationProgress progress, const IntensityTable* table)
+{
+	//the wipe is off outside of -1 and 1, so the first and last row cover any under- and overshoot
+	uint32_t position = (uint32_t)(constrain(progress, -ANIMATION_PROGRESS_ONE, ANIMATION_PROGRESS_ONE) + ANIMATION_PROGRESS_ONE) * ANIMATION_INTENSITY_STEPS;
+	uint16_t row = position >> 16;
+	uint8_t fraction = position >> 8;
+	const uint8_t* current = table->intensities[row];
+	const uint8_t* next = row + 1 < INTENSITY_CACHE_ROWS ? table->intensities[row + 1] : current;
+	for (uint16_t i = 0; i < length; i++)
+	{
+		leds[i] = animationColor;
+		leds[i].nscale8(lerp8by8(current[i], next[i], fraction));
+	}
+}
+#endif
+
+void AnimationEffects::OutToRight(CRGB* leds, uint16_t length, CRGB animationColor, AnimatableObject::AnimationProgress progress, bool invert)
+{
+	renderWipe(leds, length, animationColor, invert == true ? -progress : progress);
 }
 
-void AnimationEffects::OutToLeft(CRGB* leds, uint16_t length, CRGB animationColor, uint16_t totalSteps, int32_t currentStep, bool invert)
+void AnimationEffects::OutToLeft(CRGB* leds, uint16_t length, CRGB animationColor, AnimatableObject::AnimationProgress progress, bool invert)
 {
-    if(invert == true)
-    {
-        OutToRight(leds, length, animationColor, totalSteps, currentStep, false);
-        return;
-    }
-    OutToRight(leds, length, animationColor, totalSteps, -currentStep, false);
+	renderWipe(leds, length, animationColor, invert == true ? progress : -progress);
 }
 
-void AnimationEffects::InToRight(CRGB* leds, uint16_t length, CRGB animationColor, uint16_t totalSteps, int32_t currentStep, bool invert)
+void AnimationEffects::InToRight(CRGB* leds, uint16_t length, CRGB animationColor, AnimatableObject::AnimationProgress progress, bool invert)
 {
-	if(invert == true)
-    {
-        InToLeft(leds, length, animationColor, totalSteps, currentStep, false);
-        return;
-    }
-    OutToRight(leds, length, animationColor, totalSteps, currentStep - totalSteps, false);
+	renderWipe(leds, length, animationColor, invert == true ? ANIMATION_PROGRESS_ONE - progress : progress - ANIMATION_PROGRESS_ONE);
 }
 
-void AnimationEffects::InToLeft(CRGB* leds, uint16_t length, CRGB animationColor, uint16_t totalSteps, int32_t currentStep, bool invert)
+void AnimationEffects::InToLeft(CRGB* leds, uint16_t length, CRGB animationColor, AnimatableObject::AnimationProgress progress, bool invert)
 {
-    if(invert == true)
-    {
-        InToRight(leds, length, animationColor, totalSteps, currentStep, false);
-        return;
-    }
-    OutToRight(leds, length, animationColor, totalSteps, (-currentStep) + totalSteps, false);
+	renderWipe(leds, length, animationColor, invert == true ? progress - ANIMATION_PROGRESS_ONE : ANIMATION_PROGRESS_ONE - progress);
 }
 
-void AnimationEffects::InToMiddle(CRGB* leds, uint16_t length, CRGB animationColor, uint16_t totalSteps, int32_t currentStep, bool invert)
+void AnimationEffects::InToMiddle(CRGB* leds, uint16_t length, CRGB animationColor, AnimatableObject::AnimationProgress progress, bool invert)
 {
 	//TBD
-    InToRight(leds, length / 2, animationColor, totalSteps, currentStep, invert);
-	InToLeft(&leds[length / 2], length / 2, animationColor, totalSteps, currentStep, invert);
+    InToRight(leds, length / 2, animationColor, progress, invert);
+	InToLeft(&leds[length / 2], length / 2, animationColor, progress, invert);
 }
 
-void AnimationEffects::OutToMiddle(CRGB* leds, uint16_t length, CRGB animationColor, uint16_t totalSteps, int32_t currentStep, bool invert)
+void AnimationEffects::OutToMiddle(CRGB* leds, uint16_t length, CRGB animationColor, AnimatableObject::AnimationProgress progress, bool invert)
 {
     //TBD
 }
 
-void AnimationEffects::OutFromMiddle(CRGB* leds, uint16_t length, CRGB animationColor, uint16_t totalSteps, int32_t currentStep, bool invert)
+void AnimationEffects::OutFromMiddle(CRGB* leds, uint16_t length, CRGB animationColor, AnimatableObject::AnimationProgress progress, bool invert)
 {
     //TBD
 }
 
-void AnimationEffects::InFromMiddle(CRGB* leds, uint16_t length, CRGB animationColor, uint16_t totalSteps, int32_t currentStep, bool invert)
+void AnimationEffects::InFromMiddle(CRGB* leds, uint16_t length, CRGB animationColor, AnimatableObject::AnimationProgress progress, bool invert)
 {
     //TBD
 }
 
-void AnimationEffects::MiddleDotFlash(CRGB* leds, uint16_t length, CRGB animationColor, uint16_t totalSteps, int32_t currentStep, bool invert)
+void AnimationEffects::MiddleDotFlash(CRGB* leds, uint16_t length, CRGB animationColor, AnimatableObject::AnimationProgress progress, bool invert)
 {
 	CRGB newColor = animationColor;
 	uint8_t fadeAmount = 0;
@@ -137,13 +263,13 @@ void AnimationEffects::MiddleDotFlash(CRGB* leds, uint16_t length, CRGB animatio
 	{
 		leds[i] = CRGB::Black;
 	}
-	if(currentStep < totalSteps / 2)
+	if(progress < ANIMATION_PROGRESS_ONE / 2)
 	{
-		fadeAmount = map(currentStep, 0, totalSteps / 2, 255, 0);
+		fadeAmount = constrain(map(progress, 0, ANIMATION_PROGRESS_ONE / 2, 255, 0), 0, 255);
 	}
 	else
 	{
-		fadeAmount = map(currentStep, totalSteps / 2, totalSteps, 0, 255);
+		fadeAmount = constrain(map(progress, ANIMATION_PROGRESS_ONE / 2, ANIMATION_PROGRESS_ONE, 0, 255), 0, 255);
 	}
 	leds[(length - 1) / 2] = newColor.fadeToBlackBy(fadeAmount);
     if(length % 2 == 0)
@@ -0,0 +1,17 @@
+/**
+ * \file ColorFade.cpp
+ * \author Florian Laschober
+ * \brief Implementation of the member functions of the ColorFade class
+ */
+
+#include "ColorFade.h"
+
+ColorFade::ColorFade(CRGB initialColor) : EasedTransition(initialColor)
+{
+}
+
+CRGB ColorFade::interpolate(CRGB from, CRGB to, AnimatableObject::AnimationProgress progress)
+{
+	uint8_t amount = progress <= 0 ? 0 : progress >= ANIMATION_PROGRESS_ONE ? 255 : progress >> 8;
+	return blend(from, to, amount);
+}
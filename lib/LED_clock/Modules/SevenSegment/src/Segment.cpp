@@ -5,14 +5,23 @@
  */
 
 #include "Segment.h"
+#include "Animator.h"
+#include "AnimationEffects.h"
 
-Segment::Segment(CRGB LEDBuffer[], uint16_t indexOfFirstLEDInSegment, uint8_t segmentLength, direction Direction, CRGB segmentColor) : AnimatableObject(0, 0)
+Segment::Segment(CRGB LEDBuffer[], uint16_t indexOfFirstLEDInSegment, uint8_t segmentLength, direction Direction, CRGB segmentColor, uint8_t stripID) : AnimatableObject(0, 0)
 {
+	LEDStrip = stripID;
 	leds = &LEDBuffer[indexOfFirstLEDInSegment];
 	invertDirection = Direction;
 	length = segmentLength;
 	color = segmentColor;
 	AnimationColor = color;
+	retargeting = false;
+	retargetOn = false;
+	colorFade.jumpTo(color);
+	lit = false;
+	litValid = false;
+	changed = true;
 }
 
 Segment::~Segment()
@@ -22,29 +31,77 @@ Segment::~Segment()
 
 void Segment::display()
 {
-	writeToLEDs(color);
+	writeToLEDs(colorFade.getColor());
 }
 
 void Segment::writeToLEDs(CRGB colorToSet)
 {
+	bool changed = false;
 	for (int i = 0; i < length; i++)
 	{
-		leds[i] = colorToSet;
+		if(leds[i] != colorToSet)
+		{
+			leds[i] = colorToSet;
+			changed = true;
+		}
+	}
+	lit = (bool)colorToSet;
+	litValid = true;
+	if(changed == true)
+	{
+		markDirty();
+	}
+}
+
+void Segment::markDirty()
+{
+	changed = true;
+	if(scheduler != nullptr)
+	{
+		scheduler->markStripDirty(LEDStrip);
 	}
 }
 
-void Segment::updateColor(CRGB SegmentColor)
+void Segment::updateColor(CRGB SegmentColor, uint32_t fadeDuration, const EasingBase* fadeEasing)
 {
-	setColor(SegmentColor);
+	if(fadeDuration == 0)
+	{
+		setColor(SegmentColor);
+		if(animationStarted == false && isOn() == true)
+		{
+			display();
+		}
+		return;
+	}
+	color = SegmentColor;
+	colorFade.start(SegmentColor, fadeDuration, millis(), fadeEasing);
+}
+
+bool Segment::updateColorFade(uint32_t now)
+{
+	if(colorFade.update(now) == false)
+	{
+		return colorFade.isRunning(); // a slow fade does not change the color every frame
+	}
+	AnimationColor = colorFade.getColor();
 	if(animationStarted == false && isOn() == true)
 	{
-		display();
+		writeToLEDs(AnimationColor);
 	}
+	return colorFade.isRunning();
+}
+
+bool Segment::takeChanged()
+{
+	bool wasChanged = changed;
+	changed = false;
+	return wasChanged;
 }
 
 void Segment::setColor(CRGB SegmentColor)
 {
 	color = SegmentColor;
+	colorFade.jumpTo(color);
 	updateAnimationColor(color);
 	//updateAnimationColor(CRGB::Blue);
 }
@@ -56,25 +113,89 @@ void Segment::off()
 
 bool Segment::isOn()
 {
+	if(litValid == true)
+	{
+		return lit;
+	}
+	lit = false;
 	for (int i = 0; i < length; i++)
 	{
 		if(leds[i].r != 0 || leds[i].g != 0 || leds[i].b != 0 )
 		{
-			return true;
+			lit = true;
+			break;
 		}
 	}
-	return false;
+	litValid = true;
+	return lit;
 }
 
-void Segment::tick(int32_t currentState)
+void Segment::tick(AnimationProgress progress)
 {
+	if(retargeting == true)
+	{
+		uint8_t amount = progress <= 0 ? 0 : progress >= ANIMATION_PROGRESS_ONE ? 255 : progress >> 8;
+		CRGB target = retargetOn == true ? AnimationColor : CRGB(CRGB::Black);
+		for (uint8_t i = 0; i < length; i++)
+		{
+			leds[i] = blend(retargetFrom[i], target, amount);
+		}
+		litValid = false;
+		markDirty();
+		return;
+	}
     if(effect != nullptr)
     {
-		effect(leds, length, AnimationColor, numStates, currentState, invertDirection);
+		if(scheduler != nullptr && scheduler->isBatchingFrame() == true)
+		{
+			AnimationEffects::queue(leds, length, AnimationColor, progress, effect, invertDirection);
+		}
+		else
+		{
+			effect(leds, length, AnimationColor, progress, invertDirection);
+		}
+		litValid = false;
+		markDirty();
     }
 }
 
 void Segment::updateAnimationColor(CRGB newColor)
 {
 	AnimationColor = newColor;
-}
\ No newline at end of file
+}
+void Segment::setAnimationEffect(AnimatableObject::AnimationFunction newEffect)
+{
+	retargeting = false;
+	AnimatableObject::setAnimationEffect(newEffect);
+}
+
+void Segment::retarget(bool on, uint32_t duration, const EasingBase* easing)
+{
+	CRGB target = on == true ? AnimationColor : CRGB(CRGB::Black);
+	bool atTarget = true;
+	for (uint8_t i = 0; i < length; i++)
+	{
+		if(leds[i] != target)
+		{
+			atTarget = false;
+			break;
+		}
+	}
+	if(atTarget == true || duration == 0 || length > NUM_LEDS_PER_SEGMENT)
+	{
+		//whatever is still running on the segment must not overwrite the target afterwards
+		reset();
+		retargeting = false;
+		writeToLEDs(target);
+		return;
+	}
+	for (uint8_t i = 0; i < length; i++)
+	{
+		retargetFrom[i] = leds[i];
+	}
+	retargetOn = on;
+	retargeting = true;
+	setAnimationDuration(duration);
+	setAnimationEasing(easing);
+	start();
+}
@@ -5,27 +5,17 @@
  */
 
 #include "SevenSegment.h"
-/**
- * \brief defines the mapping of a number to the segments
- */
-uint8_t SevenSegment::segmentMap[10] = {
-	LeftTopSegment | MiddleTopSegment | RightTopSegment | LeftBottomSegment | MiddleBottomSegment | RightBottomSegment, // 0
-	RightTopSegment | RightBottomSegment, // 1
-	MiddleTopSegment | RightTopSegment | CenterSegment | LeftBottomSegment | MiddleBottomSegment, // 2
-	MiddleTopSegment | RightTopSegment | CenterSegment | MiddleBottomSegment | RightBottomSegment, // 3
-	LeftTopSegment | RightTopSegment | CenterSegment | RightBottomSegment, // 4
-	LeftTopSegment | MiddleTopSegment | CenterSegment | MiddleBottomSegment | RightBottomSegment, // 5
-	LeftTopSegment | MiddleTopSegment | CenterSegment | LeftBottomSegment | MiddleBottomSegment | RightBottomSegment, // 6
-	MiddleTopSegment | RightTopSegment | RightBottomSegment, // 7
-	LeftTopSegment | MiddleTopSegment | RightTopSegment | CenterSegment | LeftBottomSegment | MiddleBottomSegment | RightBottomSegment, // 8
-	LeftTopSegment | MiddleTopSegment | RightTopSegment | CenterSegment | MiddleBottomSegment | RightBottomSegment // 9
-};
+constexpr uint8_t SevenSegment::segmentMap[10];
 
 SevenSegment::SevenSegment(SevenSegmentMode mode, Animator* DisplayAnimationHandler)
 {
 	DsiplayMode = mode;
 	AnimationHandler = DisplayAnimationHandler;
 	isAnimationInitialized = false;
+	currentValue = SEGMENT_OFF;
+	transitionID = INVALID_COMPLEX_ANIMATION_ID;
+	transitionStart = 0;
+	transitionDuration = 0;
 	for (uint8_t i = 0; i < 7; i++)
 	{
 		Segments[i] = nullptr;
@@ -81,59 +71,28 @@ void SevenSegment::add(Segment* segmentToAdd, SegmentPosition positionInDisplay)
 	AnimationHandler->add(segmentToAdd);
 }
 
-//TODO: maybe put this into a loop, it takes a lot of memory
-void SevenSegment::DisplayNumberWithoutAnim(uint8_t value)
+uint8_t SevenSegment::getSegmentMask(uint8_t value)
 {
-	uint8_t currentSegmentMap = 0x00;
 	if((value >= 0 && value <= 9 && DsiplayMode == FULL_SEGMENT) || (value == 1 && DsiplayMode == ONLY_ONE)) //check if value can be displayed otherwise turn off all segments
 	{
-		currentSegmentMap = segmentMap[value];
-	}
-
-	Segment* CurrentSegment = Segments[getIndexOfSegment(LeftTopSegment)];
-	if(CurrentSegment != nullptr)
-	{
-		currentSegmentMap & LeftTopSegment ? CurrentSegment->display() : CurrentSegment->off();
-	}
-
-	CurrentSegment = Segments[getIndexOfSegment(MiddleTopSegment)];
-	if(CurrentSegment != nullptr)
-	{
-		currentSegmentMap & MiddleTopSegment ? CurrentSegment->display() : CurrentSegment->off();
-	}
-
-	CurrentSegment = Segments[getIndexOfSegment(RightTopSegment)];
-	if(CurrentSegment != nullptr)
-	{
-		currentSegmentMap & RightTopSegment ? CurrentSegment->display() : CurrentSegment->off();
-	}
-
-	CurrentSegment = Segments[getIndexOfSegment(CenterSegment)];
-	if(CurrentSegment != nullptr)
-	{
-		currentSegmentMap & CenterSegment ? CurrentSegment->display() : CurrentSegment->off();
-	}
-
-	CurrentSegment = Segments[getIndexOfSegment(LeftBottomSegment)];
-	if(CurrentSegment != nullptr)
-	{
-		currentSegmentMap & LeftBottomSegment  ? CurrentSegment->display() : CurrentSegment->off();
-	}
-
-	CurrentSegment = Segments[getIndexOfSegment(MiddleBottomSegment)];
-	if(CurrentSegment != nullptr)
-	{
-		currentSegmentMap & MiddleBottomSegment ? CurrentSegment->display() : CurrentSegment->off();
+		return segmentMap[value];
 	}
+	return 0x00;
+}
 
-	CurrentSegment = Segments[getIndexOfSegment(RightBottomSegment)];
-	if(CurrentSegment != nullptr)
+void SevenSegment::DisplayNumberWithoutAnim(uint8_t value)
+{
+	uint8_t currentSegmentMap = getSegmentMask(value);
+	for (uint8_t i = 0; i < 7; i++)
 	{
-		currentSegmentMap & RightBottomSegment ? CurrentSegment->display() : CurrentSegment->off();
+		if(Segments[i] != nullptr)
+		{
+			currentSegmentMap & (1 << i) ? Segments[i]->display() : Segments[i]->off();
+		}
 	}
 }
 
-Animator::ComplexAmination* SevenSegment::getTransition(uint8_t from, uint8_t to)
+const Animator::ComplexAmination* SevenSegment::getTransition(uint8_t from, uint8_t to)
 {
 	if(from <= 10 && to <= 10)
 	{
@@ -151,7 +110,16 @@ void SevenSegment::DisplayNumber(uint8_t value)
 	{
 		return;
 	}
-	Animator::ComplexAmination* anim = nullptr;
+	if(isTransitionRunning() == true)
+	{
+		if(value != currentValue)
+		{
+			retarget(value);
+			currentValue = value;
+		}
+		return;
+	}
+	const Animator::ComplexAmination* anim = nullptr;
 	if(DsiplayMode == ONLY_ONE)
 	{
 		if(currentValue != 1 && value == 1)
@@ -166,17 +134,60 @@ void SevenSegment::DisplayNumber(uint8_t value)
 	{
 		anim = getTransition(currentValue, value);
 	}
-	if(anim != nullptr)
+	transitionID = anim == nullptr ? INVALID_COMPLEX_ANIMATION_ID : AnimationHandler->PlayComplexAnimation(anim, (AnimatableObject**)Segments);
+	if(transitionID == INVALID_COMPLEX_ANIMATION_ID)
 	{
-		AnimationHandler->PlayComplexAnimation(anim, (AnimatableObject**)Segments);
+		DisplayNumberWithoutAnim(value);
 	}
 	else
 	{
-		DisplayNumberWithoutAnim(value);
+		transitionStart = AnimationHandler->now();
+		transitionDuration = AnimationHandler->getScaledDuration((uint32_t)anim->LengthPerAnimation * anim->numSteps) * 1000;
 	}
 	currentValue = value;
 }
 
+bool SevenSegment::isTransitionRunning()
+{
+	//the steps of a chain only advance once per frame, so it can run a bit longer than its nominal duration
+	return AnimationHandler->isComplexAnimationRunning(transitionID) == true || getRemainingTransitionTime() > 0;
+}
+
+uint32_t SevenSegment::getRemainingTransitionTime()
+{
+	uint32_t elapsed = AnimationHandler->now() - transitionStart;
+	return elapsed < transitionDuration ? (transitionDuration - elapsed + 999) / 1000 : 0;
+}
+
+void SevenSegment::retarget(uint8_t value)
+{
+	uint32_t duration = getRemainingTransitionTime();
+	uint32_t minDuration = AnimationHandler->getScaledDuration(DIGIT_RETARGET_MIN_DURATION);
+	if(duration < minDuration)
+	{
+		duration = minDuration;
+	}
+	cancelTransition();
+	uint8_t targetMask = getSegmentMask(value);
+	for (uint8_t i = 0; i < 7; i++)
+	{
+		if(Segments[i] != nullptr)
+		{
+			Segments[i]->retarget(targetMask & (1 << i), duration, RetargetEasing);
+		}
+	}
+	transitionStart = AnimationHandler->now();
+	transitionDuration = duration * 1000;
+}
+
+void SevenSegment::cancelTransition()
+{
+	//ends the chain right away, so none of its remaining steps can overwrite the segments anymore
+	AnimationHandler->releaseComplexAnimation(transitionID);
+	transitionID = INVALID_COMPLEX_ANIMATION_ID;
+	transitionDuration = 0;
+}
+
 void SevenSegment::FlashMiddleDot(uint8_t numDots)
 {
 	if(DsiplayMode != ONLY_ONE)
@@ -209,24 +220,25 @@ void SevenSegment::setColor(CRGB color)
 	}
 }
 
-void SevenSegment::updateColor(CRGB color)
+void SevenSegment::updateColor(CRGB color, uint32_t fadeDuration, const EasingBase* fadeEasing)
 {
 	for (uint8_t i = 0; i < 7; i++)
 	{
 		if(Segments[i] != nullptr)
 		{
-			Segments[i]->updateColor(color);
+			Segments[i]->updateColor(color, fadeDuration, fadeEasing);
 		}
 	}
 }
 
 void SevenSegment::off()
 {
+	cancelTransition();
 	for (uint8_t i = 0; i < 7; i++)
 	{
 		if(Segments[i] != nullptr)
 		{
-			Segments[i]->off();
+			Segments[i]->retarget(false, 0);
 		}
 	}
 }
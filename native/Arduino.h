@@ -0,0 +1,156 @@
+/**
+ * \file Arduino.h
+ * \brief Minimal Arduino core shim for native (host) builds of the LED clock library.
+ *        Only the subset of the API that the library actually uses is provided. All timing functions
+ *        are routed through #VirtualClock.
+ */
+
+#ifndef __NATIVE_ARDUINO_H_
+#define __NATIVE_ARDUINO_H_
+
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdarg.h>
+#include <math.h>
+#include <time.h>
+#include <string>
+#include "VirtualClock.h"
+
+#define IRAM_ATTR
+#define PROGMEM
+#define F(string_literal) (string_literal)
+
+#define constrain(amt, low, high) ((amt) < (low) ? (low) : ((amt) > (high) ? (high) : (amt)))
+
+typedef uint8_t byte;
+typedef bool boolean;
+
+inline unsigned long millis()
+{
+	return VirtualClock::micros() / 1000;
+}
+
+inline unsigned long micros()
+{
+	return VirtualClock::micros();
+}
+
+inline void delay(uint32_t ms)
+{
+	VirtualClock::sleep((uint64_t)ms * 1000);
+}
+
+inline void delayMicroseconds(uint32_t us)
+{
+	VirtualClock::sleep(us);
+}
+
+inline void yield()
+{
+}
+
+inline long map(long x, long in_min, long in_max, long out_min, long out_max)
+{
+	if(in_max == in_min)
+	{
+		return out_min;
+	}
+	return (x - in_min) * (out_max - out_min) / (in_max - in_min) + out_min;
+}
+
+inline uint16_t analogRead(uint8_t pin)
+{
+	return 0;
+}
+
+/**
+ * \brief Small subset of the Arduino String class
+ */
+class String
+{
+private:
+	std::string data;
+
+public:
+	String() {}
+	String(const char* str) : data(str != nullptr ? str : "") {}
+	String(const std::string& str) : data(str) {}
+	String(char c) : data(1, c) {}
+	String(int value) : data(std::to_string(value)) {}
+	String(unsigned int value) : data(std::to_string(value)) {}
+	String(long value) : data(std::to_string(value)) {}
+	String(unsigned long value) : data(std::to_string(value)) {}
+	String(double value) { char buf[32]; snprintf(buf, sizeof(buf), "%.2f", value); data = buf; }
+
+	const char* c_str() const { return data.c_str(); }
+	unsigned int length() const { return data.length(); }
+	long toInt() const { return atol(data.c_str()); }
+
+	String& operator+=(const String& other) { data += other.data; return *this; }
+	friend String operator+(const String& a, const String& b) { return String(a.data + b.data); }
+	bool operator==(const String& other) const { return data == other.data; }
+	bool operator!=(const String& other) const { return data != other.data; }
+};
+
+/**
+ * \brief Serial port shim. Writes everything to stderr to keep stdout free for benchmark reports.
+ */
+class HardwareSerial
+{
+public:
+	void begin(unsigned long baud) {}
+	int availableForWrite() { return 1; }
+
+	size_t printf(const char* format, ...)
+	{
+		va_list args;
+		va_start(args, format);
+		int written = vfprintf(stderr, format, args);
+		va_end(args);
+		return written;
+	}
+
+	size_t print(const char* str) { return fputs(str, stderr); }
+	size_t print(const String& str) { return print(str.c_str()); }
+	size_t print(char c) { return fputc(c, stderr); }
+	size_t print(int value) { return fprintf(stderr, "%d", value); }
+	size_t print(unsigned int value) { return fprintf(stderr, "%u", value); }
+	size_t print(long value) { return fprintf(stderr, "%ld", value); }
+	size_t print(unsigned long value) { return fprintf(stderr, "%lu", value); }
+	size_t print(double value) { return fprintf(stderr, "%.2f", value); }
+	size_t print(uint8_t value) { return print((unsigned int)value); }
+
+	size_t println() { return print("\n"); }
+	template<typename T>
+	size_t println(T value) { return print(value) + println(); }
+};
+
+inline HardwareSerial Serial;
+
+/**
+ * \brief ESP32 hardware timer shims. Timers never fire on the host.
+ */
+typedef struct hw_timer_s hw_timer_t;
+
+inline hw_timer_t* timerBegin(uint8_t num, uint16_t divider, bool countUp) { return nullptr; }
+inline void timerAttachInterrupt(hw_timer_t* timer, void (*fn)(void), bool edge) {}
+inline void timerDetachInterrupt(hw_timer_t* timer) {}
+inline void timerAlarmWrite(hw_timer_t* timer, uint64_t alarmValue, bool autoreload) {}
+inline void timerAlarmEnable(hw_timer_t* timer) {}
+inline void timerAlarmDisable(hw_timer_t* timer) {}
+
+/**
+ * \brief ESP32 time shims. The local time is derived from the #VirtualClock.
+ */
+inline void configTzTime(const char* tz, const char* server1) {}
+
+inline bool getLocalTime(struct tm* info, uint32_t ms = 5000)
+{
+	time_t now = VirtualClock::micros() / 1000000;
+	gmtime_r(&now, info);
+	return true;
+}
+
+#endif
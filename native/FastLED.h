@@ -0,0 +1,236 @@
+/**
+ * \file FastLED.h
+ * \brief Minimal FastLED shim for native (host) builds of the LED clock library.
+ *        Provides the CRGB type, the 8 bit math helpers that the library uses and a CFastLED object
+ *        which counts show() calls instead of clocking out data.
+ */
+
+#ifndef __NATIVE_FASTLED_H_
+#define __NATIVE_FASTLED_H_
+
+#include <Arduino.h>
+
+typedef uint8_t fract8;
+
+inline uint8_t scale8(uint8_t i, fract8 scale)
+{
+	return ((uint16_t)i * (1 + (uint16_t)scale)) >> 8;
+}
+
+inline uint8_t scale8_video(uint8_t i, fract8 scale)
+{
+	return (((uint16_t)i * (uint16_t)scale) >> 8) + ((i && scale) ? 1 : 0);
+}
+
+inline uint8_t qadd8(uint8_t i, uint8_t j)
+{
+	uint16_t t = i + j;
+	return t > 255 ? 255 : t;
+}
+
+inline uint8_t qsub8(uint8_t i, uint8_t j)
+{
+	return i > j ? i - j : 0;
+}
+
+inline uint8_t lerp8by8(uint8_t a, uint8_t b, fract8 frac)
+{
+	if(b > a)
+	{
+		return a + scale8(b - a, frac);
+	}
+	return a - scale8(a - b, frac);
+}
+
+struct CRGB
+{
+	union {
+		struct {
+			uint8_t r;
+			uint8_t g;
+			uint8_t b;
+		};
+		uint8_t raw[3];
+	};
+
+	typedef enum {
+		Black = 0x000000,
+		Blue = 0x0000FF,
+		DarkBlue = 0x00008B,
+		DarkOrange = 0xFF8C00,
+		Green = 0x008000,
+		Orange = 0xFFA500,
+		Purple = 0x800080,
+		Red = 0xFF0000,
+		Tan = 0xD2B48C,
+		White = 0xFFFFFF,
+		Yellow = 0xFFFF00
+	} HTMLColorCode;
+
+	CRGB() : r(0), g(0), b(0) {}
+	CRGB(uint8_t ir, uint8_t ig, uint8_t ib) : r(ir), g(ig), b(ib) {}
+	CRGB(uint32_t colorcode) : r((colorcode >> 16) & 0xFF), g((colorcode >> 8) & 0xFF), b(colorcode & 0xFF) {}
+	CRGB(HTMLColorCode colorcode) : CRGB((uint32_t)colorcode) {}
+
+	CRGB& nscale8(uint8_t scaledown)
+	{
+		r = scale8(r, scaledown);
+		g = scale8(g, scaledown);
+		b = scale8(b, scaledown);
+		return *this;
+	}
+
+	CRGB& nscale8_video(uint8_t scaledown)
+	{
+		r = scale8_video(r, scaledown);
+		g = scale8_video(g, scaledown);
+		b = scale8_video(b, scaledown);
+		return *this;
+	}
+
+	CRGB& fadeToBlackBy(uint8_t fadefactor)
+	{
+		return nscale8(255 - fadefactor);
+	}
+
+	CRGB& operator%=(uint8_t scaledown)
+	{
+		return nscale8_video(scaledown);
+	}
+
+	CRGB& operator+=(const CRGB& rhs)
+	{
+		r = qadd8(r, rhs.r);
+		g = qadd8(g, rhs.g);
+		b = qadd8(b, rhs.b);
+		return *this;
+	}
+
+	explicit operator bool() const
+	{
+		return r || g || b;
+	}
+
+	uint8_t getAverageLight() const
+	{
+		return (r + g + b) / 3;
+	}
+};
+
+inline bool operator==(const CRGB& lhs, const CRGB& rhs)
+{
+	return lhs.r == rhs.r && lhs.g == rhs.g && lhs.b == rhs.b;
+}
+
+inline bool operator!=(const CRGB& lhs, const CRGB& rhs)
+{
+	return !(lhs == rhs);
+}
+
+inline CRGB blend(const CRGB& p1, const CRGB& p2, fract8 amountOfP2)
+{
+	return CRGB(lerp8by8(p1.r, p2.r, amountOfP2), lerp8by8(p1.g, p2.g, amountOfP2), lerp8by8(p1.b, p2.b, amountOfP2));
+}
+
+inline void fill_solid(CRGB* leds, int numToFill, const CRGB& color)
+{
+	for (int i = 0; i < numToFill; i++)
+	{
+		leds[i] = color;
+	}
+}
+
+inline void nscale8(CRGB* leds, uint16_t numLeds, uint8_t scale)
+{
+	for (uint16_t i = 0; i < numLeds; i++)
+	{
+		leds[i].nscale8(scale);
+	}
+}
+
+inline void fadeToBlackBy(CRGB* leds, uint16_t numLeds, uint8_t fadeBy)
+{
+	nscale8(leds, numLeds, 255 - fadeBy);
+}
+
+enum EOrder { RGB = 0012, GRB = 0102 };
+
+struct WS2812B {};
+
+/**
+ * \brief Stand-in for a FastLED controller. Only remembers which buffer it would push out.
+ */
+class CLEDController
+{
+public:
+	CRGB* leds;
+	int numLeds;
+	uint32_t showCount;
+
+	CLEDController() : leds(nullptr), numLeds(0), showCount(0) {}
+	int size() { return numLeds; }
+	void showLeds(uint8_t brightness = 255) { showCount++; }
+};
+
+inline uint8_t calculate_max_brightness_for_power_mW(uint8_t target_brightness, uint32_t max_power_mW)
+{
+	return target_brightness;
+}
+
+#define NATIVE_FASTLED_MAX_CONTROLLERS 8
+
+/**
+ * \brief Stand-in for the global FastLED object
+ */
+class CFastLED
+{
+private:
+	CLEDController controllers[NATIVE_FASTLED_MAX_CONTROLLERS];
+	uint8_t numControllers;
+	uint8_t brightness;
+	uint32_t showCount;
+
+public:
+	CFastLED() : numControllers(0), brightness(255), showCount(0) {}
+
+	template<typename CHIPSET, uint8_t DATA_PIN, EOrder RGB_ORDER>
+	CLEDController& addLeds(CRGB* data, int nLedsOrOffset, int nLedsIfOffset = 0)
+	{
+		CLEDController& controller = controllers[numControllers < NATIVE_FASTLED_MAX_CONTROLLERS - 1 ? numControllers++ : numControllers];
+		controller.leds = nLedsIfOffset > 0 ? data + nLedsOrOffset : data;
+		controller.numLeds = nLedsIfOffset > 0 ? nLedsIfOffset : nLedsOrOffset;
+		return controller;
+	}
+
+	void show(uint8_t scale)
+	{
+		for (uint8_t i = 0; i < numControllers; i++)
+		{
+			controllers[i].showLeds(scale);
+		}
+		showCount++;
+	}
+
+	void show() { show(brightness); }
+
+	void setBrightness(uint8_t scale) { brightness = scale; }
+	uint8_t getBrightness() { return brightness; }
+	void setMaxPowerInVoltsAndMilliamps(uint8_t volts, uint32_t milliamps) {}
+
+	int count() { return numControllers; }
+	CLEDController& operator[](int x) { return controllers[x]; }
+
+	/**
+	 * \brief Number of show() calls since the last reset, only avaliable in the native shim
+	 */
+	uint32_t getShowCount() { return showCount; }
+
+	/**
+	 * \brief Reset the show() counter, only avaliable in the native shim
+	 */
+	void resetShowCount() { showCount = 0; }
+};
+
+inline CFastLED FastLED;
+
+#endif
@@ -0,0 +1,127 @@
+/**
+ * \file VirtualClock.h
+ * \brief Injectable time source for native (host) builds. Every call to millis() and micros() in the
+ *        Arduino shim is routed through this class so benchmarks can drive the animation system with
+ *        a deterministic clock instead of wall time.
+ */
+
+#ifndef __VIRTUAL_CLOCK_H_
+#define __VIRTUAL_CLOCK_H_
+
+#include <stdint.h>
+#include <chrono>
+#include <thread>
+
+/**
+ * \brief Static time source used by the native Arduino shim.
+ * 		  By default the clock is manual: time only moves when #VirtualClock::advance or #VirtualClock::set is called
+ * 		  (or if an auto advance per read is configured). A different source can be injected with #VirtualClock::setTimeSource.
+ */
+class VirtualClock
+{
+public:
+	/**
+	 * \brief Function type of an injectable time source
+	 *
+	 * \return uint64_t current time in microseconds
+	 */
+	typedef uint64_t (*TimeSource)(void);
+
+private:
+	static inline TimeSource source = nullptr;
+	static inline uint64_t manualTime = 0;
+	static inline uint32_t autoAdvance = 0;
+
+public:
+	/**
+	 * \brief Inject a different time source
+	 *
+	 * \param newSource function returning the current time in microseconds. Pass nullptr to go back to the manual clock
+	 */
+	static void setTimeSource(TimeSource newSource)
+	{
+		source = newSource;
+	}
+
+	/**
+	 * \brief Time source which returns the real monotonic host time
+	 */
+	static uint64_t hostMicros()
+	{
+		return std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now().time_since_epoch()).count();
+	}
+
+	/**
+	 * \brief Get the current time of the active time source
+	 *
+	 * \return uint64_t time in microseconds
+	 */
+	static uint64_t micros()
+	{
+		if(source != nullptr)
+		{
+			return source();
+		}
+		uint64_t now = manualTime;
+		manualTime += autoAdvance;
+		return now;
+	}
+
+	/**
+	 * \brief true if the manual clock is in use, false if a time source was injected
+	 */
+	static bool isManual()
+	{
+		return source == nullptr;
+	}
+
+	/**
+	 * \brief Set the manual clock to an absolute value
+	 *
+	 * \param timeInUs new time in microseconds
+	 */
+	static void set(uint64_t timeInUs)
+	{
+		manualTime = timeInUs;
+	}
+
+	/**
+	 * \brief Move the manual clock forward
+	 *
+	 * \param timeInUs time to add in microseconds
+	 */
+	static void advance(uint64_t timeInUs)
+	{
+		manualTime += timeInUs;
+	}
+
+	/**
+	 * \brief Let the manual clock move forward by a fixed amount every time it is read.
+	 * 		  Required for code that busy waits on millis() (for example #Animator::delay) while running on the manual clock.
+	 *
+	 * \param timeInUs time to add per read in microseconds, 0 to disable
+	 */
+	static void setAutoAdvance(uint32_t timeInUs)
+	{
+		autoAdvance = timeInUs;
+	}
+
+	/**
+	 * \brief Wait for the given time. Advances the manual clock or sleeps on the host if a time source was injected.
+	 *
+	 * \param timeInUs time to wait in microseconds
+	 */
+	static void sleep(uint64_t timeInUs)
+	{
+		if(source == nullptr)
+		{
+			advance(timeInUs);
+		}
+		else
+		{
+			std::this_thread::sleep_for(std::chrono::microseconds(timeInUs));
+		}
+	}
+};
+
+#endif
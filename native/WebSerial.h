@@ -0,0 +1,13 @@
+/**
+ * \file WebSerial.h
+ * \brief WebSerial shim for native (host) builds. Forwards everything to the Serial shim.
+ */
+
+#ifndef __NATIVE_WEB_SERIAL_H_
+#define __NATIVE_WEB_SERIAL_H_
+
+#include <Arduino.h>
+
+inline HardwareSerial& WebSerial = Serial;
+
+#endif
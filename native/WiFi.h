@@ -0,0 +1,25 @@
+/**
+ * \file WiFi.h
+ * \brief WiFi shim for native (host) builds. The host is always offline.
+ */
+
+#ifndef __NATIVE_WIFI_H_
+#define __NATIVE_WIFI_H_
+
+#include <Arduino.h>
+
+typedef enum {
+	WL_IDLE_STATUS = 0,
+	WL_CONNECTED = 3,
+	WL_DISCONNECTED = 6
+} wl_status_t;
+
+class WiFiClass
+{
+public:
+	wl_status_t status() { return WL_DISCONNECTED; }
+};
+
+inline WiFiClass WiFi;
+
+#endif
@@ -0,0 +1,263 @@
+/**
+ * \file AnimatorBenchmark.cpp
+ * \brief Drives #Animator::handle through every transition of the #TransformationLookupTable on the #VirtualClock
+ *        and reports the host cost per frame, the number of segment ticks per frame, FastLED.show() calls and heap allocations.
+ *        One transition is repeated at twice the speed (#Animator::setAnimationSpeed).
+ *        Afterwards a #SevenSegment display is updated faster than #DIGIT_ANIMATION_SPEED to measure the retargeting of running transitions
+ *        and its color is changed faster than #COLOR_FADE_DURATION to measure the color crossfades.
+ *        Finally running segments are removed from the middle of the table of the #Animator (#Animator::remove).
+ */
+
+#include "Benchmark.h"
+#include "Animator.h"
+#include "Segment.h"
+#include "SegmentTransitions.h"
+#include "AnimationEffects.h"
+#include "SevenSegment.h"
+#include "TransitionSynthesizer.h"
+
+/**
+ * \brief Virtual time that passes between two calls of #Animator::handle, emulating one iteration of loop()
+ */
+#define BENCH_LOOP_PERIOD_US		1000
+
+/**
+ * \brief Number of frames to measure while no animation is running
+ */
+#define BENCH_IDLE_FRAMES			10000
+
+/**
+ * \brief Time between two calls of #SevenSegment::DisplayNumber while measuring the retargeting, in µs
+ */
+#define BENCH_RETARGET_PERIOD_US	100000
+
+/**
+ * \brief Number of calls of #SevenSegment::DisplayNumber while measuring the retargeting
+ */
+#define BENCH_RETARGET_UPDATES		100
+
+/**
+ * \brief Time between two color changes while measuring the crossfades, in µs. About the rate of a dragged color slider
+ */
+#define BENCH_FADE_PERIOD_US		20000
+
+/**
+ * \brief Number of color changes while measuring the crossfades
+ */
+#define BENCH_FADE_UPDATES			50
+
+/**
+ * \brief Length of the animation that is running on all segments while one of them is removed, in ms
+ */
+#define BENCH_REMOVE_DURATION		1000
+
+/**
+ * \brief Index of the segment that is removed from the #Animator, somewhere in the middle of its table.
+ * 		  The last segment moves into its slot and is removed afterwards as well
+ */
+#define BENCH_REMOVE_SEGMENT		2
+
+/**
+ * \brief Segment which counts how often it gets ticked by the #Animator
+ */
+class CountingSegment : public Segment
+{
+public:
+	static inline uint64_t tickCount = 0;
+	uint32_t ownTicks = 0;
+
+	CountingSegment(CRGB LEDBuffer[], uint16_t indexOfFirstLEDInSegment, Segment::direction Direction, uint8_t stripID) :
+		Segment(LEDBuffer, indexOfFirstLEDInSegment, NUM_LEDS_PER_SEGMENT, Direction, CRGB::White, stripID)
+	{
+	}
+
+	void tick(AnimationProgress progress)
+	{
+		tickCount++;
+		ownTicks++;
+		Segment::tick(progress);
+	}
+};
+
+static CRGB benchLeds[7 * NUM_LEDS_PER_SEGMENT];
+static CountingSegment* benchSegments[7];
+
+/**
+ * \brief Advance the color crossfades of all segments, the same as #DisplayManager does once per frame
+ */
+static void advanceColorFades()
+{
+	for (uint8_t i = 0; i < 7; i++)
+	{
+		benchSegments[i]->updateColorFade(millis());
+	}
+}
+
+static BenchmarkResult runFrames(Animator* animator, uint64_t durationUs, void (*everyFrame)() = nullptr)
+{
+	BenchmarkResult result;
+	uint64_t ticksBefore = CountingSegment::tickCount;
+	uint32_t showsBefore = FastLED.getShowCount();
+	uint32_t allocationsBefore = Benchmark::allocationCount;
+	for (uint64_t elapsed = 0; elapsed < durationUs; elapsed += BENCH_LOOP_PERIOD_US)
+	{
+		VirtualClock::advance(BENCH_LOOP_PERIOD_US);
+		uint64_t start = Benchmark::hostNs();
+		if(everyFrame != nullptr)
+		{
+			everyFrame();
+		}
+		animator->handle();
+		result.addFrame(Benchmark::hostNs() - start);
+	}
+	result.ticks = CountingSegment::tickCount - ticksBefore;
+	result.shows = FastLED.getShowCount() - showsBefore;
+	result.allocations = Benchmark::allocationCount - allocationsBefore;
+	return result;
+}
+
+static void accumulate(BenchmarkResult& total, const BenchmarkResult& result)
+{
+	total.frames += result.frames;
+	total.totalNs += result.totalNs;
+	total.maxNs = result.maxNs > total.maxNs ? result.maxNs : total.maxNs;
+	total.ticks += result.ticks;
+	total.shows += result.shows;
+	total.allocations += result.allocations;
+}
+
+void Benchmark::runAnimatorBenchmark()
+{
+	Animator* animator = Animator::getInstance();
+	animator->setRenderStage(&AnimationEffects::renderBatch);
+	uint8_t strip = animator->addLEDStrip(&FastLED.addLeds<WS2812B, 0, GRB>(benchLeds, 7 * NUM_LEDS_PER_SEGMENT));
+	for (uint8_t i = 0; i < 7; i++)
+	{
+		benchSegments[i] = new CountingSegment(benchLeds, i * NUM_LEDS_PER_SEGMENT, i % 2 == 0 ? Segment::LEFT_TO_RIGHT : Segment::RIGHT_TO_LEFT, strip);
+		animator->add(benchSegments[i]);
+	}
+	VirtualClock::set(1000000);
+
+	printHeader("Animator::handle() per transition");
+	BenchmarkResult idle = runFrames(animator, (uint64_t)BENCH_IDLE_FRAMES * BENCH_LOOP_PERIOD_US);
+	printResult("idle", idle);
+
+	BenchmarkResult total;
+	for (uint8_t from = 0; from <= SEGMENT_OFF; from++)
+	{
+		for (uint8_t to = 0; to <= SEGMENT_OFF; to++)
+		{
+			const Animator::ComplexAmination* transition = TransformationLookupTable[from][to];
+			if(transition == nullptr)
+			{
+				continue;
+			}
+			uint32_t allocationsBefore = Benchmark::allocationCount;
+			animator->PlayComplexAnimation(transition, (AnimatableObject**)benchSegments);
+			uint32_t startAllocations = Benchmark::allocationCount - allocationsBefore;
+			// let the whole chain run out plus a few idle frames to make sure the last step finished
+			uint64_t chainDuration = (uint64_t)transition->LengthPerAnimation * transition->numSteps * 1000;
+			BenchmarkResult result = runFrames(animator, chainDuration + 50 * BENCH_LOOP_PERIOD_US);
+			result.allocations += startAllocations;
+
+			char name[16];
+			snprintf(name, sizeof(name), "%c->%c", from == SEGMENT_OFF ? 'X' : '0' + from, to == SEGMENT_OFF ? 'X' : '0' + to);
+			printResult(name, result);
+			accumulate(total, result);
+		}
+	}
+	printResult("all", total);
+
+	//the same chain at twice the speed has to finish in half the time, only the scale of the Animator changes
+	animator->setAnimationSpeed(200);
+	const Animator::ComplexAmination* fastTransition = TransformationLookupTable[SEGMENT_OFF][8];
+	uint32_t allocationsBefore = Benchmark::allocationCount;
+	animator->PlayComplexAnimation(fastTransition, (AnimatableObject**)benchSegments);
+	uint32_t startAllocations = Benchmark::allocationCount - allocationsBefore;
+	BenchmarkResult fast = runFrames(animator, animator->getScaledDuration((uint32_t)fastTransition->LengthPerAnimation * fastTransition->numSteps) * 1000 + 50 * BENCH_LOOP_PERIOD_US);
+	fast.allocations += startAllocations;
+	printResult("X->8 @200%", fast);
+	animator->setAnimationSpeed(100);
+
+	//count up faster than a single transition takes, every update has to retarget the one that is still running
+	SevenSegment display(SevenSegment::FULL_SEGMENT, animator);
+	for (uint8_t i = 0; i < 7; i++)
+	{
+		display.add(benchSegments[i], (SevenSegment::SegmentPosition)(1 << i));
+	}
+	BenchmarkResult retarget;
+	uint8_t value = 0;
+	for (uint16_t update = 0; update < BENCH_RETARGET_UPDATES; update++)
+	{
+		value = update % 10;
+		uint32_t allocationsBefore = Benchmark::allocationCount;
+		display.DisplayNumber(value);
+		uint32_t updateAllocations = Benchmark::allocationCount - allocationsBefore;
+		BenchmarkResult result = runFrames(animator, BENCH_RETARGET_PERIOD_US);
+		result.allocations += updateAllocations;
+		accumulate(retarget, result);
+	}
+	accumulate(retarget, runFrames(animator, (uint64_t)DIGIT_ANIMATION_SPEED * 1000 + 50 * BENCH_LOOP_PERIOD_US));
+	printResult("retarget", retarget);
+
+	//the display has to end up showing exactly the last digit
+	uint8_t wrongLeds = 0;
+	for (uint8_t i = 0; i < 7; i++)
+	{
+		CRGB expected = TransitionSynthesizer::isOutgoing(value, SEGMENT_OFF, i) ? CRGB(CRGB::White) : CRGB(CRGB::Black);
+		for (uint8_t led = 0; led < NUM_LEDS_PER_SEGMENT; led++)
+		{
+			wrongLeds += benchLeds[i * NUM_LEDS_PER_SEGMENT + led] != expected ? 1 : 0;
+		}
+	}
+	printf("retarget final digit %d: %s (%d wrong LEDs)\n", value, wrongLeds == 0 ? "correct" : "WRONG", wrongLeds);
+
+	//drag a color slider over a fully lit digit, every change continues from the color the running fade is showing
+	display.DisplayNumber(8);
+	runFrames(animator, (uint64_t)DIGIT_ANIMATION_SPEED * 1000 + 50 * BENCH_LOOP_PERIOD_US);
+	BenchmarkResult fade;
+	CRGB fadeTarget;
+	for (uint16_t update = 0; update < BENCH_FADE_UPDATES; update++)
+	{
+		fadeTarget = CRGB(update * 5, 255 - update * 5, 128);
+		uint32_t allocationsBefore = Benchmark::allocationCount;
+		display.updateColor(fadeTarget, COLOR_FADE_DURATION, ColorFadeEasing);
+		uint32_t updateAllocations = Benchmark::allocationCount - allocationsBefore;
+		BenchmarkResult result = runFrames(animator, BENCH_FADE_PERIOD_US, &advanceColorFades);
+		result.allocations += updateAllocations;
+		accumulate(fade, result);
+	}
+	accumulate(fade, runFrames(animator, (uint64_t)COLOR_FADE_DURATION * 1000 + 50 * BENCH_LOOP_PERIOD_US, &advanceColorFades));
+	printResult("color fade", fade);
+
+	wrongLeds = 0;
+	for (uint16_t led = 0; led < 7 * NUM_LEDS_PER_SEGMENT; led++)
+	{
+		wrongLeds += benchLeds[led] != fadeTarget ? 1 : 0;
+	}
+	printf("color fade final color: %s (%d wrong LEDs)\n", wrongLeds == 0 ? "correct" : "WRONG", wrongLeds);
+
+	//remove a running segment from the middle, the last one moves into its slot. Removing that one as well must not leave
+	//anything behind in its old slot, neither of the two may be ticked anymore while the others keep running
+	for (uint8_t i = 0; i < 7; i++)
+	{
+		benchSegments[i]->retarget(false, BENCH_REMOVE_DURATION);
+	}
+	runFrames(animator, BENCH_REMOVE_DURATION * 1000 / 4);
+	animator->remove(benchSegments[BENCH_REMOVE_SEGMENT]);
+	animator->remove(benchSegments[6]);
+	for (uint8_t i = 0; i < 7; i++)
+	{
+		benchSegments[i]->ownTicks = 0;
+	}
+	runFrames(animator, BENCH_REMOVE_DURATION * 1000 / 4);
+	uint8_t wrongSegments = 0;
+	for (uint8_t i = 0; i < 7; i++)
+	{
+		uint32_t expected = i == BENCH_REMOVE_SEGMENT || i == 6 ? 0 : benchSegments[0]->ownTicks;
+		wrongSegments += benchSegments[i]->ownTicks != expected ? 1 : 0;
+	}
+	printf("remove running segment: %s (%d segments ticked wrong, %u ticks each)\n", wrongSegments == 0 && benchSegments[0]->ownTicks > 0 ? "correct" : "WRONG",
+		wrongSegments, benchSegments[0]->ownTicks);
+	runFrames(animator, BENCH_REMOVE_DURATION * 1000);
+}
@@ -0,0 +1,92 @@
+/**
+ * \file Benchmark.h
+ * \brief Helpers shared by all native benchmarks: host timing, heap allocation counting and report formatting.
+ */
+
+#ifndef __BENCHMARK_H_
+#define __BENCHMARK_H_
+
+#include <Arduino.h>
+#include <stdint.h>
+
+/**
+ * \brief Accumulated result of one benchmark case
+ */
+class BenchmarkResult
+{
+public:
+	uint32_t frames;
+	uint64_t totalNs;
+	uint64_t maxNs;
+	uint64_t ticks;
+	uint32_t shows;
+	uint32_t allocations;
+
+	BenchmarkResult() : frames(0), totalNs(0), maxNs(0), ticks(0), shows(0), allocations(0) {}
+
+	/**
+	 * \brief Add the measurement of a single frame
+	 *
+	 * \param ns host time the frame took in nanoseconds
+	 */
+	void addFrame(uint64_t ns)
+	{
+		frames++;
+		totalNs += ns;
+		if(ns > maxNs)
+		{
+			maxNs = ns;
+		}
+	}
+
+	double nsPerFrame() const
+	{
+		return frames > 0 ? (double)totalNs / frames : 0;
+	}
+
+	double ticksPerFrame() const
+	{
+		return frames > 0 ? (double)ticks / frames : 0;
+	}
+};
+
+namespace Benchmark
+{
+	/**
+	 * \brief Number of heap allocations since program start. Incremented by the global operator new in BenchmarkMain.cpp
+	 */
+	inline volatile uint32_t allocationCount = 0;
+
+	/**
+	 * \brief Monotonic host time in nanoseconds, independent of the #VirtualClock
+	 */
+	inline uint64_t hostNs()
+	{
+		return std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now().time_since_epoch()).count();
+	}
+
+	inline void printHeader(const char* title)
+	{
+		printf("\n== %s ==\n", title);
+		printf("%-14s %8s %12s %12s %12s %8s %8s\n", "case", "frames", "ns/frame", "max ns", "ticks/frame", "shows", "allocs");
+	}
+
+	inline void printResult(const char* name, const BenchmarkResult& result)
+	{
+		printf("%-14s %8u %12.1f %12llu %12.3f %8u %8u\n", name, result.frames, result.nsPerFrame(), (unsigned long long)result.maxNs,
+			result.ticksPerFrame(), result.shows, result.allocations);
+	}
+
+	/**
+	 * \brief Benchmark entry points. Each of them prints its own report.
+	 */
+	void runAnimatorBenchmark();
+	void runEasingBenchmark();
+	void runSpatialEffectsBenchmark();
+	void runBrightnessBenchmark();
+	void runPowerEstimatorBenchmark();
+	void runOutputBenchmark();
+	void runStreamingFilterBenchmark();
+}
+
+#endif
@@ -0,0 +1,57 @@
+/**
+ * \file BenchmarkMain.cpp
+ * \brief Entry point of the native benchmark build (env:native). Counts every heap allocation
+ *        and runs all registered benchmarks on the #VirtualClock.
+ */
+
+#include <new>
+#include "Benchmark.h"
+
+void* operator new(size_t size)
+{
+	Benchmark::allocationCount = Benchmark::allocationCount + 1;
+	void* p = malloc(size == 0 ? 1 : size);
+	if(p == nullptr)
+	{
+		throw std::bad_alloc();
+	}
+	return p;
+}
+
+void* operator new[](size_t size)
+{
+	return operator new(size);
+}
+
+void operator delete(void* p) noexcept
+{
+	free(p);
+}
+
+void operator delete[](void* p) noexcept
+{
+	free(p);
+}
+
+void operator delete(void* p, size_t size) noexcept
+{
+	free(p);
+}
+
+void operator delete[](void* p, size_t size) noexcept
+{
+	free(p);
+}
+
+int main(int argc, char** argv)
+{
+	Benchmark::runAnimatorBenchmark();
+	Benchmark::runEasingBenchmark();
+	Benchmark::runBrightnessBenchmark();
+	Benchmark::runPowerEstimatorBenchmark();
+	//plays an effect through the DisplayManager the power estimator benchmark initialized
+	Benchmark::runSpatialEffectsBenchmark();
+	Benchmark::runOutputBenchmark();
+	Benchmark::runStreamingFilterBenchmark();
+	return 0;
+}
@@ -0,0 +1,144 @@
+/**
+ * \file BrightnessBenchmark.cpp
+ * \brief Drags the brightness sliders of the hours, minutes and downlights faster than #CHANNEL_BRIGHTNESS_INTERPOLATION while
+ *        rendering the (base color, level) pairs of all LEDs through #BrightnessLevel every frame.
+ *        Reports the cost per frame and the heap allocations, and checks that two identical runs produce identical frames
+ *        and that the base colors come back unchanged at full level.
+ */
+
+#include "Benchmark.h"
+#include "BrightnessLevel.h"
+#include "SegmentTransitions.h"
+
+/**
+ * \brief Number of frames of one run, one frame per ms
+ */
+#define BENCH_BRIGHTNESS_FRAMES		5000
+
+/**
+ * \brief Frames between two level changes, about the rate of a dragged slider or repeated voice commands
+ */
+#define BENCH_BRIGHTNESS_PERIOD		20
+
+#define BENCH_DIGIT_LEDS			(NUM_SEGMENTS * NUM_LEDS_PER_SEGMENT)
+#define BENCH_DOWNLIGHT_LEDS		(ADDITIONAL_LEDS > 0 ? ADDITIONAL_LEDS : 1)
+
+static CRGB baseDigits[BENCH_DIGIT_LEDS];
+static CRGB baseDownlights[BENCH_DOWNLIGHT_LEDS];
+static CRGB outputDigits[BENCH_DIGIT_LEDS];
+static CRGB outputDownlights[BENCH_DOWNLIGHT_LEDS];
+
+/**
+ * \brief Scale every LED by the channel it belongs to: the first half of the digits are hours, the second half minutes
+ */
+static void renderFrame(const BrightnessLevel* channels)
+{
+	for (uint16_t i = 0; i < BENCH_DIGIT_LEDS; i++)
+	{
+		outputDigits[i] = BrightnessLevel::apply(baseDigits[i], channels[i < BENCH_DIGIT_LEDS / 2 ? 0 : 1].getScale());
+	}
+	uint8_t scale = channels[2].getScale();
+	for (uint16_t i = 0; i < BENCH_DOWNLIGHT_LEDS; i++)
+	{
+		outputDownlights[i] = BrightnessLevel::apply(baseDownlights[i], scale);
+	}
+}
+
+/**
+ * \brief FNV-1a over both output buffers
+ */
+static uint32_t hashFrame(uint32_t hash)
+{
+	const uint8_t* bytes[2] = {(const uint8_t*)outputDigits, (const uint8_t*)outputDownlights};
+	size_t sizes[2] = {sizeof(outputDigits), sizeof(outputDownlights)};
+	for (uint8_t buffer = 0; buffer < 2; buffer++)
+	{
+		for (size_t i = 0; i < sizes[buffer]; i++)
+		{
+			hash = (hash ^ bytes[buffer][i]) * 16777619u;
+		}
+	}
+	return hash;
+}
+
+/**
+ * \brief One run of slider spam with a fixed seed
+ *
+ * \param result receives the measurement
+ * \return hash over all rendered frames
+ */
+static uint32_t runSliderSpam(BenchmarkResult& result)
+{
+	BrightnessLevel channels[3];
+	uint32_t random = 12345;
+	uint32_t hash = 2166136261u;
+	uint32_t allocationsBefore = Benchmark::allocationCount;
+	for (uint32_t now = 0; now < BENCH_BRIGHTNESS_FRAMES; now++)
+	{
+		uint64_t start = Benchmark::hostNs();
+		if(now % BENCH_BRIGHTNESS_PERIOD == 0)
+		{
+			random = random * 1103515245u + 12345u;
+			channels[(random >> 8) % 3].start(random >> 16, CHANNEL_BRIGHTNESS_INTERPOLATION, now, BrightnessEasing);
+		}
+		for (uint8_t channel = 0; channel < 3; channel++)
+		{
+			channels[channel].update(now);
+		}
+		renderFrame(channels);
+		result.addFrame(Benchmark::hostNs() - start);
+		hash = hashFrame(hash);
+	}
+	result.allocations = Benchmark::allocationCount - allocationsBefore;
+	return hash;
+}
+
+void Benchmark::runBrightnessBenchmark()
+{
+	BrightnessLevel::buildScaleTable(BRIGHTNESS_GAMMA);
+	for (uint16_t i = 0; i < BENCH_DIGIT_LEDS; i++)
+	{
+		baseDigits[i] = CRGB(i * 37, 255 - i * 11, i * 5 + 1);
+	}
+	for (uint16_t i = 0; i < BENCH_DOWNLIGHT_LEDS; i++)
+	{
+		baseDownlights[i] = CRGB(200, 120 + i, 3);
+	}
+
+	printHeader("Brightness channels over all LEDs");
+	BenchmarkResult first;
+	BenchmarkResult second;
+	uint32_t firstHash = runSliderSpam(first);
+	uint32_t secondHash = runSliderSpam(second);
+	printResult("slider spam", first);
+	printf("slider spam repeated: %s (%08x / %08x)\n", firstHash == secondHash ? "deterministic" : "DIFFERENT", firstHash, secondHash);
+
+	//the levels only scale the output, at full level the base colors have to come out exactly as they went in
+	BrightnessLevel channels[3];
+	for (uint8_t channel = 0; channel < 3; channel++)
+	{
+		channels[channel].jumpTo(1);
+	}
+	renderFrame(channels);
+	uint16_t dark = 0;
+	for (uint16_t i = 0; i < BENCH_DIGIT_LEDS; i++)
+	{
+		dark += baseDigits[i] != CRGB(CRGB::Black) && outputDigits[i] == CRGB(CRGB::Black) ? 1 : 0;
+	}
+	for (uint8_t channel = 0; channel < 3; channel++)
+	{
+		channels[channel].jumpTo(255);
+	}
+	renderFrame(channels);
+	uint16_t wrongLeds = 0;
+	for (uint16_t i = 0; i < BENCH_DIGIT_LEDS; i++)
+	{
+		wrongLeds += outputDigits[i] != baseDigits[i] ? 1 : 0;
+	}
+	for (uint16_t i = 0; i < BENCH_DOWNLIGHT_LEDS; i++)
+	{
+		wrongLeds += outputDownlights[i] != baseDownlights[i] ? 1 : 0;
+	}
+	printf("lowest level: %s (%d LEDs turned off)\n", dark == 0 ? "correct" : "WRONG", dark);
+	printf("full level after dimming: %s (%d LEDs differ from their base color)\n", wrongLeds == 0 ? "lossless" : "WRONG", wrongLeds);
+}
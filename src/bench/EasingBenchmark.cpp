@@ -0,0 +1,106 @@
+/**
+ * \file EasingBenchmark.cpp
+ * \brief Compares the double precision easing equations with the fixed point #EasingLookupTable backend:
+ *        host cost per evaluation and maximum error of the table over the whole curve.
+ */
+
+#include "Benchmark.h"
+#include "easing.h"
+
+/**
+ * \brief Number of evaluations per easing and backend
+ */
+#define BENCH_EASING_SAMPLES		100000
+
+/**
+ * \brief Duration the easings are set up with, the same order of magnitude as one step of a transition in µs
+ */
+#define BENCH_EASING_DURATION		300000
+
+/**
+ * \brief Sink for the results so that the compiler can't drop the evaluations
+ */
+static volatile int64_t easingSink;
+
+static void measure(const char* name, EasingBase* easing, easingType_t type)
+{
+	easing->setType(type);
+	easing->setDuration(BENCH_EASING_DURATION);
+	easing->setTotalChangeInPosition(EASING_FIXED_ONE);
+	EasingLookupTable table;
+	table.build(*easing);
+
+	// double path, the way AnimatableObject evaluated easings before the fixed point backend
+	easing->setLookupTable(nullptr);
+	int64_t sum = 0;
+	uint64_t start = Benchmark::hostNs();
+	for (int32_t i = 0; i < BENCH_EASING_SAMPLES; i++)
+	{
+		int32_t progress = (int64_t)i * EASING_FIXED_ONE / (BENCH_EASING_SAMPLES - 1);
+		sum += (int32_t)easing->ease((NUMBER)progress * BENCH_EASING_DURATION / EASING_FIXED_ONE);
+	}
+	uint64_t doubleNs = Benchmark::hostNs() - start;
+	easingSink = sum;
+
+	easing->setLookupTable(&table);
+	sum = 0;
+	start = Benchmark::hostNs();
+	for (int32_t i = 0; i < BENCH_EASING_SAMPLES; i++)
+	{
+		int32_t progress = (int64_t)i * EASING_FIXED_ONE / (BENCH_EASING_SAMPLES - 1);
+		sum += easing->easeFixed(progress);
+	}
+	uint64_t fixedNs = Benchmark::hostNs() - start;
+	easingSink = sum;
+
+	double maxError = 0;
+	for (int32_t i = 0; i < BENCH_EASING_SAMPLES; i++)
+	{
+		int32_t progress = (int64_t)i * EASING_FIXED_ONE / (BENCH_EASING_SAMPLES - 1);
+		easing->setLookupTable(nullptr);
+		double exact = easing->ease((NUMBER)progress * BENCH_EASING_DURATION / EASING_FIXED_ONE);
+		easing->setLookupTable(&table);
+		double error = fabs(easing->easeFixed(progress) - exact);
+		maxError = error > maxError ? error : maxError;
+	}
+	easing->setLookupTable(nullptr);
+
+	static const char* typeNames[] = {"In", "Out", "InOut"};
+	char caseName[32];
+	snprintf(caseName, sizeof(caseName), "%s%s", name, typeNames[type]);
+	printf("%-22s %12.1f %12.1f %12.3f\n", caseName, (double)doubleNs / BENCH_EASING_SAMPLES, (double)fixedNs / BENCH_EASING_SAMPLES,
+		maxError * 100.0 / EASING_FIXED_ONE);
+}
+
+void Benchmark::runEasingBenchmark()
+{
+	BackEase back;
+	BounceEase bounce;
+	CircularEase circular;
+	CubicEase cubic;
+	ElasticEase elastic;
+	ExponentialEase exponential;
+	LinearEase linear;
+	QuadraticEase quadratic;
+	QuarticEase quartic;
+	QuinticEase quintic;
+	SineEase sine;
+
+	struct
+	{
+		const char* name;
+		EasingBase* easing;
+	} easings[] = {
+		{"Back", &back}, {"Bounce", &bounce}, {"Circular", &circular}, {"Cubic", &cubic}, {"Elastic", &elastic}, {"Exponential", &exponential},
+		{"Linear", &linear}, {"Quadratic", &quadratic}, {"Quartic", &quartic}, {"Quintic", &quintic}, {"Sine", &sine}
+	};
+
+	printf("\n== Easing: double equations vs %d segment lookup table ==\n", EASING_LOOKUP_SEGMENTS);
+	printf("%-22s %12s %12s %12s\n", "case", "double ns", "fixed ns", "max err %");
+	for (auto& entry : easings)
+	{
+		measure(entry.name, entry.easing, EASE_IN);
+		measure(entry.name, entry.easing, EASE_OUT);
+		measure(entry.name, entry.easing, EASE_IN_OUT);
+	}
+}
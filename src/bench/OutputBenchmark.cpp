@@ -0,0 +1,141 @@
+/**
+ * \file OutputBenchmark.cpp
+ * \brief Pushes frames through #Animator::showStrips into a #MockLEDOutput for different layouts of the digit and downlight strips
+ *        and reports the modeled wire time per frame, the highest frame rate the layout sustains and the frame rate the #Animator derived for it.
+ *        The digits change every frame, the downlights only every #BENCH_OUTPUT_DOWNLIGHT_PERIOD frames.
+ *        A long strip checks that the frame period grows with the strip so a show never starts before the last one is out.
+ *        Finally the frames spend #BENCH_OUTPUT_FRAME_WORK_US of virtual time between the update and the show, like the compositor
+ *        of the #DisplayManager does, which has to stretch the frame period as well.
+ */
+
+#include "Benchmark.h"
+#include "Animator.h"
+#include "MockLEDOutput.h"
+
+/**
+ * \brief Number of frames per layout
+ */
+#define BENCH_OUTPUT_FRAMES				3000
+
+/**
+ * \brief Frames between two changes of the downlights
+ */
+#define BENCH_OUTPUT_DOWNLIGHT_PERIOD	25
+
+#define BENCH_OUTPUT_DIGIT_LEDS			(NUM_SEGMENTS * NUM_LEDS_PER_SEGMENT)
+#define BENCH_OUTPUT_DOWNLIGHT_LEDS		(ADDITIONAL_LEDS > 0 ? ADDITIONAL_LEDS : 1)
+
+/**
+ * \brief Number of LEDs of the long strip, far more than the shelf has so the wire time limits the frame rate
+ */
+#define BENCH_OUTPUT_LONG_LEDS			1000
+
+/**
+ * \brief Virtual time every frame spends between #Animator::update and #Animator::showStrips in the last check
+ */
+#define BENCH_OUTPUT_FRAME_WORK_US		12000
+
+/**
+ * \brief Number of frames of the last check
+ */
+#define BENCH_OUTPUT_WORK_FRAMES		10
+
+static CRGB outputLeds[BENCH_OUTPUT_DIGIT_LEDS + BENCH_OUTPUT_DOWNLIGHT_LEDS > BENCH_OUTPUT_LONG_LEDS ? BENCH_OUTPUT_DIGIT_LEDS + BENCH_OUTPUT_DOWNLIGHT_LEDS : BENCH_OUTPUT_LONG_LEDS];
+
+/**
+ * \brief Run all frames of one layout
+ *
+ * \param name name of the layout in the report
+ * \param output backend with the strips of the layout registered
+ * \param digitStrip ID of the strip with the digits
+ * \param downlightStrip ID of the strip with the downlights, the same as digitStrip if they are appended to the digits
+ * \param scheduled set to false if the frame period of the #Animator is shorter than a show of the layout
+ * \return true if the backend recorded exactly the frames that were sent
+ */
+static bool runLayout(const char* name, MockLEDOutput* output, uint8_t digitStrip, uint8_t downlightStrip, bool& scheduled)
+{
+	Animator* animator = Animator::getInstance();
+	animator->setOutput(output);
+	animator->takeDirtyStrips();
+	output->reset();
+
+	uint32_t expectedDownlightFrames = 0;
+	uint32_t lastChecksum = 0;
+	bool recorded = true;
+	uint64_t hostNs = 0;
+	uint32_t allocationsBefore = Benchmark::allocationCount;
+	for (uint32_t frame = 0; frame < BENCH_OUTPUT_FRAMES; frame++)
+	{
+		outputLeds[frame % BENCH_OUTPUT_DIGIT_LEDS] = CRGB(frame, frame >> 8, 7);
+		animator->markStripDirty(digitStrip);
+		if(frame % BENCH_OUTPUT_DOWNLIGHT_PERIOD == 0)
+		{
+			outputLeds[BENCH_OUTPUT_DIGIT_LEDS] = CRGB(0, frame, frame >> 8);
+			animator->markStripDirty(downlightStrip);
+			expectedDownlightFrames++;
+		}
+		uint64_t start = Benchmark::hostNs();
+		animator->showStrips(animator->takeDirtyStrips());
+		hostNs += Benchmark::hostNs() - start;
+
+		//every frame changed the digits, so every recorded frame has to differ from the one before
+		recorded &= output->getChecksum(digitStrip) != lastChecksum;
+		lastChecksum = output->getChecksum(digitStrip);
+	}
+	uint32_t allocations = Benchmark::allocationCount - allocationsBefore;
+	recorded &= output->getFrameCount() == BENCH_OUTPUT_FRAMES && output->getFrameCount(digitStrip) == BENCH_OUTPUT_FRAMES;
+	recorded &= downlightStrip == digitStrip || output->getFrameCount(downlightStrip) == expectedDownlightFrames;
+	scheduled &= animator->getFramePeriod() >= output->getMaxWireTime();
+
+	printf("%-14s %8u %12.1f %12llu %12u %10u %10u %8u\n", name, output->getFrameCount(), (double)hostNs / BENCH_OUTPUT_FRAMES,
+		(unsigned long long)(output->getTotalWireTime() / output->getFrameCount()), output->getMaxWireTime(), 1000000 / output->getMaxWireTime(),
+		animator->getFrameRate(), allocations);
+	animator->setOutput(nullptr);
+	return recorded;
+}
+
+void Benchmark::runOutputBenchmark()
+{
+	printf("\n== LED output of %d digit and %d downlight LEDs ==\n", BENCH_OUTPUT_DIGIT_LEDS, BENCH_OUTPUT_DOWNLIGHT_LEDS);
+	printf("%-14s %8s %12s %12s %12s %10s %10s %8s\n", "layout", "shows", "host ns", "wire us", "max wire us", "max fps", "anim fps", "allocs");
+	bool recorded = true;
+	bool scheduled = true;
+
+	MockLEDOutput appended;
+	uint8_t strip = appended.addStrip(outputLeds, BENCH_OUTPUT_DIGIT_LEDS + BENCH_OUTPUT_DOWNLIGHT_LEDS);
+	recorded &= runLayout("appended", &appended, strip, strip, scheduled);
+
+	MockLEDOutput separate(true);
+	uint8_t digits = separate.addStrip(outputLeds, BENCH_OUTPUT_DIGIT_LEDS);
+	uint8_t downlights = separate.addStrip(&outputLeds[BENCH_OUTPUT_DIGIT_LEDS], BENCH_OUTPUT_DOWNLIGHT_LEDS);
+	recorded &= runLayout("parallel", &separate, digits, downlights, scheduled);
+
+	MockLEDOutput sequential(false);
+	digits = sequential.addStrip(outputLeds, BENCH_OUTPUT_DIGIT_LEDS);
+	downlights = sequential.addStrip(&outputLeds[BENCH_OUTPUT_DIGIT_LEDS], BENCH_OUTPUT_DOWNLIGHT_LEDS);
+	recorded &= runLayout("sequential", &sequential, digits, downlights, scheduled);
+
+	MockLEDOutput longStrip;
+	strip = longStrip.addStrip(outputLeds, BENCH_OUTPUT_LONG_LEDS);
+	recorded &= runLayout("long", &longStrip, strip, strip, scheduled);
+
+	printf("recorded frames: %s\n", recorded == true ? "correct" : "WRONG");
+	printf("frame period covers the show: %s\n", scheduled == true ? "correct" : "WRONG");
+
+	//work done between the update and the show, e.g. composing the LEDs, belongs to the frame as well
+	Animator* animator = Animator::getInstance();
+	MockLEDOutput working;
+	strip = working.addStrip(outputLeds, BENCH_OUTPUT_DIGIT_LEDS);
+	animator->setOutput(&working);
+	for (uint16_t frame = 0; frame < BENCH_OUTPUT_WORK_FRAMES; frame++)
+	{
+		animator->update();
+		VirtualClock::advance(BENCH_OUTPUT_FRAME_WORK_US);
+		animator->markStripDirty(strip);
+		animator->showStrips(animator->takeDirtyStrips());
+	}
+	uint32_t framePeriod = animator->getFramePeriod();
+	animator->setOutput(nullptr);
+	printf("frame period covers the frame work: %s (%u us for %u us of work and %u us of wire time)\n",
+		framePeriod >= BENCH_OUTPUT_FRAME_WORK_US + working.getMaxWireTime() ? "correct" : "WRONG", framePeriod, BENCH_OUTPUT_FRAME_WORK_US, working.getMaxWireTime());
+}
@@ -0,0 +1,147 @@
+/**
+ * \file PowerEstimatorBenchmark.cpp
+ * \brief Counts the clock through the minutes with #DisplayManager::handle, so the estimate of #PowerEstimator is kept up to date by
+ *        the real compositor, which only composes the segments that changed. The same run is repeated with a layer change before
+ *        every frame, which makes the compositor compose and estimate every LED again like a full scan before each show does.
+ *        Checks after every frame that the running estimate matches a full scan of the front buffers and that the limited
+ *        brightness keeps the LEDs within #MAX_MILLIAMPS.
+ */
+
+#include "Benchmark.h"
+#include "DisplayManager.h"
+
+/**
+ * \brief Virtual time that passes between two calls of #DisplayManager::handle, emulating one iteration of loop()
+ */
+#define BENCH_POWER_LOOP_PERIOD_US	1000
+
+/**
+ * \brief Number of minutes to count through per case
+ */
+#define BENCH_POWER_MINUTES			60
+
+/**
+ * \brief Virtual time each minute is shown, long enough for all transitions to finish
+ */
+#define BENCH_POWER_MINUTE_US		1500000
+
+/**
+ * \brief Minutes between two crossfades of the color of all segments
+ */
+#define BENCH_POWER_FADE_MINUTES	10
+
+/**
+ * \brief Number of FastLED controllers the #DisplayManager registers
+ */
+#define BENCH_POWER_CONTROLLERS		(APPEND_DOWN_LIGHTERS == true ? 1 : 2)
+
+#define BENCH_POWER_LEDS			(NUM_LEDS + (APPEND_DOWN_LIGHTERS == true ? 0 : ADDITIONAL_LEDS))
+
+/**
+ * \brief Index of the first FastLED controller of the #DisplayManager
+ */
+static int firstController;
+
+/**
+ * \brief Volatile so the compiler can't drop the full scans whose result is only compared
+ */
+static volatile uint32_t scannedLoad;
+
+/**
+ * \brief Load of all front buffers at full brightness in mA * 255, scanned LED by LED
+ */
+static uint32_t scanFrontBuffers()
+{
+	uint32_t load = 0;
+	for (int i = firstController; i < firstController + BENCH_POWER_CONTROLLERS; i++)
+	{
+		load += PowerEstimator::load(FastLED[i].leds, FastLED[i].size());
+	}
+	return load;
+}
+
+/**
+ * \brief Count the clock through #BENCH_POWER_MINUTES minutes
+ *
+ * \param display display to drive
+ * \param composeAll mark all layers as changed before every frame so every LED is composed again
+ * \param scanNs receives the host time the full scans of the shown frames took
+ * \param wrongFrames incremented for every frame where the estimate differs from a full scan
+ * \param overBudget incremented for every frame where the limited brightness exceeds #MAX_MILLIAMPS
+ */
+static BenchmarkResult runClock(DisplayManager* display, bool composeAll, uint64_t& scanNs, uint32_t& wrongFrames, uint32_t& overBudget)
+{
+	BenchmarkResult result;
+	uint32_t showsBefore = FastLED.getShowCount();
+	uint32_t allocationsBefore = Benchmark::allocationCount;
+	for (uint16_t minute = 0; minute < BENCH_POWER_MINUTES; minute++)
+	{
+		display->displayTime(12 + minute / 60, minute % 60);
+		if(minute % BENCH_POWER_FADE_MINUTES == 0)
+		{
+			display->setAllSegmentColors(CRGB(255 - minute * 4, 160, minute * 4), true);
+		}
+		for (uint32_t elapsed = 0; elapsed < BENCH_POWER_MINUTE_US; elapsed += BENCH_POWER_LOOP_PERIOD_US)
+		{
+			VirtualClock::advance(BENCH_POWER_LOOP_PERIOD_US);
+			if(composeAll == true)
+			{
+				display->setLayer(DisplayManager::DIGIT_LAYER, 255);
+			}
+			uint32_t shows = FastLED.getShowCount();
+			uint64_t start = Benchmark::hostNs();
+			display->handle();
+			uint64_t frameNs = Benchmark::hostNs() - start;
+			if(FastLED.getShowCount() == shows)
+			{
+				continue;
+			}
+			result.addFrame(frameNs);
+
+			start = Benchmark::hostNs();
+			scannedLoad = scanFrontBuffers();
+			scanNs += Benchmark::hostNs() - start;
+
+			uint32_t scannedMilliamps = BENCH_POWER_LEDS * LED_MILLIAMPS_IDLE + (uint64_t)scannedLoad * FastLED.getBrightness() / (255 * 255);
+			wrongFrames += display->getEstimatedMilliamps() != scannedMilliamps ? 1 : 0;
+			overBudget += scannedMilliamps > MAX_MILLIAMPS ? 1 : 0;
+		}
+	}
+	result.shows = FastLED.getShowCount() - showsBefore;
+	result.allocations = Benchmark::allocationCount - allocationsBefore;
+	return result;
+}
+
+void Benchmark::runPowerEstimatorBenchmark()
+{
+	firstController = FastLED.count();
+	DisplayManager* display = DisplayManager::getInstance();
+	display->InitSegments(0, NUM_LEDS_PER_SEGMENT, CRGB::White, 255);
+	display->setInternalLEDColor(CRGB::White, false);
+
+	uint64_t changedScanNs = 0;
+	uint64_t allScanNs = 0;
+	uint32_t wrongFrames = 0;
+	uint32_t overBudget = 0;
+	BenchmarkResult changed = runClock(display, false, changedScanNs, wrongFrames, overBudget);
+	BenchmarkResult all = runClock(display, true, allScanNs, wrongFrames, overBudget);
+
+	//all LEDs at full white draw far more than the budget, the limit has to kick in
+	display->setAllSegmentColors(CRGB::White, false);
+	display->displayRaw(88, 88);
+	for (uint32_t elapsed = 0; elapsed < BENCH_POWER_MINUTE_US; elapsed += BENCH_POWER_LOOP_PERIOD_US)
+	{
+		VirtualClock::advance(BENCH_POWER_LOOP_PERIOD_US);
+		display->handle();
+	}
+	uint32_t fullMilliamps = BENCH_POWER_LEDS * LED_MILLIAMPS_IDLE + (uint64_t)scanFrontBuffers() * 255 / (255 * 255);
+	uint32_t limitedMilliamps = display->getEstimatedMilliamps();
+
+	printf("\n== Power estimate of the composed output, %d LEDs ==\n", BENCH_POWER_LEDS);
+	printf("%-14s %8s %12s %12s %8s\n", "case", "shows", "ns/frame", "full scan ns", "allocs");
+	printf("%-14s %8u %12.1f %12.1f %8u\n", "changed only", changed.frames, changed.nsPerFrame(), (double)changedScanNs / changed.frames, changed.allocations);
+	printf("%-14s %8u %12.1f %12.1f %8u\n", "compose all", all.frames, all.nsPerFrame(), (double)allScanNs / all.frames, all.allocations);
+	printf("running estimate: %s (%u frames differ from a full scan)\n", wrongFrames == 0 ? "correct" : "WRONG", wrongFrames);
+	printf("power limit: %s (%u frames over %d mA, full white %u mA limited to %u mA)\n", overBudget == 0 && limitedMilliamps <= MAX_MILLIAMPS && fullMilliamps > MAX_MILLIAMPS ? "correct" : "WRONG",
+		overBudget, MAX_MILLIAMPS, fullMilliamps, limitedMilliamps);
+}
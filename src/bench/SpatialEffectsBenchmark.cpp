@@ -0,0 +1,212 @@
+/**
+ * \file SpatialEffectsBenchmark.cpp
+ * \brief Checks the compile time coordinate map of #SpatialEffects and compares rendering an effect with the effect
+ *        inlined into the render loop against calling it through a function pointer for every LED.
+ *        Afterwards a sweep is played with #DisplayManager::playSpatialEffect on top of a solid overlay on the digits and the downlights
+ *        and driven by #DisplayManager::handle. Checks that every shown frame holds the effect on the digits and the plain downlights
+ *        and that the overlay is gone once the effect finished. Uses the segments #Benchmark::runPowerEstimatorBenchmark initialized.
+ */
+
+#include "Benchmark.h"
+#include "SpatialEffects.h"
+#include "DisplayManager.h"
+
+/**
+ * \brief Number of frames rendered per effect and variant
+ */
+#define BENCH_SPATIAL_FRAMES		2000
+
+/**
+ * \brief Virtual time that passes between two calls of #DisplayManager::handle, emulating one iteration of loop()
+ */
+#define BENCH_SPATIAL_LOOP_PERIOD_US	1000
+
+/**
+ * \brief Duration of the sweep played through the #DisplayManager, in ms
+ */
+#define BENCH_SPATIAL_EFFECT_DURATION	1000
+
+#define BENCH_SPATIAL_DOWNLIGHTS		(APPEND_DOWN_LIGHTERS == true ? NUM_LEDS - ADDITIONAL_LEDS : 0)
+
+typedef CRGB (*PixelFunction)(const void* effect, uint8_t x, uint8_t y);
+
+template<typename Effect>
+static CRGB evaluate(const void* effect, uint8_t x, uint8_t y)
+{
+	return (*(const Effect*)effect)(x, y);
+}
+
+static CRGB spatialLeds[SPATIAL_NUM_LEDS];
+
+/**
+ * \brief The function pointer is volatile so that the compiler can't resolve it, like an effect selected at runtime
+ */
+static PixelFunction volatile pixelFunction;
+
+template<typename Effect>
+static void measure(const char* name, Effect effect)
+{
+	uint64_t start = Benchmark::hostNs();
+	for (uint32_t frame = 0; frame < BENCH_SPATIAL_FRAMES; frame++)
+	{
+		SpatialEffects::render(spatialLeds, effect, frame * ANIMATION_PROGRESS_ONE / BENCH_SPATIAL_FRAMES);
+	}
+	uint64_t inlinedNs = Benchmark::hostNs() - start;
+
+	pixelFunction = &evaluate<Effect>;
+	start = Benchmark::hostNs();
+	for (uint32_t frame = 0; frame < BENCH_SPATIAL_FRAMES; frame++)
+	{
+		effect.setTime(frame * 255 / BENCH_SPATIAL_FRAMES);
+		for (uint16_t i = 0; i < SPATIAL_NUM_LEDS; i++)
+		{
+			spatialLeds[i] = pixelFunction(&effect, SpatialEffects::coordinates[i].x, SpatialEffects::coordinates[i].y);
+		}
+	}
+	uint64_t indirectNs = Benchmark::hostNs() - start;
+
+	printf("%-14s %12.1f %12.1f\n", name, (double)inlinedNs / BENCH_SPATIAL_FRAMES, (double)indirectNs / BENCH_SPATIAL_FRAMES);
+}
+
+/**
+ * \brief Front buffers of the #DisplayManager, found by the size of their FastLED controllers
+ */
+static CLEDController* digitController;
+static CRGB* frontDigits;
+static CRGB* frontDownlights;
+
+static void findFrontBuffers()
+{
+	for (int i = 0; i < FastLED.count(); i++)
+	{
+		if(FastLED[i].size() == NUM_LEDS && digitController == nullptr)
+		{
+			digitController = &FastLED[i];
+			frontDigits = FastLED[i].leds;
+		}
+		#if APPEND_DOWN_LIGHTERS == false
+			if(FastLED[i].size() == ADDITIONAL_LEDS && frontDownlights == nullptr)
+			{
+				frontDownlights = FastLED[i].leds;
+			}
+		#endif
+	}
+	#if APPEND_DOWN_LIGHTERS == true
+		frontDownlights = frontDigits;
+	#endif
+}
+
+/**
+ * \brief Let the #DisplayManager run for the given virtual time
+ *
+ * \param everyFrame called after every frame the digits were shown in, nullptr to only run
+ */
+static void runDisplay(DisplayManager* display, uint32_t durationUs, void (*everyFrame)() = nullptr)
+{
+	for (uint32_t elapsed = 0; elapsed < durationUs; elapsed += BENCH_SPATIAL_LOOP_PERIOD_US)
+	{
+		VirtualClock::advance(BENCH_SPATIAL_LOOP_PERIOD_US);
+		//strips that are sent on their own don't go through FastLED.show(), so count the shows of the controller
+		uint32_t shows = digitController->showCount;
+		display->handle();
+		if(everyFrame != nullptr && digitController->showCount != shows)
+		{
+			everyFrame();
+		}
+	}
+}
+
+static CRGB baseDigits[SPATIAL_NUM_LEDS];
+static CRGB baseDownlights[ADDITIONAL_LEDS];
+static uint32_t effectFrames;
+static uint32_t wrongEffectFrames;
+static uint8_t lastEffectTime;
+
+/**
+ * \brief The digits have to show the sweep at some point of its time, which never goes backwards, and the downlights what is below the overlay
+ */
+static void checkEffectFrame()
+{
+	effectFrames++;
+	bool found = false;
+	for (uint16_t time = lastEffectTime; time <= 255 && found == false; time++)
+	{
+		SpatialEffects::render(spatialLeds, SpatialEffects::Sweep(CRGB::Blue), time << 8);
+		if(memcmp(spatialLeds, frontDigits, sizeof(spatialLeds)) == 0)
+		{
+			found = true;
+			lastEffectTime = time;
+		}
+	}
+	bool downlightsPlain = memcmp(baseDownlights, frontDownlights + BENCH_SPATIAL_DOWNLIGHTS, sizeof(baseDownlights)) == 0;
+	wrongEffectFrames += found == true && downlightsPlain == true ? 0 : 1;
+}
+
+/**
+ * \brief Play a sweep through the compositor of the #DisplayManager on top of a solid overlay
+ */
+static void checkSpatialEffectOverlay()
+{
+	DisplayManager* display = DisplayManager::getInstance();
+	findFrontBuffers();
+	runDisplay(display, BENCH_SPATIAL_EFFECT_DURATION * 1000);
+	memcpy(baseDigits, frontDigits, sizeof(baseDigits));
+	memcpy(baseDownlights, frontDownlights + BENCH_SPATIAL_DOWNLIGHTS, sizeof(baseDownlights));
+
+	//the solid overlay covers the downlights as well, the effect only the digits
+	display->setOverlay(DisplayManager::OVERLAY_LAYER, CRGB::Red, 255, DisplayManager::BLEND_NORMAL, DisplayManager::TARGET_DIGITS | DisplayManager::TARGET_DOWNLIGHTS);
+	runDisplay(display, 100 * BENCH_SPATIAL_LOOP_PERIOD_US);
+	bool overlayShown = frontDigits[0] == CRGB(CRGB::Red) && frontDownlights[BENCH_SPATIAL_DOWNLIGHTS] == CRGB(CRGB::Red);
+
+	//the sweep leaves the shelf a bit before its end, from then on all frames look like the last one. The frame that reaches the end
+	//already hides the layer again, so the last frame that shows the effect is up to one frame before it
+	CRGB lastFrame[SPATIAL_NUM_LEDS];
+	SpatialEffects::render(lastFrame, SpatialEffects::Sweep(CRGB::Blue), ANIMATION_PROGRESS_ONE);
+	uint8_t endTime = 255;
+	do
+	{
+		SpatialEffects::render(spatialLeds, SpatialEffects::Sweep(CRGB::Blue), (endTime - 1) << 8);
+	} while(memcmp(spatialLeds, lastFrame, sizeof(lastFrame)) == 0 && --endTime > 0);
+
+	uint16_t frameStep = 255UL * Animator::getInstance()->getFramePeriod() / (BENCH_SPATIAL_EFFECT_DURATION * 1000) + 1;
+
+	uint32_t allocationsBefore = Benchmark::allocationCount;
+	display->playSpatialEffect(SpatialEffects::Sweep(CRGB::Blue), BENCH_SPATIAL_EFFECT_DURATION);
+	runDisplay(display, BENCH_SPATIAL_EFFECT_DURATION * 1000, &checkEffectFrame);
+	runDisplay(display, 100 * BENCH_SPATIAL_LOOP_PERIOD_US);
+	uint32_t allocations = Benchmark::allocationCount - allocationsBefore;
+
+	//once the effect is done the layer is hidden and the digits show what is below it again
+	bool cleared = memcmp(baseDigits, frontDigits, sizeof(baseDigits)) == 0 && memcmp(baseDownlights, frontDownlights + BENCH_SPATIAL_DOWNLIGHTS, sizeof(baseDownlights)) == 0;
+	printf("effect overlay: %s (%u of %u frames wrong, sweep reached %d of %d, %s after the effect, %u allocs)\n",
+		overlayShown == true && effectFrames > 0 && wrongEffectFrames == 0 && lastEffectTime + frameStep >= endTime && cleared == true ? "correct" : "WRONG",
+		wrongEffectFrames, effectFrames, lastEffectTime, endTime, cleared == true ? "cleared" : "NOT cleared", allocations);
+}
+
+void Benchmark::runSpatialEffectsBenchmark()
+{
+	printf("\n== Spatial effects over %d LEDs ==\n", SPATIAL_NUM_LEDS);
+
+	//every LED has its own place on the shelf
+	uint16_t duplicates = 0;
+	uint8_t maxX = 0;
+	uint8_t maxY = 0;
+	for (uint16_t i = 0; i < SPATIAL_NUM_LEDS; i++)
+	{
+		const SpatialEffects::LEDCoordinate& coordinate = SpatialEffects::coordinates[i];
+		maxX = coordinate.x > maxX ? coordinate.x : maxX;
+		maxY = coordinate.y > maxY ? coordinate.y : maxY;
+		for (uint16_t j = 0; j < i; j++)
+		{
+			duplicates += coordinate.x == SpatialEffects::coordinates[j].x && coordinate.y == SpatialEffects::coordinates[j].y ? 1 : 0;
+		}
+	}
+	printf("coordinate map: max x %d, max y %d, %s (%d LEDs share a position)\n", maxX, maxY, duplicates == 0 ? "correct" : "WRONG", duplicates);
+
+	printf("%-14s %12s %12s\n", "case", "inlined ns", "indirect ns");
+	measure("sweep", SpatialEffects::Sweep(CRGB::White));
+	measure("wave", SpatialEffects::Wave(CRGB::Blue, 3, 2));
+	measure("gradient", SpatialEffects::Gradient(CRGB::Red, CRGB::Blue));
+
+	checkSpatialEffectOverlay();
+}
@@ -0,0 +1,123 @@
+/**
+ * \file StreamingFilterBenchmark.cpp
+ * \brief Feeds a noisy light sensor signal with spikes into #StreamingFilter and compares every result with copying and
+ *        sorting the window on every sample, like the light sensor did before. Reports the cost per sample of both.
+ */
+
+#include "Benchmark.h"
+#include "StreamingFilter.h"
+
+/**
+ * \brief Window of the filter, the same as the default of #LIGHT_SENSOR_AVERAGE
+ */
+#define BENCH_FILTER_WINDOW			15
+
+/**
+ * \brief Number of samples around the median that are averaged, the same as the default of #LIGHT_SENSOR_MEDIAN_WIDTH
+ */
+#define BENCH_FILTER_MEDIAN_WIDTH	5
+
+#define BENCH_FILTER_SAMPLES		100000
+
+static uint16_t signalSamples[BENCH_FILTER_SAMPLES];
+
+/**
+ * \brief Volatile so the compiler can't drop the filter runs whose result is not used otherwise
+ */
+static volatile uint16_t filteredValue;
+
+/**
+ * \brief Mean around the median by sorting a copy of the window
+ */
+static uint16_t sortedMedianMean(const uint16_t* window, uint16_t count)
+{
+	uint16_t sorted[BENCH_FILTER_WINDOW];
+	uint32_t sum = 0;
+	for (uint16_t i = 0; i < count; i++)
+	{
+		sorted[i] = window[i];
+		sum += window[i];
+	}
+	if(count < BENCH_FILTER_MEDIAN_WIDTH)
+	{
+		return sum / count;
+	}
+	for (uint16_t i = 1; i < count; i++)
+	{
+		uint16_t value = sorted[i];
+		uint16_t j = i;
+		for (; j > 0 && sorted[j - 1] > value; j--)
+		{
+			sorted[j] = sorted[j - 1];
+		}
+		sorted[j] = value;
+	}
+	uint16_t first = (count - BENCH_FILTER_MEDIAN_WIDTH) / 2;
+	sum = 0;
+	for (uint16_t i = first; i < first + BENCH_FILTER_MEDIAN_WIDTH; i++)
+	{
+		sum += sorted[i];
+	}
+	return sum / BENCH_FILTER_MEDIAN_WIDTH;
+}
+
+void Benchmark::runStreamingFilterBenchmark()
+{
+	//slow day and night cycle with sensor noise and a spike now and then
+	uint32_t random = 777;
+	for (uint32_t i = 0; i < BENCH_FILTER_SAMPLES; i++)
+	{
+		random = random * 1103515245u + 12345u;
+		int32_t value = 2048 + (int32_t)(i % 4000 < 2000 ? i % 2000 : 2000 - i % 2000) - 1000 + (int32_t)((random >> 16) % 64) - 32;
+		if((random >> 8) % 50 == 0)
+		{
+			value = (random >> 20) % 2 == 0 ? 0 : 4095;
+		}
+		signalSamples[i] = constrain(value, 0, 4095);
+	}
+
+	StreamingFilter<BENCH_FILTER_WINDOW> filter;
+	uint32_t allocationsBefore = Benchmark::allocationCount;
+	uint64_t start = Benchmark::hostNs();
+	for (uint32_t i = 0; i < BENCH_FILTER_SAMPLES; i++)
+	{
+		filter.add(signalSamples[i]);
+		filteredValue = filter.getMedianMean(BENCH_FILTER_MEDIAN_WIDTH);
+	}
+	uint64_t streamingNs = Benchmark::hostNs() - start;
+	uint32_t allocations = Benchmark::allocationCount - allocationsBefore;
+
+	uint16_t window[BENCH_FILTER_WINDOW];
+	uint16_t count = 0;
+	start = Benchmark::hostNs();
+	for (uint32_t i = 0; i < BENCH_FILTER_SAMPLES; i++)
+	{
+		window[i % BENCH_FILTER_WINDOW] = signalSamples[i];
+		count = count < BENCH_FILTER_WINDOW ? count + 1 : count;
+		filteredValue = sortedMedianMean(window, count);
+	}
+	uint64_t sortingNs = Benchmark::hostNs() - start;
+
+	//same input into both again, this time comparing every result
+	filter.reset();
+	count = 0;
+	uint32_t wrongSamples = 0;
+	uint32_t wrongMeans = 0;
+	uint32_t windowSum = 0;
+	for (uint32_t i = 0; i < BENCH_FILTER_SAMPLES; i++)
+	{
+		windowSum -= count == BENCH_FILTER_WINDOW ? window[i % BENCH_FILTER_WINDOW] : 0;
+		window[i % BENCH_FILTER_WINDOW] = signalSamples[i];
+		windowSum += signalSamples[i];
+		count = count < BENCH_FILTER_WINDOW ? count + 1 : count;
+		filter.add(signalSamples[i]);
+		wrongSamples += filter.getMedianMean(BENCH_FILTER_MEDIAN_WIDTH) != sortedMedianMean(window, count) ? 1 : 0;
+		wrongMeans += filter.getMean() != windowSum / count ? 1 : 0;
+	}
+
+	printf("\n== Light sensor filter, window %d, median width %d ==\n", BENCH_FILTER_WINDOW, BENCH_FILTER_MEDIAN_WIDTH);
+	printf("%-14s %12s %12s %8s\n", "case", "ns/sample", "sort ns", "allocs");
+	printf("%-14s %12.1f %12.1f %8u\n", "median mean", (double)streamingNs / BENCH_FILTER_SAMPLES, (double)sortingNs / BENCH_FILTER_SAMPLES, allocations);
+	printf("median mean: %s (%u of %u samples differ from sorting, %u means differ)\n", wrongSamples + wrongMeans == 0 ? "correct" : "WRONG",
+		wrongSamples, BENCH_FILTER_SAMPLES, wrongMeans);
+}
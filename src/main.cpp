@@ -50,7 +50,6 @@ void toggleDownlights(int, int);
 void toggleClocklights(int, int);
 void toggleSchlock(int, int);
 void runTestModeOnStartup();
-CRGB clamp_rgb(CRGB, int);
 void outputESPMemory();
 void initializeAndReadConfig();
 void outputConfigFile();
@@ -70,12 +69,15 @@ bool testMode = TEST_MODE;
 int defaultGlobalBrightnessLevel = DEFAULT_CLOCK_BRIGHTNESS;
 int currentClockBrightnessLevel = DEFAULT_CLOCK_BRIGHTNESS;
 int currentDLBrightnessLevel = DEFAULT_CLOCK_BRIGHTNESS;
+int animationSpeed = DEFAULT_ANIMATION_SPEED;
 CRGB defaultHourColor = HOUR_COLOR;
 int defaultHourColorIndex = 0;
 CRGB defaultMinColor = MINUTE_COLOR;
 int defaultMinColorIndex = 0;
 CRGB defaultDLColor = INTERNAL_COLOR;
 int defaultDLColorIndex = 0;
+// Colors test mode tints the displays with, so each display can be told apart
+const CRGB testModeColors[NUM_DISPLAYS] = {CRGB::Blue, CRGB::Red, CRGB::Green, CRGB::Purple};
 const char* ESPHostName = ESP_HOST_NAME;
 
 
@@ -326,6 +328,13 @@ function updateSliderDL(element) {
   xhr.open("GET", "/update?button=dlSlider&state="+sValue, true);
   xhr.send();
 }
+function updateSliderS(element) {
+  var sValue = document.getElementById("sSlider").value;
+  document.getElementById("sSliderText").innerHTML = sValue;
+  var xhr = new XMLHttpRequest();
+  xhr.open("GET", "/update?button=sSlider&state="+sValue, true);
+  xhr.send();
+}
 </script>
 </body>
 </html>
@@ -439,8 +448,7 @@ void setup()
 			if (inputMessage1 == "TestMode") {
 				if (inputMessage2 == "0") {
 					// Turn off test mode.
-					ShelfDisplays->setHourSegmentColors(defaultHourColor);
-					ShelfDisplays->setMinuteSegmentColors(defaultMinColor);
+					ShelfDisplays->setLayer(DisplayManager::OVERLAY_LAYER, 0);
 					ShelfDisplays->setGlobalBrightness(defaultGlobalBrightnessLevel);
 					testMode = false;
 					updateSetting("TestMode", "Off");
@@ -491,6 +499,12 @@ void setup()
 				else
 					toggleDownlights(1, inputMessage2.toInt());
 			}
+			if (inputMessage1 == "sSlider") {
+				// Update Animation Speed, out of range values are limited so the saved and shown speed is the one that is used
+				ShelfDisplays->setAnimationSpeed(constrain(inputMessage2.toInt(), ANIMATOR_MIN_SPEED, ANIMATOR_MAX_SPEED));
+				animationSpeed = ShelfDisplays->getAnimationSpeed();
+				updateSetting("AnimSpeed", String(animationSpeed));
+			}
 		} else {
 			inputMessage1 = "No message sent";
 			inputMessage2 = "No message sent"; 
@@ -536,13 +550,12 @@ void setup()
 		bool ranTestModeOnStartup = true;
 		runTestModeOnStartup();
 	} else {
-		if (clockOnOffState) {
-			ShelfDisplays->setHourSegmentColors(defaultHourColor);
-			ShelfDisplays->setMinuteSegmentColors(defaultMinColor);
-		}
-		if (downlightersOnOffState) {
-			ShelfDisplays->setInternalLEDColor(defaultDLColor);
-		}
+		ShelfDisplays->setHourSegmentColors(defaultHourColor);
+		ShelfDisplays->setMinuteSegmentColors(defaultMinColor);
+		ShelfDisplays->setInternalLEDColor(defaultDLColor);
+		ShelfDisplays->setChannelBrightness(DisplayManager::HOUR_BRIGHTNESS, clockOnOffState ? currentClockBrightnessLevel : 0, false);
+		ShelfDisplays->setChannelBrightness(DisplayManager::MINUTE_BRIGHTNESS, clockOnOffState ? currentClockBrightnessLevel : 0, false);
+		ShelfDisplays->setChannelBrightness(DisplayManager::DOWNLIGHT_BRIGHTNESS, downlightersOnOffState ? currentDLBrightnessLevel : 0, false);
 	}
 
 	if (!testMode) {
@@ -581,10 +594,7 @@ void loop()
 
 	if (testMode) {
 		// Test code:
-		ShelfDisplays->setSegmentColor(0, CRGB::Blue);
-		ShelfDisplays->setSegmentColor(1, CRGB::Red);
-		ShelfDisplays->setSegmentColor(2, CRGB::Green);
-		ShelfDisplays->setSegmentColor(3, CRGB::Purple);
+		ShelfDisplays->setDisplayOverlay(DisplayManager::OVERLAY_LAYER, testModeColors, 255);
 		ShelfDisplays->setGlobalBrightness(defaultGlobalBrightnessLevel);
 
 		if((millis()-lasttest)>= 1500)
@@ -595,6 +605,7 @@ void loop()
 	}
 
     ShelfDisplays->handle();
+    ShelfDisplays->waitForNextFrame();
 }
 
 // Initialize our settings file.
@@ -689,6 +700,7 @@ void wipeAndReinitialize() {
 	doc["GlobalBrightness"] = DEFAULT_CLOCK_BRIGHTNESS;
 	doc["ClockBrightness"] = DEFAULT_CLOCK_BRIGHTNESS;
 	doc["DLBrightness"] = DEFAULT_CLOCK_BRIGHTNESS;
+	doc["AnimSpeed"] = DEFAULT_ANIMATION_SPEED;
 	doc["TestMode"] = TEST_MODE;
 	doc["TestModeOnStartup"] = TEST_MODE_ON_STARTUP;
 	doc["MaxMilliAmps"] = MAX_MILLIAMPS;
@@ -782,6 +794,13 @@ void readConfigJson() {
 	currentDLBrightnessLevel = doc[settingName].as<int>();
 	s+="\nSetting: ";s+=settingName;s+=": ";s+=doc[settingName].as<int>();
 
+	// Setting files written by older versions don't have the animation speed yet
+	settingName = "AnimSpeed";
+	animationSpeed = doc[settingName] | DEFAULT_ANIMATION_SPEED;
+	ShelfDisplays->setAnimationSpeed(constrain(animationSpeed, ANIMATOR_MIN_SPEED, ANIMATOR_MAX_SPEED));
+	animationSpeed = ShelfDisplays->getAnimationSpeed();
+	s+="\nSetting: ";s+=settingName;s+=": ";s+=animationSpeed;
+
 	Serial.println(s);
 	WebSerial.println(s);
 
@@ -840,7 +859,7 @@ void updateSetting(String settingName, String settingValue) {
 		WebSerial.print("updateSetting:  updating: "); WebSerial.print(settingName); WebSerial.print(", value: "); WebSerial.println(settingValue);
 	}
 	// Brightness Sliders (int 0 to 255)
-	if (settingName == "GlobalBrightness" || settingName == "ClockBrightness" || settingName == "DLBrightness") {
+	if (settingName == "GlobalBrightness" || settingName == "ClockBrightness" || settingName == "DLBrightness" || settingName == "AnimSpeed") {
 		int iValue = settingValue.toInt();
 		doc[settingName] = iValue;
 		Serial.print("updateSetting:  updating: "); Serial.print(settingName); Serial.print(", value: "); Serial.println(settingValue);
@@ -886,54 +905,10 @@ void outputESPMemory(){
 	WebSerial.println("[DEBUG] Free Heap: " + String(ESP.getFreeHeap()));
 }
 
-// Clamp RGB to a percentage from 0 to 255.  This will be my attempt to dim/brighten colors.  
-// Basically, clamping down to say 5 and clamping up to 255 (but keeping other rgb the same)
-// When going down, after you get to the "bottom" darkest, then 0/0/0 (black/off) is what happens next.
-// So examples:
-// For brightening:
-// RGB = 255, 0, 0: because R is already clamped at 255, its as bright as it can go.
-// RGB = 200, 210, 30:  Set to 80% brightness.  We need to first scale rgb up to max brightness: 245, 255, 75.  
-// If we say to darken, then we do the same basic thing.  Go to brightest and multiply by 0-1.0.  
-CRGB clamp_rgb(CRGB color, int scale) {
-	int r = color.r, g = color.g, b = color.b;
-	int r1, g1, b1;
-	CRGB returncolor;
-
-	// get a number from 0.0 to 1.0 that is equivalent to the integer passed in of 0 to 255
-	// NOTE:  This is a scale down number.
-	double scaledownfactor = (double)scale / 255.0;
-	WebSerial.println("Scale Down Factor: " + String(scaledownfactor));
-
-	// Scale the existing color up to full brightness first.
-	double scaleupfactor = min(255.0/(double)r, min(255.0/(double)g, 255.0/(double)b));
-	WebSerial.println("Scale Up Factor (step 1): " + String(scaleupfactor));
-
-
-	// Now, to get final number, just multiply by scaleup and scaledown
-	r1 = r * scaleupfactor * scaledownfactor;
-	g1 = g * scaleupfactor * scaledownfactor;
-	b1 = b * scaleupfactor * scaledownfactor;
-
-	returncolor.r = r1;
-	returncolor.g = g1;
-	returncolor.b = b1;
-
-	WebSerial.println("r: " + String(r) + ", g: " + String(g) + ", b: " + String(b));
-	WebSerial.println("r1: " + String(r1) + ", g1: " + String(g1) + ", b1: " + String(b1));
-
-	return returncolor;
-}
-
 void runTestModeOnStartup() {
 	ShelfDisplays->turnAllLEDsOff();
 	delay(500);
-	ShelfDisplays->setSegmentColor(0, CRGB::Blue);
-	delay(500);
-	ShelfDisplays->setSegmentColor(1, CRGB::Red);
-	delay(500);
-	ShelfDisplays->setSegmentColor(2, CRGB::Green);
-	delay(500);
-	ShelfDisplays->setSegmentColor(3, CRGB::Purple);
+	ShelfDisplays->setDisplayOverlay(DisplayManager::OVERLAY_LAYER, testModeColors, 255);
 	delay(500);
 	ShelfDisplays->setInternalLEDColor(CRGB::DarkOrange);
 	delay(500);
@@ -944,6 +919,7 @@ void runTestModeOnStartup() {
 		ShelfDisplays->handle();
 		ShelfDisplays->delay(1000);
 	}
+	ShelfDisplays->setLayer(DisplayManager::OVERLAY_LAYER, 0);
 	if (clockOnOffState) {
 		ShelfDisplays->setHourSegmentColors(defaultHourColor);
 		ShelfDisplays->setMinuteSegmentColors(defaultMinColor);
@@ -1039,6 +1015,8 @@ String webProcessor(const String& var){
   		bsliders += "<p><input type=\"range\" onchange=\"updateSliderC(this)\" id=\"cSlider\" min=\"0\" max=\"254\" value=\"" + String(currentClockBrightnessLevel) + "\" step=\"1\" class=\"bslider\"></p>\n";
 		bsliders += "<h4>Down Lights Brightness Level</h4>\n<span id=\"dlSliderText\">" + String(currentDLBrightnessLevel) + "</span>\n";
   		bsliders += "<p><input type=\"range\" onchange=\"updateSliderDL(this)\" id=\"dlSlider\" min=\"0\" max=\"254\" value=\"" + String(currentDLBrightnessLevel) + "\" step=\"1\" class=\"bslider\"></p>\n";
+		bsliders += "<h4>Animation Speed (%)</h4>\n<span id=\"sSliderText\">" + String(animationSpeed) + "</span>\n";
+  		bsliders += "<p><input type=\"range\" onchange=\"updateSliderS(this)\" id=\"sSlider\" min=\"" + String(ANIMATOR_MIN_SPEED) + "\" max=\"" + String(ANIMATOR_MAX_SPEED) + "\" value=\"" + String(animationSpeed) + "\" step=\"10\" class=\"bslider\"></p>\n";
 
 		buttons += bsliders;
 
@@ -1053,20 +1031,21 @@ void toggleDownlights(int state, int brightness) {
 	// value is 0-255 for brightness
 	// NOTE:  if brightness is 255 that means someone used alexa to "turn on" without specifying the brightness level.
 	// in that case we want to not set the brightness but turn it on back to original brightness.
+	// The color itself is never changed, the level is applied by the brightness channel of the downlights.
 	switch(state) {
 		case 0:
-			ShelfDisplays->setInternalLEDColor(CRGB::Black);
+			ShelfDisplays->setChannelBrightness(DisplayManager::DOWNLIGHT_BRIGHTNESS, 0);
 			downlightersOnOffState = false;
 			break;
 		case 1:
 			if (brightness >= 1) {
 				downlightersOnOffState = true;
-				defaultDLColor = clamp_rgb(defaultDLColor, brightness);
-				ShelfDisplays->setInternalLEDColor(defaultDLColor);
 				if (brightness < 255) {
 					currentDLBrightnessLevel = brightness;
 					updateSetting("DLBrightness", String(currentDLBrightnessLevel));
 				}
+				ShelfDisplays->setInternalLEDColor(defaultDLColor);
+				ShelfDisplays->setChannelBrightness(DisplayManager::DOWNLIGHT_BRIGHTNESS, currentDLBrightnessLevel);
 			}
 			break;
 	}
@@ -1078,24 +1057,25 @@ void toggleClocklights(int state, int brightness) {
 	// value is 0-255 for brightness
 	// NOTE:  if brightness is 255 that means someone used alexa to "turn on" without specifying the brightness level.
 	// in that case we want to not set the brightness but turn it on back to original brightness.
+	// The colors themselves are never changed, the level is applied by the brightness channels of the hours and minutes.
 	switch(state) {
 		case 0:
-			ShelfDisplays->setHourSegmentColors(CRGB::Black);
-			ShelfDisplays->setMinuteSegmentColors(CRGB::Black);
+			ShelfDisplays->setChannelBrightness(DisplayManager::HOUR_BRIGHTNESS, 0);
+			ShelfDisplays->setChannelBrightness(DisplayManager::MINUTE_BRIGHTNESS, 0);
 			clockOnOffState = false;
 			break;
 		case 1:
 			// Set clock back to their color.
 			if (brightness >= 1) {
 				clockOnOffState = true;
-				defaultHourColor = clamp_rgb(defaultHourColor, brightness);
-				defaultMinColor = clamp_rgb(defaultMinColor, brightness);
-				ShelfDisplays->setHourSegmentColors(defaultHourColor);
-				ShelfDisplays->setMinuteSegmentColors(defaultMinColor);
 				if (brightness < 255) {
 					currentClockBrightnessLevel = brightness;
 					updateSetting("ClockBrightness", String(currentClockBrightnessLevel));
 				}
+				ShelfDisplays->setHourSegmentColors(defaultHourColor);
+				ShelfDisplays->setMinuteSegmentColors(defaultMinColor);
+				ShelfDisplays->setChannelBrightness(DisplayManager::HOUR_BRIGHTNESS, currentClockBrightnessLevel);
+				ShelfDisplays->setChannelBrightness(DisplayManager::MINUTE_BRIGHTNESS, currentClockBrightnessLevel);
 			}
 			break;
 	}
@@ -1110,9 +1090,9 @@ void toggleSchlock(int state, int brightness) {
 	// in that case we want to not set the brightness but turn it on back to original brightness.
 	switch(state) {
 		case 0:
-			ShelfDisplays->setHourSegmentColors(CRGB::Black);
-			ShelfDisplays->setMinuteSegmentColors(CRGB::Black);
-			ShelfDisplays->setInternalLEDColor(CRGB::Black);
+			ShelfDisplays->setChannelBrightness(DisplayManager::HOUR_BRIGHTNESS, 0);
+			ShelfDisplays->setChannelBrightness(DisplayManager::MINUTE_BRIGHTNESS, 0);
+			ShelfDisplays->setChannelBrightness(DisplayManager::DOWNLIGHT_BRIGHTNESS, 0);
 			clockOnOffState = false;
 			downlightersOnOffState = false;
 			break;
@@ -1120,20 +1100,19 @@ void toggleSchlock(int state, int brightness) {
 			// Set all back to their color.
 			clockOnOffState = true;
 			downlightersOnOffState = true;
-
-			defaultHourColor = clamp_rgb(defaultHourColor, brightness);
-			defaultMinColor = clamp_rgb(defaultMinColor, brightness);
-			ShelfDisplays->setHourSegmentColors(defaultHourColor);
-			ShelfDisplays->setMinuteSegmentColors(defaultMinColor);
-
-			defaultDLColor = clamp_rgb(defaultDLColor, brightness);
-			ShelfDisplays->setInternalLEDColor(defaultDLColor);
 			if (brightness < 255) {
 				currentDLBrightnessLevel = brightness;
 				updateSetting("DLBrightness", String(currentDLBrightnessLevel));
 				currentClockBrightnessLevel = brightness;
 				updateSetting("ClockBrightness", String(currentClockBrightnessLevel));
 			}
+
+			ShelfDisplays->setHourSegmentColors(defaultHourColor);
+			ShelfDisplays->setMinuteSegmentColors(defaultMinColor);
+			ShelfDisplays->setInternalLEDColor(defaultDLColor);
+			ShelfDisplays->setChannelBrightness(DisplayManager::HOUR_BRIGHTNESS, currentClockBrightnessLevel);
+			ShelfDisplays->setChannelBrightness(DisplayManager::MINUTE_BRIGHTNESS, currentClockBrightnessLevel);
+			ShelfDisplays->setChannelBrightness(DisplayManager::DOWNLIGHT_BRIGHTNESS, currentDLBrightnessLevel);
 			break;
 	}
 	(downlightersOnOffState) ? updateSetting("DLOn", "On") : updateSetting("DLOn", "Off");
@@ -1166,7 +1145,7 @@ void startupAnimation()
 	targetMinL = currentTime.minutes % 10;
 
 	ShelfDisplays->displayTime(0, 0);
-	ShelfDisplays->delay(DIGIT_ANIMATION_SPEED + 10);
+	ShelfDisplays->waitForAnimations();
 
 	while (currHourH != targetHourH || currHourL != targetHourL || currMinH != targetMinH || currMinL != targetMinL)
 	{
@@ -1187,7 +1166,8 @@ void startupAnimation()
 			currMinL++;
 		}
 		ShelfDisplays->displayTime(currHourH * 10 + currHourL, currMinH * 10 + currMinL);
-		ShelfDisplays->delay(DIGIT_ANIMATION_SPEED + 100);
+		ShelfDisplays->waitForAnimations();
+		ShelfDisplays->delay(100);
 	}
 }
 
@@ -1356,7 +1336,7 @@ void TimerDone()
 			// NOTE: if updating SPIFFS this would be the place to unmount SPIFFS using SPIFFS.end()
 			Serial.println("Start updating " + type);
 			timeM->disableTimer();
-			ShelfDisplays->setAllSegmentColors(OTA_UPDATE_COLOR);
+			ShelfDisplays->setAllSegmentColors(OTA_UPDATE_COLOR, false);
 			ShelfDisplays->turnAllLEDsOff(); //instead of the loading animation show a progress bar
 			ShelfDisplays->setGlobalBrightness(50);
 		})